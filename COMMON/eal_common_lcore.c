@@ -32,6 +32,8 @@
  */
 
 #include <unistd.h>
+#include <fcntl.h>
+#include <stdio.h>
 #include <limits.h>
 #include <string.h>
 #include <dirent.h>
@@ -41,6 +43,9 @@
 #include <rte_lcore.h>
 #include <rte_common.h>
 #include <rte_debug.h>
+#include <rte_atomic.h>
+#include <rte_eal_memconfig.h>
+#include <rte_mempool.h>
 
 #include "eal_private.h"
 #include "eal_thread.h"
@@ -105,3 +110,128 @@ rte_eal_cpu_init(void)
 
 	return 0;
 }
+
+/* nesting count of rte_lcore_slot_attach() in this thread */
+static RTE_DEFINE_PER_LCORE(unsigned, _lcore_slot_ref);
+
+/*
+ * start time of a thread (clock ticks since boot, field 22 of
+ * /proc/<tid>/stat), 0 if the thread does not exist
+ */
+static uint32_t
+lcore_thread_start_time(uint32_t tid)
+{
+	char path[64];
+	char buf[1024];
+	char *p;
+	unsigned long long start = 0;
+	ssize_t len;
+	int fd;
+	int field;
+
+	snprintf(path, sizeof(path), "/proc/%u/stat", tid);
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return 0;
+
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return 0;
+	buf[len] = '\0';
+
+	/* the command name may hold spaces, fields start after the last ')' */
+	p = strrchr(buf, ')');
+	if (p == NULL)
+		return 0;
+
+	/* state is field 3, starttime is field 22 */
+	for (field = 2; field < 22 && p != NULL; field++)
+		p = strchr(p + 1, ' ');
+
+	if (p == NULL || sscanf(p + 1, "%llu", &start) != 1)
+		return 0;
+
+	/* 0 means "no thread", keep a started thread non-zero */
+	return ((uint32_t)start == 0) ? 1 : (uint32_t)start;
+}
+
+/* owner word of a thread (thread id and start time) */
+static uint64_t
+lcore_slot_owner_of(uint32_t tid)
+{
+	return ((uint64_t)lcore_thread_start_time(tid) << 32) | tid;
+}
+
+/* true if the thread owning an lcore slot has exited (or crashed) */
+static int
+lcore_slot_owner_dead(uint64_t owner)
+{
+	uint32_t tid = (uint32_t)owner;
+
+	if (owner == 0)
+		return 1;
+
+	/* the thread id was reused by another thread if the start time differs */
+	return lcore_thread_start_time(tid) != (uint32_t)(owner >> 32);
+}
+
+int
+rte_lcore_slot_attach(void)
+{
+	struct rte_mem_config *mcfg;
+	uint64_t self;
+	uint64_t owner;
+	unsigned lcore_id;
+
+	if (RTE_PER_LCORE(_lcore_slot_ref) > 0) {
+		RTE_PER_LCORE(_lcore_slot_ref)++;
+		return (int)rte_lcore_id();
+	}
+
+	mcfg = rte_eal_get_configuration()->mem_config;
+	self = lcore_slot_owner_of((uint32_t)rte_gettid());
+
+	for (lcore_id = 0; lcore_id < RTE_MAX_LCORE; lcore_id++) {
+		owner = mcfg->lcore_owner[lcore_id];
+		if (!lcore_slot_owner_dead(owner))
+			continue;
+
+		/* objects left in the cache of a dead owner are still free
+		 * objects of the pool, so the new owner simply inherits them */
+		if (rte_atomic64_cmpset(&mcfg->lcore_owner[lcore_id],
+				owner, self) == 0)
+			continue;
+
+		RTE_PER_LCORE(_lcore_id) = lcore_id;
+		RTE_PER_LCORE(_lcore_slot_ref) = 1;
+		return (int)lcore_id;
+	}
+
+	RTE_LOG(WARNING, EAL, "No free lcore slot for thread %u, "
+		"mempool cache disabled\n", (uint32_t)self);
+	return -1;
+}
+
+void
+rte_lcore_slot_detach(void)
+{
+	struct rte_mem_config *mcfg;
+	unsigned lcore_id;
+
+	if (RTE_PER_LCORE(_lcore_slot_ref) == 0)
+		return;
+
+	if (--RTE_PER_LCORE(_lcore_slot_ref) > 0)
+		return;
+
+	mcfg = rte_eal_get_configuration()->mem_config;
+	lcore_id = rte_lcore_id();
+
+	rte_mempool_cache_flush_lcore(lcore_id);
+	RTE_PER_LCORE(_lcore_id) = LCORE_ID_ANY;
+
+	/* cache must be empty before another thread can claim the slot */
+	rte_wmb();
+	mcfg->lcore_owner[lcore_id] = 0;
+}
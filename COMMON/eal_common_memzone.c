@@ -49,34 +49,108 @@
 #include <rte_errno.h>
 #include <rte_string_fns.h>
 #include <rte_common.h>
+#include <rte_atomic.h>
 
 #include "malloc_heap.h"
 #include "malloc_elem.h"
 #include "eal_private.h"
 
+/* FNV-1a hash of a memzone name */
+static inline uint32_t
+memzone_name_hash(const char *name)
+{
+	uint32_t hash = 2166136261U;
+	unsigned i;
+
+	for (i = 0; i < RTE_MEMZONE_NAMESIZE && name[i] != '\0'; i++) {
+		hash ^= (uint8_t)name[i];
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+/*
+ * Probe the name hash index. Readers take no lock: a slot is published by
+ * the writer only after the descriptor is filled, and the name is checked
+ * again against the descriptor, so a stale slot is simply skipped.
+ */
 static inline const struct rte_memzone *
 memzone_lookup_thread_unsafe(const char *name)
 {
 	const struct rte_mem_config *mcfg;
 	const struct rte_memzone *mz;
-	unsigned i = 0;
+	uint32_t pos;
+	uint16_t slot;
+	unsigned i;
 
 	/* get pointer to global configuration */
 	mcfg = rte_eal_get_configuration()->mem_config;
 
-	/*
-	 * the algorithm is not optimal (linear), but there are few
-	 * zones and this function should be called at init only
-	 */
-	for (i = 0; i < RTE_MAX_MEMZONE; i++) {
-		mz = &mcfg->memzone[i];
-		if (mz->addr != NULL && !strncmp(name, mz->name, RTE_MEMZONE_NAMESIZE))
-			return &mcfg->memzone[i];
+	pos = memzone_name_hash(name) & RTE_MEMZONE_HASH_MASK;
+
+	for (i = 0; i < RTE_MEMZONE_HASH_SIZE; i++) {
+		slot = mcfg->memzone_hash[pos];
+		if (slot == RTE_MEMZONE_HASH_EMPTY)
+			break;
+
+		if (slot != RTE_MEMZONE_HASH_DELETED && slot <= RTE_MAX_MEMZONE) {
+			rte_rmb();
+			mz = &mcfg->memzone[slot - 1];
+			if (mz->addr != NULL &&
+					!strncmp(name, mz->name, RTE_MEMZONE_NAMESIZE))
+				return mz;
+		}
+
+		pos = (pos + 1) & RTE_MEMZONE_HASH_MASK;
 	}
 
 	return NULL;
 }
 
+/* add a filled memzone to the name hash index, must hold mlock */
+static inline void
+memzone_hash_insert(struct rte_mem_config *mcfg, const struct rte_memzone *mz)
+{
+	uint32_t pos;
+	unsigned i;
+
+	pos = memzone_name_hash(mz->name) & RTE_MEMZONE_HASH_MASK;
+
+	for (i = 0; i < RTE_MEMZONE_HASH_SIZE; i++) {
+		if (mcfg->memzone_hash[pos] == RTE_MEMZONE_HASH_EMPTY ||
+				mcfg->memzone_hash[pos] == RTE_MEMZONE_HASH_DELETED)
+			break;
+		pos = (pos + 1) & RTE_MEMZONE_HASH_MASK;
+	}
+
+	/* descriptor must be visible before the slot is published */
+	rte_wmb();
+	mcfg->memzone_hash[pos] = (uint16_t)(mz - mcfg->memzone + 1);
+}
+
+/* remove a memzone from the name hash index, must hold mlock */
+static inline void
+memzone_hash_delete(struct rte_mem_config *mcfg, unsigned idx)
+{
+	uint32_t pos;
+	unsigned i;
+
+	pos = memzone_name_hash(mcfg->memzone[idx].name) & RTE_MEMZONE_HASH_MASK;
+
+	for (i = 0; i < RTE_MEMZONE_HASH_SIZE; i++) {
+		if (mcfg->memzone_hash[pos] == RTE_MEMZONE_HASH_EMPTY)
+			return;
+		if (mcfg->memzone_hash[pos] == idx + 1) {
+			/* keep the probe chain, readers skip DELETED slots */
+			mcfg->memzone_hash[pos] = RTE_MEMZONE_HASH_DELETED;
+			rte_wmb();
+			return;
+		}
+		pos = (pos + 1) & RTE_MEMZONE_HASH_MASK;
+	}
+}
+
 static inline struct rte_memzone *
 get_next_free_memzone(void)
 {
@@ -242,6 +316,8 @@ memzone_reserve_aligned_thread_unsafe(const char *name, size_t len,
 	mz->flags = 0;
 	mz->memseg_id = elem->ms - rte_eal_get_configuration()->mem_config->memseg;
 
+	memzone_hash_insert(mcfg, mz);
+
 	return mz;
 }
 
@@ -336,6 +412,7 @@ rte_memzone_free(const struct rte_memzone *mz)
 		rte_panic("%s(): memzone address not NULL but memzone_cnt is 0!\n",
 				__func__);
 	} else {
+		memzone_hash_delete(mcfg, idx);
 		memset(&mcfg->memzone[idx], 0, sizeof(mcfg->memzone[idx]));
 		mcfg->memzone_cnt--;
 	}
@@ -353,17 +430,16 @@ rte_memzone_free(const struct rte_memzone *mz)
 const struct rte_memzone *
 rte_memzone_lookup(const char *name)
 {
-	struct rte_mem_config *mcfg;
 	const struct rte_memzone *memzone = NULL;
 
-	mcfg = rte_eal_get_configuration()->mem_config;
-
-	rte_rwlock_read_lock(&mcfg->mlock);
-
+	/*
+	 * lock-free, the hash index is safe for concurrent readers. The zone
+	 * is indexed when it is reserved, before its creator fills it, so a
+	 * caller which reads the contents must serialize with the creator
+	 * (rte_ring_lookup takes the tailq lock).
+	 */
 	memzone = memzone_lookup_thread_unsafe(name);
 
-	rte_rwlock_read_unlock(&mcfg->mlock);
-
 	return memzone;
 }
 
@@ -406,6 +482,10 @@ rte_eal_memzone_init(void)
 	/* get pointer to global configuration */
 	mcfg = rte_eal_get_configuration()->mem_config;
 
+	/* slot value (index + 1) must not collide with DELETED */
+	RTE_BUILD_BUG_ON(RTE_MAX_MEMZONE >= RTE_MEMZONE_HASH_DELETED);
+	RTE_BUILD_BUG_ON(RTE_MAX_MEMZONE >= RTE_MEMZONE_HASH_SIZE);
+
 	/* secondary processes don't need to initialise anything */
 	if (rte_eal_process_type() == RTE_PROC_SECONDARY)
 		return 0;
@@ -421,6 +501,7 @@ rte_eal_memzone_init(void)
 	/* delete all zones */
 	mcfg->memzone_cnt = 0;
 	memset(mcfg->memzone, 0, sizeof(mcfg->memzone));
+	memset((void *)mcfg->memzone_hash, 0, sizeof(mcfg->memzone_hash));
 
 	rte_rwlock_write_unlock(&mcfg->mlock);
 
@@ -275,7 +275,7 @@
 #undef RTE_TOOLCHAIN_GCC
 #define RTE_TOOLCHAIN_GCC 1
 #undef RTE_RING_MAX_CONS_COUNT 
-#define RTE_RING_MAX_CONS_COUNT 50 /**< Ring 의 Consumer 의 최대 숫자  */
+#define RTE_RING_MAX_CONS_COUNT 50 /**< Ring 의 Consumer 의 최대 숫자 (cons.sleep_mask 로 인해 64 이하) */
 #undef RTE_RING_MAX_PROD_COUNT 
 #define RTE_RING_MAX_PROD_COUNT 50 /**< Ring 의Producer 의 최대 숫자  */
 #undef RTE_MAX_IPC	
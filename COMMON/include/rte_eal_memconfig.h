@@ -44,6 +44,15 @@
 extern "C" {
 #endif
 
+/**
+ * Number of slots of the memzone name hash index (must be a power of 2 and
+ * larger than RTE_MAX_MEMZONE so that a probe always meets an empty slot).
+ */
+#define RTE_MEMZONE_HASH_SIZE    4096
+#define RTE_MEMZONE_HASH_MASK    (RTE_MEMZONE_HASH_SIZE - 1)
+#define RTE_MEMZONE_HASH_EMPTY   0      /**< Slot never used. */
+#define RTE_MEMZONE_HASH_DELETED 0xFFFF /**< Slot of a freed memzone. */
+
 /**
  * the structure for the memory configuration for the RTE.
  * Used by the rte_config structure. It is separated out, as for multi-process
@@ -82,6 +91,20 @@ struct rte_mem_config {
 	 * exact same address the primary process maps it.
 	 */
 	uint64_t mem_cfg_addr;
+
+	/* open-addressing hash index of memzone names. Each slot holds the
+	 * memzone descriptor index + 1 (or EMPTY / DELETED). Updated under
+	 * mlock, read without any lock by rte_memzone_lookup().
+	 */
+	volatile uint16_t memzone_hash[RTE_MEMZONE_HASH_SIZE];
+
+	/* owner of each lcore id handed out by rte_lcore_slot_attach(), 0 if
+	 * free. Gives every attached thread of every process its own mempool
+	 * cache slot. The low 32 bits hold the system thread id and the high
+	 * 32 bits the start time of the thread, so a reused thread id is not
+	 * taken for the exited owner.
+	 */
+	volatile uint64_t lcore_owner[RTE_MAX_LCORE] __rte_cache_aligned;
 } __attribute__((__packed__));
 
 
@@ -248,6 +248,30 @@ int rte_thread_set_affinity(rte_cpuset_t *cpusetp);
  */
 void rte_thread_get_affinity(rte_cpuset_t *cpusetp);
 
+/**
+ * Claim an lcore id for the calling thread.
+ *
+ * Secondary processes never launch EAL threads, so their threads run with
+ * LCORE_ID_ANY and bypass every per-lcore mempool cache. This hands out a
+ * free lcore id from the table shared by all processes (taking over the
+ * slot of a thread that no longer exists) and stores it in the per-thread
+ * lcore id, so rte_mempool_get()/put() hit a private cache.
+ * Nested calls from the same thread return the same lcore id.
+ *
+ * @return
+ *   The claimed lcore id, or -1 if every slot is owned by a live thread.
+ */
+int rte_lcore_slot_attach(void);
+
+/**
+ * Release the lcore id claimed by rte_lcore_slot_attach().
+ *
+ * The last nested call flushes the mempool caches of the lcore id back to
+ * their rings and resets the per-thread lcore id to LCORE_ID_ANY.
+ * It must be called from the thread that claimed the lcore id.
+ */
+void rte_lcore_slot_detach(void);
+
 
 #ifdef __cplusplus
 }
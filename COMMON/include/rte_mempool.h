@@ -1305,6 +1305,18 @@ static inline void *rte_mempool_get_priv(struct rte_mempool *mp)
  */
 void rte_mempool_list_dump(FILE *f);
 
+/**
+ * Flush the local cache of one lcore in all mempools
+ *
+ * Objects left in the cache are put back in the mempool ring, so they can
+ * be used by other lcores once the lcore id is released. If the ring has no
+ * room, the objects stay in the cache and an error is logged.
+ *
+ * @param lcore_id
+ *   The lcore id whose cache is flushed.
+ */
+void rte_mempool_cache_flush_lcore(unsigned lcore_id);
+
 /**
  * Search a mempool from its name
  *
@@ -150,6 +150,9 @@ struct rte_ring_backup_info
 	uint32_t	size;		/**< MMap size of Backup File */
 	int			fd;			/**< File descriptor of Backup File */
 	void		*backup;		/**< virtual address of Backup File */
+	uint32_t	dirty_head;	/**< Start Position of unsynced Backup Data (Group Commit) */
+	uint32_t	dirty_tail;	/**< End Position of unsynced Backup Data (Group Commit) */
+	uint32_t	dirty_cnt;	/**< Count of unsynced Backup Updates (Group Commit) */
 };
 
 //added by lhj 20160122
@@ -163,11 +166,16 @@ struct rte_ring_cons_info
 {
 	char name[RTE_RING_NAMESIZE];	/**< Name of the Consumer */
 	pid_t	pid;					/**< PID of the Consumer */
-	uint8_t	sleep;					/**< Sleep Status of the Consumer */
+	volatile uint32_t sleep;		/**< Sleep Status of the Consumer */
+	uint8_t	wait_mode;				/**< Wakeup Mode of the Consumer (Signal/Futex) */
+	rte_atomic32_t futex;			/**< Futex word, Consumer parks on it (Futex Mode) */
+	rte_atomic32_t *futex_ptr;		/**< Futex word to wake for this Consumer (Futex Mode) */
 	volatile uint32_t head;  /**< Consumer head. */
 	volatile uint32_t tail;  /**< Consumer tail. */
 	uint32_t start_idx;  /**< Consumer Start Position. */
 	uint8_t	restore;  /**< Consumer Restore Mode Flag. */
+	volatile uint8_t subscribed;  /**< Broadcast Ring: subscription state (RTE_RING_SUBS_*). */
+	volatile uint32_t leave_end;  /**< Broadcast Ring: producer head when the subscriber started to leave (RTE_RING_SUBS_DRAINING). */
 	struct rte_ring_backup_info backup_info;  /**< Backup file info */
 };
 
@@ -182,6 +190,11 @@ struct rte_ring_prod_info
 	char name[RTE_RING_NAMESIZE];	/**< Name of the Producer*/
 	pid_t	pid;					/**< PID of the Producer(not use) */
 	uint8_t	sleep;					/**< Sleep Status of the Producer(not use) */
+	volatile uint64_t rts_sent;			/**< Count of RTS sent to Sleeping Consumers (atomic add) */
+	volatile uint64_t rts_suppressed;	/**< Count of RTS suppressed, All Consumers Awake (atomic add) */
+	volatile uint64_t bk_staged;	/**< Count of Data handed to Backup */
+	volatile uint64_t bk_written;	/**< Count of Data written to Backup File */
+	volatile uint64_t bk_failed;	/**< Count of Data failed to write to Backup File (Log Full) */
 	volatile uint32_t head;  /**< Producer head. */
 	volatile uint32_t tail;  /**< Producer tail. */
 	uint32_t start_idx;  /**< Producer Start Position. */
@@ -205,6 +218,7 @@ struct rte_ring {
 	int flags;                       /**< Flags supplied at creation. */
 	const struct rte_memzone *memzone;
 			/**< Memzone, if any, containing the rte_ring */
+	rte_atomic32_t reg_lock; /**< Lock for prod_info / cons_info registration */
 
 	/** Ring producer status. */
 	struct prod {
@@ -212,6 +226,10 @@ struct rte_ring {
 		struct rte_ring_prod_info prod_info[RTE_RING_MAX_PROD_COUNT]; /**< producer info */
 		uint32_t prod_count;
 		uint32_t watermark;      /**< Maximum items before EDQUOT. */
+		uint32_t low_watermark;  /**< Items to leave the over-watermark state. */
+		volatile uint32_t wm_over; /**< 1 from crossing watermark until drained to low_watermark. */
+		rte_atomic32_t wm_high_cnt; /**< Count of crossings over watermark. */
+		rte_atomic32_t wm_low_cnt;  /**< Count of drains to low_watermark. */
 		uint32_t sp_enqueue;     /**< True, if single producer. */
 		uint32_t size;           /**< Size of ring. */
 		uint32_t mask;           /**< Mask (size-1) of ring. */
@@ -224,6 +242,11 @@ struct rte_ring {
 		//added by lhj 20160122
 		struct rte_ring_cons_info cons_info[RTE_RING_MAX_CONS_COUNT];    /**< consumer info */
 		uint32_t cons_count;     /**< Count of Consumer */
+		volatile uint64_t sleep_mask; /**< Bit Mask of Sleeping Consumers (bit = cons_info index) */
+		rte_atomic32_t retire_lock; /**< Lock for moving tail over completed slots */
+		rte_atomic32_t prod_futex;   /**< Futex word of producers waiting for free entries */
+		rte_atomic32_t prod_waiters; /**< Count of producers parked on prod_futex */
+		uint32_t prod_wake_free; /**< Free entries needed before parked producers are woken (low watermark). */
 		uint32_t sc_dequeue;     /**< True, if single consumer. */
 		uint32_t size;           /**< Size of the ring. */
 		uint32_t mask;           /**< Mask (size-1) of ring. */
@@ -244,8 +267,27 @@ struct rte_ring {
 	                                     * about compiler re-ordering */
 };
 
+/**
+ * Completion bit map of the ring slots (1 bit per slot), placed after ring[].
+ * Used by rte_ring_read_complete() to retire the slots out of order.
+ */
+#define RTE_RING_DONE_MAP(r) ((volatile uint64_t *)&((r)->ring[(r)->prod.size]))
+
+/** Size of the completion bit map for a ring of count slots */
+#define RTE_RING_DONE_MAP_SIZE(count) ((((count) + 63) / 64) * sizeof(uint64_t))
+
 #define RING_F_SP_ENQ 0x0001 /**< The default enqueue is "single-producer". */
 #define RING_F_SC_DEQ 0x0002 /**< The default dequeue is "single-consumer". */
+#define RING_F_BCAST  0x0004 /**< Every consumer reads all objects with its own cursor (cons_info head/tail). */
+
+/* subscription state of a consumer of a broadcast ring (cons_info subscribed) */
+#define RTE_RING_SUBS_JOINING 0 /**< Cursor is not set yet, producers wait. */
+#define RTE_RING_SUBS_ACTIVE  1 /**< Counted by producers and by the tail. */
+#define RTE_RING_SUBS_LEAVING 2 /**< Setting leave_end, producers wait. Still holds the tail. */
+#define RTE_RING_SUBS_LEFT    3 /**< Ignored by producers and by the tail. */
+#define RTE_RING_SUBS_DRAINING 4 /**< Counted by producers only for the slots before leave_end. Still holds the tail. */
+#define RTE_RING_SUBS_JOIN_SPIN 1000000 /**< Max pause count of a producer waiting for a joining subscriber. */
+#define RTE_RING_PROD_WAKE_DIV 4 /**< Default low watermark: wake parked producers when size/4 entries are free. */
 #define RTE_RING_QUOT_EXCEED (1 << 31)  /**< Quota exceed for burst ops */
 #define RTE_RING_SZ_MASK  (unsigned)(0x0fffffff) /**< Ring size mask */
 
@@ -393,6 +435,23 @@ void rte_ring_free(struct rte_ring *r);
  */
 int rte_ring_set_water_mark(struct rte_ring *r, unsigned count);
 
+/**
+ * Change the low water mark.
+ *
+ * Once the ring went over the high water mark, it stays in the
+ * over-watermark state (wm_over) until consumers drain it to *count*
+ * entries. The *count* value must be less than the high water mark.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param count
+ *   The new low water mark value.
+ * @return
+ *   - 0: Success; low water mark changed.
+ *   - -EINVAL: Invalid low water mark value.
+ */
+int rte_ring_set_low_water_mark(struct rte_ring *r, unsigned count);
+
 /**
  * Dump the status of the ring to the console.
  *
@@ -1162,6 +1221,83 @@ rte_ring_free_count(const struct rte_ring *r)
 	return ((cons_tail - prod_tail - 1) & r->prod.mask);
 }
 
+/**
+ * Leave the over-watermark state.
+ *
+ * Consumers call this after freeing entries. It costs a single load
+ * unless the ring is over the watermark.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   - 1: The caller drained the ring to the low water mark.
+ *   - 0: Nothing to do.
+ */
+static inline int
+rte_ring_wm_leave(struct rte_ring *r)
+{
+	if (likely(r->prod.wm_over == 0))
+		return 0;
+	if (rte_ring_count(r) > r->prod.low_watermark)
+		return 0;
+	if (rte_atomic32_cmpset(&r->prod.wm_over, 1, 0) == 0)
+		return 0;
+	rte_atomic32_inc(&r->prod.wm_low_cnt);
+	return 1;
+}
+
+/**
+ * Enter the over-watermark state.
+ *
+ * Producers call this when an enqueue returned -EDQUOT. Only the caller
+ * which changed the state counts the crossing in wm_high_cnt. If the ring
+ * was drained to the low watermark meanwhile, the state is left at once.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   - 1: The caller crossed the watermark.
+ *   - 0: The ring was already over the watermark.
+ */
+static inline int
+rte_ring_wm_enter(struct rte_ring *r)
+{
+	if (r->prod.wm_over)
+		return 0;
+	if (rte_atomic32_cmpset(&r->prod.wm_over, 0, 1) == 0)
+		return 0;
+	rte_atomic32_inc(&r->prod.wm_high_cnt);
+
+	/*
+	 * consumers which drained the ring before the state was set saw
+	 * wm_over == 0 and did not leave, so check the count again
+	 */
+	rte_mb();
+	rte_ring_wm_leave(r);
+	return 1;
+}
+
+/**
+ * Test if producers parked on the ring must be woken.
+ *
+ * Consumers call this after freeing entries. It is true only when some
+ * producer is parked and the free entries reached the low watermark, so
+ * the common path costs a single load of the waiter count.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @return
+ *   - 1: Parked producers must be woken.
+ *   - 0: Nothing to do.
+ */
+static inline int
+rte_ring_prod_wake_needed(const struct rte_ring *r)
+{
+	if (likely(rte_atomic32_read((rte_atomic32_t *)(uintptr_t)&r->cons.prod_waiters) == 0))
+		return 0;
+	return rte_ring_free_count(r) >= r->cons.prod_wake_free;
+}
+
 /**
  * Dump the status of all rings on the console
  *
@@ -1329,6 +1465,34 @@ void rte_ring_rw_lock();
  */
 void rte_ring_rw_unlock();
 
+/**
+ * Lock the producer / consumer registration of one ring.
+ *
+ * Unlike rte_ring_rw_lock(), attaching to unrelated rings does not
+ * serialize and ring lookups are not blocked.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ */
+static inline void
+rte_ring_reg_lock(struct rte_ring *r)
+{
+	while (rte_atomic32_cmpset((volatile uint32_t *)&r->reg_lock.cnt, 0, 1) == 0)
+		rte_pause();
+}
+
+/**
+ * Unlock the producer / consumer registration of one ring.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ */
+static inline void
+rte_ring_reg_unlock(struct rte_ring *r)
+{
+	rte_atomic32_clear(&r->reg_lock);
+}
+
 /**
  * @internal 비정상 종료시 Ring 의 복구를 위해서 사용하는 함수 
  * 인덱스를 지정하여서 지정된 인덱스 부터 n 개의 데이터를 Write
@@ -1397,6 +1561,8 @@ rte_ring_mp_enqueue_bulk_start_from(struct rte_ring *r, void * const *obj_table,
  *   RTE_RING_QUEUE_VARIABLE: Enqueue as many items a possible from ring
  * @param idx
  *   The index number of caller of this function in ring->prod.prod_info structure (added by lhj 2016.03.16)
+ * @param prod_pos
+ *   A pointer to store the ring position of the first enqueued object
  * @return
  *   Depend on the behavior value
  *   if behavior = RTE_RING_QUEUE_FIXED
@@ -1408,8 +1574,9 @@ rte_ring_mp_enqueue_bulk_start_from(struct rte_ring *r, void * const *obj_table,
  *   - n: Actual number of objects enqueued.
  */
 static inline int __attribute__((always_inline))
-rte_ring_mp_enqueue_bulk_idx(struct rte_ring *r, void * const *obj_table,
-			 unsigned n, enum rte_ring_queue_behavior behavior, unsigned idx)
+rte_ring_mp_enqueue_bulk_pos(struct rte_ring *r, void * const *obj_table,
+			 unsigned n, enum rte_ring_queue_behavior behavior, unsigned idx,
+			 uint32_t *prod_pos)
 {
 	uint32_t prod_head, prod_next;
 	uint32_t cons_tail, free_entries;
@@ -1422,6 +1589,7 @@ rte_ring_mp_enqueue_bulk_idx(struct rte_ring *r, void * const *obj_table,
 	if(unlikely(r->prod.prod_info[idx].restore))
 	{
 		r->prod.prod_info[idx].restore = 0;
+		*prod_pos = r->cons.cons_info[idx].start_idx;
 		return rte_ring_mp_enqueue_bulk_start_from(r, obj_table, n, r->cons.cons_info[idx].start_idx);
 	}
 
@@ -1464,6 +1632,7 @@ rte_ring_mp_enqueue_bulk_idx(struct rte_ring *r, void * const *obj_table,
 
 	//added by lhj 2016.03.16 (For Write Complete)
 	r->prod.prod_info[idx].head = prod_next;
+	*prod_pos = prod_head;
 
 	/* write entries in ring */
 	ENQUEUE_PTRS();
@@ -1506,6 +1675,34 @@ rte_ring_mp_enqueue_bulk_idx(struct rte_ring *r, void * const *obj_table,
 	return ret;
 }
 
+/**
+ * @internal Enqueue several objects on the ring (multi-producers safe).
+ *
+ * Same as rte_ring_mp_enqueue_bulk_pos() without the ring position.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to add in the ring from the obj_table.
+ * @param behavior
+ *   RTE_RING_QUEUE_FIXED:    Enqueue a fixed number of items from a ring
+ *   RTE_RING_QUEUE_VARIABLE: Enqueue as many items a possible from ring
+ * @param idx
+ *   The index number of caller of this function in ring->prod.prod_info structure
+ * @return
+ *   See rte_ring_mp_enqueue_bulk_pos()
+ */
+static inline int __attribute__((always_inline))
+rte_ring_mp_enqueue_bulk_idx(struct rte_ring *r, void * const *obj_table,
+			 unsigned n, enum rte_ring_queue_behavior behavior, unsigned idx)
+{
+	uint32_t prod_pos;
+
+	return rte_ring_mp_enqueue_bulk_pos(r, obj_table, n, behavior, idx, &prod_pos);
+}
+
 /**
  * @internal 비정상 종료시 Ring 의 복구를 위해서 사용하는 함수 
  * 인덱스를 지정하여서 지정된 인덱스 부터 n 개의 데이터를 읽어들임
@@ -1543,6 +1740,70 @@ rte_ring_mc_dequeue_bulk_start_from(struct rte_ring *r, void **obj_table,
 	return 0;
 }
 
+/**
+ * @internal Dequeue several objects from a broadcast ring.
+ *
+ * Every subscriber of a broadcast ring reads all objects with its own cursor
+ * (cons_info[idx].head), so no "compare and set" is needed. The subscriber's
+ * tail is moved by rte_ring_bcast_read_complete().
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects) that will be filled.
+ * @param n
+ *   The number of objects to dequeue from the ring to the obj_table.
+ * @param behavior
+ *   RTE_RING_QUEUE_FIXED:    Dequeue a fixed number of items from a ring
+ *   RTE_RING_QUEUE_VARIABLE: Dequeue as many items a possible from ring
+ * @param idx
+ *   The index number of the subscriber in ring->cons.cons_info structure
+ * @return
+ *   Depend on the behavior value
+ *   if behavior = RTE_RING_QUEUE_FIXED
+ *   - 0: Success; objects dequeued.
+ *   - -ENOENT: Not enough entries in the ring to dequeue; no object is
+ *     dequeued.
+ *   if behavior = RTE_RING_QUEUE_VARIABLE
+ *   - n: Actual number of objects dequeued.
+ */
+static inline int __attribute__((always_inline))
+rte_ring_bcast_dequeue_bulk_idx(struct rte_ring *r, void **obj_table,
+		 unsigned n, enum rte_ring_queue_behavior behavior, unsigned idx)
+{
+	uint32_t cons_head, prod_tail, entries;
+	unsigned i = 0;
+	uint32_t mask = r->prod.mask;
+
+	cons_head = r->cons.cons_info[idx].head;
+	prod_tail = r->prod.tail;
+	entries = (prod_tail - cons_head);
+
+	if (n > entries) {
+		if (behavior == RTE_RING_QUEUE_FIXED) {
+			__RING_STAT_ADD(r, deq_fail, n);
+			return -ENOENT;
+		}
+		else {
+			if (unlikely(entries == 0)) {
+				__RING_STAT_ADD(r, deq_fail, n);
+				return 0;
+			}
+
+			n = entries;
+		}
+	}
+
+	/* copy in table */
+	DEQUEUE_PTRS();
+
+	rte_compiler_barrier();
+
+	r->cons.cons_info[idx].head = cons_head + n;
+
+	return behavior == RTE_RING_QUEUE_FIXED ? 0 : n;
+}
+
 /**
  * @internal Dequeue several objects from a ring (multi-consumers safe). When
  * the request objects are more than the available objects, only dequeue the
@@ -1583,10 +1844,25 @@ rte_ring_mc_dequeue_bulk_idx(struct rte_ring *r, void **obj_table,
 	unsigned i = 0;
 	uint32_t mask = r->prod.mask;
 
+	if (r->flags & RING_F_BCAST)
+		return rte_ring_bcast_dequeue_bulk_idx(r, obj_table, n, behavior, idx);
+
 	if(unlikely(r->cons.cons_info[idx].restore))
 	{
+		/* Only slots published before prod.tail can be read again;
+		 * the restore flag stays set until they are handed out. */
+		entries = r->prod.tail - r->cons.cons_info[idx].start_idx;
+		if (n > entries) {
+			if (behavior == RTE_RING_QUEUE_FIXED)
+				return -ENOENT;
+			n = entries;
+		}
+		if (unlikely(n == 0))
+			return 0;
+
 		r->cons.cons_info[idx].restore = 0;
-		return rte_ring_mc_dequeue_bulk_start_from(r, obj_table, n, r->cons.cons_info[idx].start_idx);
+		rte_ring_mc_dequeue_bulk_start_from(r, obj_table, n, r->cons.cons_info[idx].start_idx);
+		return behavior == RTE_RING_QUEUE_FIXED ? 0 : n;
 	}
 
 	/* move cons.head atomically */
@@ -1641,7 +1917,92 @@ rte_ring_mc_dequeue_bulk_idx(struct rte_ring *r, void **obj_table,
 
 
 /**
- * @internal Move to Tail Position (multi_consumers safe)
+ * @internal Dequeue several objects from a ring (multi-consumers safe) and
+ * return the dequeued position to the caller instead of the consumer info.
+ * Several threads of one consumer process can dequeue at the same time;
+ * each of them must call rte_ring_read_complete() with its own position.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects) that will be filled.
+ * @param n
+ *   The number of objects to dequeue from the ring to the obj_table.
+ * @param behavior
+ *   RTE_RING_QUEUE_FIXED:    Dequeue a fixed number of items from a ring
+ *   RTE_RING_QUEUE_VARIABLE: Dequeue as many items a possible from ring
+ * @param cons_pos
+ *   A pointer to store the ring's head position of the dequeued objects
+ * @return
+ *   Depend on the behavior value
+ *   if behavior = RTE_RING_QUEUE_FIXED
+ *   - 0: Success; objects dequeued.
+ *   - -ENOENT: Not enough entries in the ring to dequeue; no object is
+ *     dequeued.
+ *   if behavior = RTE_RING_QUEUE_VARIABLE
+ *   - n: Actual number of objects dequeued.
+ */
+static inline int __attribute__((always_inline))
+rte_ring_mc_dequeue_bulk_pos(struct rte_ring *r, void **obj_table,
+		 unsigned n, enum rte_ring_queue_behavior behavior, uint32_t *cons_pos)
+{
+	uint32_t cons_head, prod_tail;
+	uint32_t cons_next, entries;
+	const unsigned max = n;
+	int success;
+	unsigned i = 0;
+	uint32_t mask = r->prod.mask;
+
+	/* move cons.head atomically */
+	do {
+		/* Restore n as it may change every loop */
+		n = max;
+
+		cons_head = r->cons.head;
+		prod_tail = r->prod.tail;
+		entries = (prod_tail - cons_head);
+
+		/* Set the actual entries for dequeue */
+		if (n > entries) {
+			if (behavior == RTE_RING_QUEUE_FIXED) {
+				__RING_STAT_ADD(r, deq_fail, n);
+				return -ENOENT;
+			}
+			else {
+				if (unlikely(entries == 0)){
+					__RING_STAT_ADD(r, deq_fail, n);
+					return 0;
+				}
+
+				n = entries;
+			}
+		}
+
+		cons_next = cons_head + n;
+		success = rte_atomic32_cmpset(&r->cons.head, cons_head,
+					      cons_next);
+	} while (unlikely(success == 0));
+
+	*cons_pos = cons_head;
+
+	/* copy in table */
+	DEQUEUE_PTRS();
+
+	rte_compiler_barrier();
+
+	return behavior == RTE_RING_QUEUE_FIXED ? 0 : n;
+}
+
+
+/**
+ * @internal Mark dequeued slots as completed and move the tail position
+ * over the contiguous completed slots (multi_consumers safe)
+ *
+ * Consumers may complete in any order. Each consumer marks its slots in the
+ * completion bit map placed after the ring slots, and the consumer which
+ * takes the retire lock moves cons.tail over the completed slots. If the
+ * retire lock is taken, the holder will see our bits, so this function
+ * never waits for the other consumers.
  *
  * @param r
  *   A pointer to the ring structure.
@@ -1653,29 +2014,415 @@ rte_ring_mc_dequeue_bulk_idx(struct rte_ring *r, void **obj_table,
 static inline int __attribute__((always_inline))
 rte_ring_read_complete(struct rte_ring *r, unsigned cons_head, unsigned cons_next)
 {
+	volatile uint64_t *done = RTE_RING_DONE_MAP(r);
+	const uint32_t size = r->cons.size;
+	const uint32_t mask = r->cons.mask;
+	uint32_t idx, slot, cnt, tail, next, word;
+	uint64_t bits;
+
+	/* mark the completed slots, one bit map word at a time */
+	for (idx = cons_head; idx != cons_next; idx += cnt) {
+		slot = idx & mask;
+		cnt = 64 - (slot & 63);
+		if (cnt > size - slot)
+			cnt = size - slot;
+		if (cnt > cons_next - idx)
+			cnt = cons_next - idx;
+
+		bits = (cnt == 64) ? ~0ULL : (((1ULL << cnt) - 1) << (slot & 63));
+		__sync_fetch_and_or(&done[slot >> 6], bits);
+	}
+
+	__RING_STAT_ADD(r, deq_success, cons_next - cons_head);
+
+	for (;;) {
+		/* another consumer is moving the tail */
+		if (rte_atomic32_cmpset((volatile uint32_t *)&r->cons.retire_lock.cnt, 0, 1) == 0)
+			return 0;
+
+		tail = next = r->cons.tail;
+		bits = 0;
+		word = (next & mask) >> 6;
+
+		while (next != r->cons.head) {
+			slot = next & mask;
+
+			if ((slot >> 6) != word) {
+				__sync_fetch_and_and(&done[word], ~bits);
+				bits = 0;
+				word = slot >> 6;
+			}
+
+			if ((done[word] & (1ULL << (slot & 63))) == 0)
+				break;
+
+			bits |= (1ULL << (slot & 63));
+			next++;
+		}
+
+		/* clear the bits before the slots are reused by producers */
+		if (bits)
+			__sync_fetch_and_and(&done[word], ~bits);
+
+		if (next != tail)
+			r->cons.tail = next;
+
+		rte_atomic32_clear(&r->cons.retire_lock);
+		rte_mb();
+
+		/* a consumer may have completed the next slot while we held the lock */
+		next = r->cons.tail;
+		slot = next & mask;
+		if (next == r->cons.head || (done[slot >> 6] & (1ULL << (slot & 63))) == 0)
+			return 0;
+	}
+}
+
+/**
+ * @internal Set the cursor of a subscriber of a broadcast ring and make it
+ * visible to the producers.
+ *
+ * The subscriber starts at the producer head. A producer counts the
+ * subscriber (rte_ring_bcast_count) only if the reserved slots are at or
+ * after the cursor. If a producer gave up waiting and marked the subscriber
+ * as left, the cursor is set again after the slots of that producer.
+ * Must be called with the registration lock held.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param idx
+ *   The index number of the subscriber in ring->cons.cons_info structure
+ */
+static inline void
+rte_ring_bcast_join(struct rte_ring *r, unsigned idx)
+{
+	do {
+		r->cons.cons_info[idx].subscribed = RTE_RING_SUBS_JOINING;
+		rte_mb();
+
+		r->cons.cons_info[idx].head = r->prod.head;
+		r->cons.cons_info[idx].tail = r->cons.cons_info[idx].head;
+		rte_wmb();
+	} while (__sync_bool_compare_and_swap(&r->cons.cons_info[idx].subscribed,
+				RTE_RING_SUBS_JOINING, RTE_RING_SUBS_ACTIVE) == 0);
+}
+
+/**
+ * @internal Move the tail of a broadcast ring to the slowest subscriber.
+ *
+ * The tail is moved to the smallest tail of the subscribers, or to the
+ * producer tail if there is no subscriber. If a subscriber is joining
+ * (its cursor is not set yet), the tail is not moved until the joiner
+ * finishes or is dropped (rte_ring_bcast_reap). A subscriber which has left
+ * is ignored.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ */
+static inline void __attribute__((always_inline))
+rte_ring_bcast_retire(struct rte_ring *r)
+{
+	uint32_t prod_tail, cons_tail, next;
+	uint32_t i, count;
+	int32_t lag, max_lag = 0;
+
+	prod_tail = r->prod.tail;
+	count = r->cons.cons_count;
+	rte_rmb();
+
+	for (i = 0; i < count; i++) {
+		if (r->cons.cons_info[i].subscribed == RTE_RING_SUBS_JOINING)
+			return;
+
+		if (r->cons.cons_info[i].subscribed == RTE_RING_SUBS_LEFT)
+			continue;
+
+		/* a new subscriber may start after prod_tail */
+		lag = (int32_t)(prod_tail - r->cons.cons_info[i].tail);
+		if (lag > max_lag)
+			max_lag = lag;
+	}
+
+	next = prod_tail - max_lag;
+
+	do {
+		cons_tail = r->cons.tail;
+		if ((int32_t)(next - cons_tail) <= 0)
+			return;
+	} while (rte_atomic32_cmpset(&r->cons.tail, cons_tail, next) == 0);
+}
+
+/**
+ * @internal Wait for a joining subscriber of a broadcast ring to set its
+ * cursor.
+ *
+ * If the subscriber does not finish joining within RTE_RING_SUBS_JOIN_SPIN
+ * pauses, it is marked as left. A live joiner sees it and joins again after
+ * the current producer head (rte_ring_bcast_join).
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param idx
+ *   The index number of the subscriber in ring->cons.cons_info structure
+ */
+static inline void
+__rte_ring_bcast_wait_join(struct rte_ring *r, unsigned idx)
+{
+	uint32_t spin = 0;
+
+	while (r->cons.cons_info[idx].subscribed == RTE_RING_SUBS_JOINING) {
+		if (++spin < RTE_RING_SUBS_JOIN_SPIN) {
+			rte_pause();
+			continue;
+		}
+
+		__sync_bool_compare_and_swap(&r->cons.cons_info[idx].subscribed,
+				RTE_RING_SUBS_JOINING, RTE_RING_SUBS_LEFT);
+	}
+}
+
+/**
+ * @internal Drop the stalled joiners of a broadcast ring.
+ *
+ * rte_ring_bcast_retire() does not move the tail while a subscriber is
+ * joining. Called by a producer when the ring is full, so a joiner which
+ * died before setting its cursor does not hold the tail forever.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ */
+static inline void
+rte_ring_bcast_reap(struct rte_ring *r)
+{
+	uint32_t i, count;
+
+	count = r->cons.cons_count;
+	rte_rmb();
+
+	for (i = 0; i < count; i++) {
+		if (unlikely(r->cons.cons_info[i].subscribed == RTE_RING_SUBS_JOINING))
+			__rte_ring_bcast_wait_join(r, i);
+	}
+
+	rte_ring_bcast_retire(r);
+}
+
+/**
+ * @internal Complete the objects read by a subscriber of a broadcast ring
+ * and move the tail of the ring to the slowest subscriber.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param idx
+ *   The index number of the subscriber in ring->cons.cons_info structure
+ */
+static inline void __attribute__((always_inline))
+rte_ring_bcast_read_complete(struct rte_ring *r, unsigned idx)
+{
+	__RING_STAT_ADD(r, deq_success,
+			r->cons.cons_info[idx].head - r->cons.cons_info[idx].tail);
+
+	r->cons.cons_info[idx].tail = r->cons.cons_info[idx].head;
+	rte_mb();
+
+	rte_ring_bcast_retire(r);
+}
+
+/**
+ * @internal Stop counting a subscriber of a broadcast ring for new slots.
+ *
+ * The subscriber takes the producer head as leave_end. The producers which
+ * reserve the slots before leave_end count the subscriber, the others do not
+ * (rte_ring_bcast_count). Waits until the slots before leave_end are
+ * published, so the caller can free the slots from its head to leave_end,
+ * then set its cursor to leave_end and mark itself as left.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param idx
+ *   The index number of the subscriber in ring->cons.cons_info structure
+ * @return
+ *   The position of leave_end
+ */
+static inline uint32_t
+rte_ring_bcast_leave(struct rte_ring *r, unsigned idx)
+{
+	uint32_t end;
+
+	r->cons.cons_info[idx].subscribed = RTE_RING_SUBS_LEAVING;
+	rte_mb();
+
+	/* a producer which saw ACTIVE has reserved before this load */
+	end = r->prod.head;
+	r->cons.cons_info[idx].leave_end = end;
+	rte_wmb();
+	r->cons.cons_info[idx].subscribed = RTE_RING_SUBS_DRAINING;
+
+	while ((int32_t)(r->prod.tail - end) < 0)
+		rte_pause();
+	rte_rmb();
+
+	return end;
+}
+
+/**
+ * @internal Count the subscribers of a broadcast ring which will read the
+ * slots from the given producer position.
+ *
+ * Must be called after the slots are reserved by rte_ring_mp_enqueue_reserve()
+ * and before they are published. A subscriber which joins after the
+ * reservation starts behind the reserved slots and is not counted. A
+ * subscriber which does not finish joining within RTE_RING_SUBS_JOIN_SPIN
+ * pauses is marked as left, so a dead joiner can not stall the producers
+ * and the tail (rte_ring_bcast_retire). A leaving subscriber is counted
+ * only if the slots are before its leave_end (rte_ring_bcast_leave).
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param prod_head
+ *   The position of the reserved slots
+ * @return
+ *   The number of the subscribers
+ */
+static inline unsigned __attribute__((always_inline))
+rte_ring_bcast_count(struct rte_ring *r, uint32_t prod_head)
+{
+	uint32_t i, count;
+	uint8_t state;
+	unsigned subs = 0;
+
+	count = r->cons.cons_count;
+	rte_rmb();
+
+	for (i = 0; i < count; i++) {
+		/* wait for the joining subscriber to set its cursor */
+		if (unlikely(r->cons.cons_info[i].subscribed == RTE_RING_SUBS_JOINING))
+			__rte_ring_bcast_wait_join(r, i);
+
+		/*
+		 * wait for the leaving subscriber to set leave_end, the leaver
+		 * stores it right after the state without waiting for anything
+		 */
+		while (unlikely(r->cons.cons_info[i].subscribed == RTE_RING_SUBS_LEAVING))
+			rte_pause();
+
+		state = r->cons.cons_info[i].subscribed;
+		rte_rmb();
+
+		/*
+		 * a draining subscriber frees the slots before leave_end by itself,
+		 * so the slots reserved before it started to leave are counted
+		 */
+		if (unlikely(state == RTE_RING_SUBS_DRAINING)) {
+			if ((int32_t)(prod_head - r->cons.cons_info[i].leave_end) >= 0)
+				continue;
+		}
+		else if (unlikely(state != RTE_RING_SUBS_ACTIVE))
+			continue;
+
+		if ((int32_t)(prod_head - r->cons.cons_info[i].tail) >= 0)
+			subs++;
+	}
+
+	return subs;
+}
+
+/**
+ * @internal Reserve n slots of a ring (multi-producers safe).
+ *
+ * The reserved slots must be filled and published by
+ * rte_ring_mp_enqueue_publish(). Used by the broadcast ring to set the
+ * reference count of objects between the reservation and the publication.
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param n
+ *   The number of slots to reserve.
+ * @param idx
+ *   The index number of caller of this function in ring->prod.prod_info structure
+ * @param prod_pos
+ *   A pointer to store the position of the reserved slots
+ * @return
+ *   - 0: Success; slots reserved.
+ *   - -ENOBUFS: Not enough room in the ring; no slot is reserved.
+ */
+static inline int __attribute__((always_inline))
+rte_ring_mp_enqueue_reserve(struct rte_ring *r, unsigned n, unsigned idx,
+		 uint32_t *prod_pos)
+{
+	uint32_t prod_head, prod_next;
+	uint32_t cons_tail, free_entries;
+	uint32_t mask = r->prod.mask;
+	int success;
+
+	do {
+		prod_head = r->prod.head;
+		r->prod.prod_info[idx].tail = prod_head;
+
+		cons_tail = r->cons.tail;
+		free_entries = (mask + cons_tail - prod_head);
+
+		if (unlikely(n > free_entries)) {
+			__RING_STAT_ADD(r, enq_fail, n);
+			return -ENOBUFS;
+		}
+
+		prod_next = prod_head + n;
+		success = rte_atomic32_cmpset(&r->prod.head, prod_head,
+					      prod_next);
+	} while (unlikely(success == 0));
+
+	r->prod.prod_info[idx].head = prod_next;
+	*prod_pos = prod_head;
+
+	return 0;
+}
+
+/**
+ * @internal Fill the slots reserved by rte_ring_mp_enqueue_reserve() and
+ * move the producer tail (multi-producers safe).
+ *
+ * @param r
+ *   A pointer to the ring structure.
+ * @param obj_table
+ *   A pointer to a table of void * pointers (objects).
+ * @param n
+ *   The number of objects to add in the ring from the obj_table.
+ * @param prod_head
+ *   The position of the reserved slots
+ * @param idx
+ *   The index number of caller of this function in ring->prod.prod_info structure
+ */
+static inline void __attribute__((always_inline))
+rte_ring_mp_enqueue_publish(struct rte_ring *r, void * const *obj_table,
+		 unsigned n, uint32_t prod_head, unsigned idx)
+{
+	uint32_t prod_next = prod_head + n;
+	uint32_t mask = r->prod.mask;
+	unsigned i, rep = 0;
+
+	/* write entries in ring */
+	ENQUEUE_PTRS();
+	rte_compiler_barrier();
+
+	__RING_STAT_ADD(r, enq_success, n);
+
 	/*
-	 * If there are other dequeues in progress that preceded us,
+	 * If there are other enqueues in progress that preceded us,
 	 * we need to wait for them to complete
 	 */
-	while (unlikely(r->cons.tail != cons_head)) {
+	while (unlikely(r->prod.tail != prod_head)) {
 		rte_pause();
 
-#if 0
-		/* Set RTE_RING_PAUSE_REP_COUNT to avoid spin too long waiting
-		 * for other thread finish. It gives pre-empted thread a chance
-		 * to proceed and finish with ring dequeue operation. */
 		if (RTE_RING_PAUSE_REP_COUNT &&
 		    ++rep == RTE_RING_PAUSE_REP_COUNT) {
 			rep = 0;
 			sched_yield();
 		}
-#endif
 	}
 
-	__RING_STAT_ADD(r, deq_success, n);
-	r->cons.tail = cons_next;
-
-	return 0;
+	r->prod.tail = prod_next;
+	r->prod.prod_info[idx].tail = prod_next;
 }
 
 #ifdef __cplusplus
@@ -883,6 +883,48 @@ rte_mempool_lookup(const char *name)
 	return mp;
 }
 
+/* flush the local cache of one lcore in all mempools */
+void
+rte_mempool_cache_flush_lcore(unsigned lcore_id)
+{
+#if RTE_MEMPOOL_CACHE_MAX_SIZE > 0
+	struct rte_tailq_entry *te = NULL;
+	struct rte_mempool_list *mempool_list;
+	struct rte_mempool *mp;
+	struct rte_mempool_cache *cache;
+
+	if (lcore_id >= RTE_MAX_LCORE)
+		return;
+
+	mempool_list = RTE_TAILQ_CAST(rte_mempool_tailq.head, rte_mempool_list);
+
+	rte_rwlock_read_lock(RTE_EAL_MEMPOOL_RWLOCK);
+
+	TAILQ_FOREACH(te, mempool_list, next) {
+		mp = (struct rte_mempool *) te->data;
+		if (mp->cache_size == 0)
+			continue;
+
+		cache = &mp->local_cache[lcore_id];
+		if (cache->len == 0)
+			continue;
+
+		/* on failure the objects stay in the cache, the next owner of
+		 * the lcore id inherits them */
+		if (rte_ring_mp_enqueue_bulk(mp->ring, cache->objs, cache->len) == -ENOBUFS) {
+			RTE_LOG(ERR, MEMPOOL, "Cannot flush %u objects of lcore %u "
+				"cache to mempool %s\n", cache->len, lcore_id, mp->name);
+			continue;
+		}
+		cache->len = 0;
+	}
+
+	rte_rwlock_read_unlock(RTE_EAL_MEMPOOL_RWLOCK);
+#else
+	RTE_SET_USED(lcore_id);
+#endif
+}
+
 void rte_mempool_walk(void (*func)(const struct rte_mempool *, void *),
 		      void *arg)
 {
@@ -113,7 +113,7 @@ rte_ring_get_memsize(unsigned count)
 		return -EINVAL;
 	}
 
-	sz = sizeof(struct rte_ring) + count * sizeof(void *);
+	sz = sizeof(struct rte_ring) + count * sizeof(void *) + RTE_RING_DONE_MAP_SIZE(count);
 	sz = RTE_ALIGN(sz, RTE_CACHE_LINE_SIZE);
 	return sz;
 }
@@ -131,6 +131,8 @@ rte_ring_init(struct rte_ring *r, const char *name, unsigned count,
 #endif
 	RTE_BUILD_BUG_ON((offsetof(struct rte_ring, prod) &
 			  RTE_CACHE_LINE_MASK) != 0);
+	/* cons.sleep_mask has one bit per consumer info */
+	RTE_BUILD_BUG_ON(RTE_RING_MAX_CONS_COUNT > 64);
 #ifdef RTE_LIBRTE_RING_DEBUG
 	RTE_BUILD_BUG_ON((sizeof(struct rte_ring_debug_stats) &
 			  RTE_CACHE_LINE_MASK) != 0);
@@ -147,9 +149,13 @@ rte_ring_init(struct rte_ring *r, const char *name, unsigned count,
 	r->cons.sc_dequeue = !!(flags & RING_F_SC_DEQ);
 	r->prod.size = r->cons.size = count;
 	r->prod.mask = r->cons.mask = count-1;
+	r->cons.prod_wake_free = RTE_MAX(count / RTE_RING_PROD_WAKE_DIV, 1U);
 	r->prod.head = r->cons.head = 0;
 	r->prod.tail = r->cons.tail = 0;
 
+	/* init the completion bit map */
+	memset((void *)RTE_RING_DONE_MAP(r), 0, RTE_RING_DONE_MAP_SIZE(count));
+
 	return 0;
 }
 
@@ -228,14 +234,16 @@ rte_ring_free(struct rte_ring *r)
 		return;
 	}
 
+	ring_list = RTE_TAILQ_CAST(rte_ring_tailq.head, rte_ring_list);
+	rte_rwlock_write_lock(RTE_EAL_TAILQ_RWLOCK);
+
+	/* rte_ring_lookup() reads the memzone under the read lock */
 	if (rte_memzone_free(r->memzone) != 0) {
+		rte_rwlock_write_unlock(RTE_EAL_TAILQ_RWLOCK);
 		RTE_LOG(ERR, RING, "Cannot free memory\n");
 		return;
 	}
 
-	ring_list = RTE_TAILQ_CAST(rte_ring_tailq.head, rte_ring_list);
-	rte_rwlock_write_lock(RTE_EAL_TAILQ_RWLOCK);
-
 	/* find out tailq entry */
 	TAILQ_FOREACH(te, ring_list, next) {
 		if (te->data == (void *) r)
@@ -272,6 +280,20 @@ rte_ring_set_water_mark(struct rte_ring *r, unsigned count)
 	return 0;
 }
 
+/*
+ * change the low water mark. It is checked against the current high
+ * water mark, so set the high water mark first.
+ */
+int
+rte_ring_set_low_water_mark(struct rte_ring *r, unsigned count)
+{
+	if (count >= r->prod.watermark)
+		return -EINVAL;
+
+	r->prod.low_watermark = count;
+	return 0;
+}
+
 /* dump the status of the ring on the console */
 void
 rte_ring_dump(FILE *f, const struct rte_ring *r)
@@ -294,6 +316,10 @@ rte_ring_dump(FILE *f, const struct rte_ring *r)
 		fprintf(f, "  watermark=0\n");
 	else
 		fprintf(f, "  watermark=%"PRIu32"\n", r->prod.watermark);
+	fprintf(f, "  low_watermark=%"PRIu32"\n", r->prod.low_watermark);
+	fprintf(f, "  wm_over=%"PRIu32"\n", r->prod.wm_over);
+	fprintf(f, "  wm_high_cnt=%d\n", rte_atomic32_read(&r->prod.wm_high_cnt));
+	fprintf(f, "  wm_low_cnt=%d\n", rte_atomic32_read(&r->prod.wm_low_cnt));
 
 	/* sum and dump statistics */
 #ifdef RTE_LIBRTE_RING_DEBUG
@@ -348,23 +374,29 @@ rte_ring_list_dump(FILE *f)
 struct rte_ring *
 rte_ring_lookup(const char *name)
 {
-	struct rte_tailq_entry *te;
-	struct rte_ring *r = NULL;
-	struct rte_ring_list *ring_list;
+	char mz_name[RTE_MEMZONE_NAMESIZE];
+	const struct rte_memzone *mz;
+	struct rte_ring *r;
 
-	ring_list = RTE_TAILQ_CAST(rte_ring_tailq.head, rte_ring_list);
+	/*
+	 * rings made by rte_ring_create() live in a memzone named after the
+	 * ring, so the memzone name index replaces the tailq walk. The memzone
+	 * is indexed before rte_ring_init() runs, so the tailq read lock is
+	 * still taken: rte_ring_create() and rte_ring_free() hold the write
+	 * lock while the ring is initialised or its memzone is freed.
+	 */
+	snprintf(mz_name, sizeof(mz_name), "%s%s", RTE_RING_MZ_PREFIX, name);
 
 	rte_rwlock_read_lock(RTE_EAL_TAILQ_RWLOCK);
 
-	TAILQ_FOREACH(te, ring_list, next) {
-		r = (struct rte_ring *) te->data;
-		if (strncmp(name, r->name, RTE_RING_NAMESIZE) == 0)
-			break;
-	}
+	mz = rte_memzone_lookup(mz_name);
+	r = (mz == NULL) ? NULL : (struct rte_ring *) mz->addr;
+	if (r != NULL && strncmp(name, r->name, RTE_RING_NAMESIZE) != 0)
+		r = NULL;
 
 	rte_rwlock_read_unlock(RTE_EAL_TAILQ_RWLOCK);
 
-	if (te == NULL) {
+	if (r == NULL) {
 		rte_errno = ENOENT;
 		return NULL;
 	}
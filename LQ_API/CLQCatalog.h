@@ -0,0 +1,62 @@
+/*!
+ * \file CLQCatalog.h
+ * \brief Queue Topology Catalog Definition
+ * \details
+ * LQ_INIT 이 TAT_QUEUE_DEF (혹은 Catalog File) 을 한번 읽어서 Memory Zone 에 기록하며,
+ * 각 Process 는 Initialize 시에 DB 대신 Memory Zone 의 Catalog 를 읽어서 Queue 를 Attach 한다.
+ * LQ_INIT 과 LQ API 가 함께 사용한다.
+ */
+
+#ifndef _LQ_CATALOG_H_
+#define _LQ_CATALOG_H_
+
+#include <stdint.h>
+
+//! Define Name of Catalog Memory Zone
+#define DEF_STR_QUEUE_CATALOG	"QUEUE_CATALOG"
+
+//! Define Magic Number of Catalog ('LQT2')
+/*!
+ * LQ_INIT 이 Catalog 를 모두 기록한 뒤에 설정한다. Magic 이 다르면 Process 는 DB 를 조회한다.
+ */
+#define DEF_CATALOG_MAGIC	0x4C515432
+
+//! Define Max Count of Queue Definition in Catalog
+#define DEF_MAX_QUEUE_DEF	1024
+
+//! Define Max Length of Name in Catalog
+#define DEF_CATALOG_NAME_LEN	64
+
+//! Define Queue Definition Structure (a Row of TAT_QUEUE_DEF)
+/*!
+ * \struct _queue_def
+ * \brief Structure for Queue Definition
+ */
+typedef struct _queue_def
+{
+	char		szPkgName[DEF_CATALOG_NAME_LEN];	//!< PKG_NAME
+	char		szNodeType[DEF_CATALOG_NAME_LEN];	//!< NODE_TYPE
+	char		szWriteProc[DEF_CATALOG_NAME_LEN];	//!< WRITE_PROC
+	char		szReadProc[DEF_CATALOG_NAME_LEN];	//!< READ_PROC
+	uint32_t	unElemCnt;		//!< ELEM_CNT
+	char		cBiDir;			//!< BI_DIR_YN ('Y' / 'N')
+	char		cMultiType;		//!< MULTI_TYPE
+	uint32_t	unHighWm;		//!< HIGH_WM (Ring Size 대비 %, 0 : Watermark 미사용)
+	uint32_t	unLowWm;		//!< LOW_WM (Ring Size 대비 %, 0 : HIGH_WM 의 절반)
+	uint32_t	unRowIdx;		//!< Row Order in TAT_QUEUE_DEF (혹은 Catalog File), 같은 PKG_NAME, NODE_TYPE 의 Attach 순서
+}QUEUE_DEF;
+
+//! Define Queue Topology Catalog Structure
+/*!
+ * \struct _queue_catalog
+ * \brief Structure for Catalog Memory Zone
+ * PKG_NAME, NODE_TYPE 순으로 정렬되어 있으며, Process 는 같은 PKG_NAME, NODE_TYPE 의 범위만 확인한다.
+ */
+typedef struct _queue_catalog
+{
+	volatile uint32_t	unMagic;	//!< DEF_CATALOG_MAGIC
+	uint32_t	unCount;			//!< Count of Queue Definition
+	QUEUE_DEF	stDef[DEF_MAX_QUEUE_DEF];
+}QUEUE_CATALOG;
+
+#endif
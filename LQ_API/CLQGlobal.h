@@ -9,6 +9,8 @@
 #ifndef _LQ_GLOBAL_H_
 #define _LQ_GLOBAL_H_
 
+#include "CLQMempool.h"
+
 //################ Define Error Code ################//
 //! Config Error
 #define E_Q_NO_CONFIG	E_RTE_NO_CONFIG		//1002
@@ -30,6 +32,8 @@
 #define E_Q_INVAL		EINVAL	//22
 //! There is no space for data 
 #define E_Q_NOSPC		ENOSPC	//28
+//! Wait Timeout
+#define E_Q_TIMEDOUT	ETIMEDOUT	//110
 //! DB Connection Error
 #define E_Q_DB_FAIL		2000
 //! Mmap Function Error
@@ -40,6 +44,8 @@
 #define E_Q_TRUN		2003
 //! Msync Function Error
 #define E_Q_MSYNC		2004
+//! Enqueued, but Backup File Write Error (Data is in the Queue, Do not retry)
+#define E_Q_BACKUP		2005
 
 
 //###################################################//
@@ -77,17 +83,8 @@
 //! Define Default Ring Element Count
 #define DEF_DEFAULT_RING_COUNT	0x40000
 
-//! Define Memory Pool Name
-/*!
- * Memory Pool Name For to Use in Application
- */
-#define DEF_BASE_MEMORY_POOL_NAME    "BASE_MEMORY_POOL"
-
-//! Define Command Memory Pool Name
-/*!
- * Memory Pool Name For to Use in Application
- */
-#define DEF_CMD_MEMORY_POOL_NAME    "COMMAND_MEMORY_POOL"
+//! Define Max Count of Grow Chunk
+#define DEF_MAX_GROW_CHUNK	24
 
 //! Define timeout Count
 #define DEF_TIME_OUT_COUNT	20
@@ -116,9 +113,47 @@
 //! Define Command Signal
 #define DEF_SIG_COMMAND 1
 
+//! Define Wait Mode Signal
+/*!
+ * Producer 가 sigqueue 로 RTS 를 전송하고 Consumer 는 sigtimedwait 로 대기 (기존 방식)
+ */
+#define DEF_WAIT_MODE_SIGNAL 0
+
+//! Define Wait Mode Futex
+/*!
+ * Consumer 는 Shared Memory 의 Futex Word 에서 대기하고
+ * Producer 는 Consumer 가 Sleep 상태일 때만 FUTEX_WAKE 호출
+ */
+#define DEF_WAIT_MODE_FUTEX 1
+
+//! Define Wait Mode Hybrid
+/*!
+ * Consumer 는 일정 시간(Spin Budget) 동안 Read Ring 을 Polling 한 뒤 Futex Word 에서 대기
+ * Spin Budget 은 Ring 별로 관측된 데이터 도착 간격에 따라 조정
+ */
+#define DEF_WAIT_MODE_HYBRID 2
+
+//! Define ReadWait Timeout (sec)
+#define DEF_WAIT_TIMEOUT_SEC 1
+
+//! Define Default Max Spin Budget (usec, Hybrid Mode)
+#define DEF_SPIN_MAX_USEC 100
+
 //! Define Max Bulk
 #define DEF_MAX_BULK	32
 
+//! Define Max Burst
+/*!
+ * ReadBurstData 로 한번에 읽을 수 있는 최대 데이터 수 (Read Memory Buffer 배열 크기)
+ */
+#define DEF_MAX_BURST	DEF_MEM_BUF_1024
+
+//! Define Max Segment Count of a Data
+/*!
+ * Zero Copy Read(iovec) 시 필요한 Segment List 의 최대 크기 (Jumbo Size / Memory Buffer Data Size)
+ */
+#define DEF_MAX_IOV		512
+
 //! Define Max Jumbo Msg Count
 #define DEF_MAX_JUMBO	32
 
@@ -132,6 +167,19 @@
  */
 #define DEF_MAX_FAIL_CNT	10000
 
+//! Define Watermark Event : Write Ring 이 High Watermark 를 넘음
+#define DEF_WM_EVENT_HIGH	1
+
+//! Define Watermark Event : Write Ring 이 Low Watermark 까지 비워짐
+#define DEF_WM_EVENT_LOW	2
+
+//! Define Max Sleep Time of Producer Parked on Write Ring (usec)
+/*!
+ * WriteDataWait / CommitDataWait 는 Consumer 의 Wakeup 이 없어도 다음의 시간마다 다시 시도한다
+ * (Memory Pool 은 다른 Ring 의 Consumer 가 반환할 수도 있으므로)
+ */
+#define DEF_PROD_WAIT_USEC	1000
+
 //! Define String Format For Q Name
 #define DEF_STR_FORMAT_Q_NAME "%s_%s"
 
@@ -141,17 +189,106 @@
 //! Define Write Multi Queue Type
 #define DEF_MULTI_TYPE_WRITE 'W'
 
+//! Define Broadcast Queue Type
+/*!
+ * Write Process 가 한번 입력한 데이터를 Queue 에 연결된 모든 Read Process 가 각자의 위치(Cursor)에서 읽는다.
+ * Memory Buffer 는 복사하지 않고 Reference Count 로 공유하며, 가장 느린 Read Process 의 위치까지 Slot 을 반환한다.
+ */
+#define DEF_MULTI_TYPE_BCAST 'B'
+
 //! Define Multi Queue Prefix
 #define DEF_STR_MULTI_PREFIX "MULTI"
 
+//! Define Broadcast Queue Suffix
+#define DEF_STR_BCAST_SUFFIX "BCAST"
+
 //! Define Default Backup Folder
 #define DEF_STR_DEFAULT_BK_PATH "/NMD/USER/lhj/LQ_LIB/BACKUP"
 
-//! Define Default Backup File Mask
-#define DEF_DEFAULT_BK_MASK 0x7FF
+//! Define Magic Number of Backup File ('LQJ2')
+#define DEF_BK_MAGIC	0x4C514A32
+
+//! Define Magic Number of Consumer Checkpoint File ('LQC1')
+#define DEF_CKPT_MAGIC	0x4C514331
+
+//! Define Default Checkpoint Ack Interval
+/*!
+ * Consumer 가 다음의 Count 만큼 ReadComplete 할 때마다 Checkpoint File 을 msync
+ * Group Commit Mode 에서는 Group Commit Thread 가 주기적으로 msync 한다
+ */
+#define DEF_CKPT_ACK_CNT	1
+
+//! Define Size of Backup Record Log (Power of 2)
+/*!
+ * Backup File 에 데이터를 가변 길이 Record 로 순차 기록하는 영역의 크기
+ * Consumer 가 완료하지 않은 Record 를 덮어써야 할 경우 Backup 에 실패한다 (-E_Q_NOSPC)
+ */
+#define DEF_BK_LOG_SIZE	(DEF_MEM_BUF_1M * 32)
+
+//! Define Size of Backup Record Log Segment (Power of 2, DEF_BK_LOG_SIZE 의 약수)
+/*!
+ * Record Log 는 Segment 단위로 순환하며 Record 는 Segment 경계에 걸쳐 기록되지 않는다
+ * Segment 는 모든 Consumer 가 그 안의 Record 를 완료한 뒤에만 다시 사용한다
+ */
+#define DEF_BK_SEG_SIZE	(DEF_MEM_BUF_1M * 4)
+
+//! Define Alignment of Backup Record
+#define DEF_BK_ALIGN	8
+
+//! Define Default Group Commit Message Count
+/*!
+ * Group Commit Mode 에서 한 Backup File 에 다음의 Count 만큼 Sync 되지 않은 데이터가 쌓이면 바로 msync
+ */
+#define DEF_SYNC_MSG_CNT	1024
+
+//! Define Default Group Commit Interval (usec)
+#define DEF_SYNC_USEC		1000
+
+//! Define Default Size of Async Backup Staging Ring (Power of 2)
+/*!
+ * Async Backup Mode 에서 Backup Writer Thread 가 기록하지 않은 데이터가 다음의 Count 만큼 쌓이면 Producer 가 대기한다
+ */
+#define DEF_BK_STAGE_CNT	16384
+
+//! Define Idle Sleep Time of Async Backup Writer Thread (usec)
+#define DEF_BK_IDLE_USEC	100
+
+//! Define Max Wait Time of Detach for Staged Backup Data (usec)
+/*!
+ * Detach 시 Backup Writer Thread 가 Staging Ring 에 남은 데이터를 처리할 때까지 다음의 시간만큼 대기한다
+ */
+#define DEF_BK_DETACH_WAIT_USEC	1000000
 
 //! Define Name of Command Ring
 #define DEF_STR_COMMAND_RING "COMMAND_RING"
+
+//! Define Magic Number of Topology Command ('LQTC')
+/*!
+ * Command Ring 으로 수신한 데이터가 TOPOLOGY_CMD 이면 ReceiveCommand 가 Application 에 전달하지 않고 직접 처리한다
+ */
+#define DEF_TOPO_MAGIC		0x4C515443
+
+//! Define Topology Command : Attach Ring
+#define DEF_TOPO_ATTACH		1
+
+//! Define Topology Command : Detach Ring
+#define DEF_TOPO_DETACH		2
+
+//! Define Magic Number of Topology Command Result ('LQTR')
+/*!
+ * Topology Command 를 처리하지 못한 Process 가 Command 를 보낸 Process 의 Command Ring 으로 TOPOLOGY_RESULT 를 전송한다
+ * ReceiveCommand 는 TOPOLOGY_RESULT 를 다른 Command 와 같이 Application 에 전달한다
+ */
+#define DEF_TOPO_RESULT_MAGIC	0x4C515452
+
+//! Define Max Count of Epoch Slot
+/*!
+ * Ring Table 을 읽는 Thread (CLQManager, CLQHandle, Group Commit Thread) 의 최대 개수
+ */
+#define DEF_MAX_EPOCH_SLOT	64
+
+//! Define Sleep Time while Waiting Grace Period of Ring Table (usec)
+#define DEF_EPOCH_WAIT_USEC	10
  
 //! Define Ring Create Request Structure
 /*!
@@ -179,22 +316,88 @@ typedef struct _ring_info
 	uint32_t		unMMapSize;		//!< Size of MMap
 	uint32_t		unMask;			//!< Mask of The Backup File
 	int				nIdx;			//!< Index of Consumer Info Array in the ring 
+	uint64_t		unArrivalGap;	//!< Average Wait Cycles until Data Arrival (Hybrid Mode, 0 : Unknown)
+	volatile uint32_t	unWmOver;	//!< 1 : High Watermark Event 를 전달하고 Low Watermark Event 를 전달하지 않은 상태 (Write Ring)
 	int				fd;				//!< Backup File Descriptor
 	void			*pBackup;				//!< mmap Pointer of Backup File
 	char			szName[DEF_MEM_BUF_64];	 //!< Name of this Ring
-	vector<string>	vecRelProc;		//!< Name of Relation Process
+	vector<string>	*pvecRelProc;	//!< Name of Relation Process (Copy On Write, 이전 Vector 는 SyncEpoch 이후에 삭제)
 }RING_INFO;
 
-//! Define Consumer Info Structure For Backup
+//! Define Size Class Structure
 /*!
- * \struct _cons_info
- * \brief Structure for Consumer Process 
+ * \struct _mbuf_class
+ * \brief Data Memory Pool of a Size Class
  */
-typedef struct _cons_info
+typedef struct _mbuf_class
 {
-	char		strName[40];
-	uint32_t	unTail;
-}CONS_INFO;
+	struct rte_mempool	*pstMemPool;	//!< Memory Pool
+	uint32_t			unSegSize;		//!< Data Size of a Memory Buffer (Headroom 제외)
+}MBUF_CLASS;
+
+//! Define Size Class Table Structure
+/*!
+ * \struct _mbuf_class_table
+ * \brief Size Class Table (Segment Size 오름차순)
+ * Grow Chunk 가 추가되면 새 Table 을 만들어 교체하며, 이전 Table 은 Lock 없이 읽는 Thread 를 위해 해제하지 않는다
+ */
+typedef struct _mbuf_class_table
+{
+	int			nCnt;											//!< Count of Size Class
+	MBUF_CLASS	stClass[DEF_MAX_MBUF_CLASS + DEF_MAX_GROW_CHUNK];	//!< Size Class
+}MBUF_CLASS_TABLE;
+
+//! Define Topology Command Structure
+/*!
+ * \struct _topology_cmd
+ * \brief Structure for Attach / Detach Ring Request (SendTopology)
+ */
+typedef struct _topology_cmd
+{
+	uint32_t	unMagic;		//!< DEF_TOPO_MAGIC
+	int			nOp;			//!< DEF_TOPO_ATTACH / DEF_TOPO_DETACH
+	int			nType;			//!< Ring Type of Receiver (Read:0/ Write:1)
+	int			nElemCnt;		//!< Count of Ring Elements
+	char		cMultiType;		//!< Multi Queue Type (Read:'R', Write :'W', Broadcast : 'B', else : NULL)
+	uint32_t	unHighWm;		//!< High Watermark of Ring (Attach, 0 : 사용 안함)
+	uint32_t	unLowWm;		//!< Low Watermark of Ring (Attach)
+	int			nSenderInstance;	//!< Instance ID of Sender Process
+	char		szSenderProc[DEF_MEM_BUF_128];	//!< Name of Sender Process (처리 실패 시 TOPOLOGY_RESULT 를 전송)
+	char		szWriteProc[DEF_MEM_BUF_128];	//!< Name of Write Process
+	char		szReadProc[DEF_MEM_BUF_128];	//!< Name of Read Process
+}TOPOLOGY_CMD;
+
+//! Define Topology Command Result Structure
+/*!
+ * \struct _topology_result
+ * \brief Structure for Failure of Topology Command (ApplyTopology)
+ */
+typedef struct _topology_result
+{
+	uint32_t	unMagic;		//!< DEF_TOPO_RESULT_MAGIC
+	int			nOp;			//!< DEF_TOPO_ATTACH / DEF_TOPO_DETACH
+	int			nType;			//!< Ring Type of Receiver (Read:0/ Write:1)
+	int			nResult;		//!< Result of ApplyTopology (-E_Q_*)
+	int			nInstanceID;	//!< Instance ID of Process which Applied the Command
+	char		szProcName[DEF_MEM_BUF_128];	//!< Name of Process which Applied the Command
+	char		szWriteProc[DEF_MEM_BUF_128];	//!< Name of Write Process
+	char		szReadProc[DEF_MEM_BUF_128];	//!< Name of Read Process
+}TOPOLOGY_RESULT;
+
+//! Define Epoch Slot Structure
+/*!
+ * \struct _epoch_slot
+ * \brief Read Side State of Ring Table per Thread
+ * Ring Table 을 읽는 동안 unEpoch 에 진입 시점의 Topology Epoch 을 기록하며, 그 외에는 0 (Quiescent)
+ * Slot 은 한 Thread 만 사용한다. Slot 0 은 CLQManager 를 사용하는 Thread 의 Slot 이므로 CLQManager 의 함수는 한 Thread 에서만 호출하고,
+ * 다른 Thread 는 CLQHandle 로 각자의 Slot 을 사용한다
+ */
+typedef struct _epoch_slot
+{
+	volatile uint32_t	unUsed;		//!< 1 : Thread 가 사용 중인 Slot
+	uint32_t			unNest;		//!< Nesting Count of Epoch Guard (Owner Thread 만 변경하므로 Atomic 이 아님)
+	volatile uint64_t	unEpoch;	//!< Topology Epoch at Entering (0 : Quiescent)
+} __rte_cache_aligned EPOCH_SLOT;
 
 //! Define Producer Info Structure For Backup
 /*!
@@ -207,36 +410,106 @@ typedef struct _prod_info
 	uint32_t	unTail;
 }PROD_INFO;
 
-//! Define Data Buffer Structure
+//! Define Backup Record Header Structure
 /*!
- * \struct _data_buffer
- * \brief Data Buffer Structure for Data Backup
+ * \struct _backup_record
+ * \brief Header of Variable Length Record in Backup Record Log
+ * Header 뒤에 Memory Buffer Chain 의 모든 Segment 데이터가 연속으로 기록된다.
  */
-typedef struct _data_buffer
+typedef struct _backup_record
 {
-	uint32_t	unBuffLen;
-	bool		bNext;
-	char		szBuff[DEF_MBUF_DATA_SIZE];
-}DATA_BUFFER;
+	uint32_t	unLen;		//!< Length of Data (Total Length of Memory Buffer Chain)
+	uint32_t	unSeq;		//!< Ring Position of Data
+	uint16_t	unSegCnt;	//!< Segment Count of Memory Buffer Chain
+	uint16_t	unReserved;
+}BACKUP_RECORD;
+
+//! Define Async Backup Stage Structure
+/*!
+ * \struct _backup_stage
+ * \brief Memory Buffer handed to Backup Writer Thread (Async Backup)
+ * 입력한 Memory Buffer 는 Consumer 가 읽고 있으므로 Memory Buffer 의 Field 에 기록하지 않고 별도로 전달한다.
+ */
+typedef struct _backup_stage
+{
+	struct rte_ring	*pstRing;	//!< Ring which the Memory Buffer was Enqueued
+	struct rte_mbuf	*pstMbuf;	//!< Enqueued Memory Buffer (Producer 가 보유한 Reference)
+	uint32_t		unSeq;		//!< Ring Position of the Memory Buffer
+	int				nIdx;		//!< Index Number of Producer of the Ring
+}BACKUP_STAGE;
 
 //! Define Backup File Info Structure
 /*!
  * \struct _backup_info
  * \brief Structure for Backup File 
+ * Backup File 은 [BACKUP_INFO][Record Offset Index (unMask + 1)][Record Log (unLogSize)] 로 구성된다.
+ * Index 는 Ring Position 으로 Record 의 Log Offset 을 찾기 위해 사용한다.
  */
 typedef struct _backup_info
 {
-	uint16_t	unConsCnt;
+	uint32_t	unMagic;	//!< DEF_BK_MAGIC
 	uint16_t	unProdCnt;
-	uint32_t	unMask;
-	CONS_INFO	stConsInfo[RTE_RING_MAX_CONS_COUNT]; //20
+	uint16_t	unReserved;
+	uint32_t	unMask;		//!< Mask of Record Offset Index (Ring Size - 1)
+	uint64_t	unLogSize;	//!< Size of Record Log
+	volatile uint64_t	unLogTail;	//!< Log Offset to Write Next Record (Producer 간 Atomic 증가)
 	PROD_INFO	stProdInfo[RTE_RING_MAX_PROD_COUNT]; //20
 }BACKUP_INFO;
 
+//! Define Consumer Cursor Structure For Checkpoint
+/*!
+ * \struct _ckpt_cursor
+ * \brief Consumer Cursor in Checkpoint File
+ * Consumer 마다 하나의 Cache Line 을 사용하며, ReadComplete 시 이 Cache Line 만 변경한다.
+ */
+typedef struct _ckpt_cursor
+{
+	char		strName[40];
+	volatile uint32_t	unTail;		//!< Consumer Tail (Ring Position)
+	uint32_t	unReserved;
+	volatile uint64_t	unAckCnt;	//!< Count of ReadComplete
+	uint64_t	unSyncCnt;	//!< unAckCnt at Last msync
+} __rte_cache_aligned CKPT_CURSOR;
+
+//! Define Consumer Checkpoint File Info Structure
+/*!
+ * \struct _ckpt_info
+ * \brief Structure for Consumer Checkpoint File
+ * Consumer 의 Cursor 는 Backup File 과 분리된 작은 Checkpoint File ([Queue Name].ckpt) 에 기록한다.
+ */
+typedef struct _ckpt_info
+{
+	uint32_t	unMagic;	//!< DEF_CKPT_MAGIC
+	uint16_t	unConsCnt;
+	uint16_t	unReserved;
+	CKPT_CURSOR	stCursor[RTE_RING_MAX_CONS_COUNT] __rte_cache_aligned;
+}CKPT_INFO;
+
+//! Record Offset Index of Backup File
+#define BACKUP_INDEX(b)	((uint64_t*)((BACKUP_INFO*)(b) + 1))
+
+//! Record Log of Backup File
+#define BACKUP_LOG(b)	((char*)(BACKUP_INDEX(b) + ((BACKUP_INFO*)(b))->unMask + 1))
+
+//! Size of Backup Record for Data Length
+#define BACKUP_RECORD_SIZE(len)	\
+	(((uint64_t)sizeof(BACKUP_RECORD) + (len) + DEF_BK_ALIGN - 1) & ~((uint64_t)DEF_BK_ALIGN - 1))
+
+//! Size of Backup File
+#define BACKUP_FILE_SIZE(mask, logsize)	\
+	(sizeof(BACKUP_INFO) + ((uint64_t)(mask) + 1) * sizeof(uint64_t) + (logsize))
+
 //! Define Hash Function Pointer
 /*!
  * Get to Write Ring Idx
  */
 typedef int p_function_hash(void *a_pArgs);
 
+//! Define Watermark Event Function Pointer
+/*!
+ * Write Ring 이 High Watermark 를 넘거나(DEF_WM_EVENT_HIGH) Low Watermark 까지 비워졌을 때(DEF_WM_EVENT_LOW)
+ * Producer 에서 호출된다. (a_nIdx : Write Ring Index, a_unCount : Ring 의 데이터 수)
+ */
+typedef void p_function_watermark(int a_nIdx, int a_nEvent, uint32_t a_unCount, void *a_pArgs);
+
 #endif
@@ -0,0 +1,793 @@
+/*!
+ * \file CLQHandle.cpp
+ * \brief CLQHandle class Source File
+ */
+
+#include "CLQHandle.hpp"
+#include <string.h>
+#include <stdarg.h>
+
+using namespace std;
+
+//! Constructor
+/*!
+ * \brief Constructor for CLQHandle Class
+ * \details CLQManager 는 Initialize 가 완료된 상태여야 하며 Handle 보다 먼저 삭제되면 안된다.
+ * \param a_pclsLQ is Initialized CLQManager of this Process
+ */
+CLQHandle::CLQHandle(CLQManager *a_pclsLQ)
+{
+	m_pclsLQ = a_pclsLQ;
+
+	memset(m_szErrorMsg, 0x00, sizeof(m_szErrorMsg));
+	m_pszJumboBuff = NULL;
+
+	//Init Read Mbuf, Write Mbuf
+	memset(m_pstReadMbuf, 0x00, sizeof(m_pstReadMbuf));
+	memset(m_pstWriteMbuf, 0x00, sizeof(m_pstWriteMbuf));
+	m_pstReserveMbuf = NULL;
+	m_pstCurMbuf = NULL;
+
+	//Init Read Mbuf, Write Mbuf Index
+	m_unCurReadMbufIdx = 0;
+	m_unTotReadMbufIdx = 0;
+	m_unCurWriteMbufIdx = 0;
+	memset(m_unFailCnt, 0x00, sizeof(m_unFailCnt));
+	memset(m_nProdIdx, 0x00, sizeof(m_nProdIdx));
+	memset(m_pstProdRing, 0x00, sizeof(m_pstProdRing));
+
+	m_nReadRingIdx = 0;
+	m_nWaitRingIdx = 0;
+	m_unConsHead = 0;
+	m_bReadComplete = false;
+	m_pstReadRing = NULL;
+	m_nConsIdx = 0;
+
+	//Ring Table 을 Lock 없이 읽기 위한 Epoch Slot (Topology Command 로 Ring 이 Detach 될 때 사용)
+	m_nEpochSlot = m_pclsLQ->RegisterEpoch();
+	m_pstEpochSlot = (m_nEpochSlot < 0) ? NULL : &(m_pclsLQ->m_stEpochSlot[m_nEpochSlot]);
+
+	//Thread 전용 Mempool Cache 는 Handle 을 처음 사용하는 Thread 에서 할당 (AttachSlot)
+	m_bSlotAttached = false;
+}
+
+//! Destructor
+/*!
+ * \brief Destructor for CLQHandle Class
+ * \details Commit 되지 않은 Memory Buffer 를 Memory Pool 로 돌려 준다.
+ */
+CLQHandle::~CLQHandle()
+{
+	Abort();
+
+	for(int i = 0; i < m_unCurWriteMbufIdx; i++)
+	{
+		rte_pktmbuf_free(m_pstWriteMbuf[i]);
+	}
+
+	if(m_pszJumboBuff)
+		free(m_pszJumboBuff);
+
+	m_pclsLQ->UnregisterEpoch(m_nEpochSlot);
+
+	//lcore Slot 은 할당 받은 Thread 에서만 반환 가능 (다른 Thread 에서 삭제하면 Thread 종료 후 다른 Thread 가 재사용)
+	if(m_bSlotAttached && pthread_equal(m_stSlotThread, pthread_self()))
+		rte_lcore_slot_detach();
+}
+
+/*!
+ * \brief Insert Data To m_pstWriteMbuf
+ * \details 여러개의 Data 를 Buffer 에 넣은 후 CommitData 로 한번에 Queue 에 입력
+ * \param a_pszData is Data Pointer to Insert
+ * \param a_nSize is Size of Data
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory;
+ */
+int CLQHandle::InsertData( char *a_pszData, int a_nSize )
+{
+	int ret = 0;
+	char *pCur = a_pszData;
+	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL;
+
+	if(unlikely(m_unCurWriteMbufIdx >= DEF_MAX_BURST))
+		return -E_Q_NOMEM;
+
+	AttachSlot();
+
+	ret = m_pclsLQ->AllocDataMbuf(a_nSize, &pHeadMbuf);
+	if(unlikely(ret < 0))
+	{
+		SetErrorMsg("Mbuf Alloc Failed [Size:%d]", a_nSize);
+		return ret;
+	}
+
+	for(pMbuf = pHeadMbuf; pMbuf != NULL; pMbuf = pMbuf->next)
+	{
+		memcpy( rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+		pCur += pMbuf->data_len;
+	}
+
+	m_pstWriteMbuf[m_unCurWriteMbufIdx++] = pHeadMbuf;
+	return 0;
+}
+
+/*!
+ * \brief Commit Data to Queue
+ * \details InsertData 로 입력된 데이터를 Queue 에 입력한다.
+ * -E_Q_NOSPC 로 실패한 경우 데이터는 유지되므로 다시 호출하여 재시도 할 수 있다.
+ * \param a_nIdx is Index of Write Ring
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for enqueue;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQHandle::CommitData( int a_nIdx )
+{
+	return EnqueueData(a_nIdx);
+}
+
+/*!
+ * \brief Write Data to Queue
+ * \param a_pszData is Data Pointer to Insert
+ * \param a_nSize is Size of Data
+ * \param a_nIdx is Index of Write Ring
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQHandle::WriteData( char *a_pszData, int a_nSize, int a_nIdx )
+{
+	int ret = 0;
+
+	if(unlikely(a_nIdx < 0 || a_nIdx >= m_pclsLQ->m_unWriteRingCount))
+		return -E_Q_INVAL;
+
+	ret = InsertData(a_pszData, a_nSize);
+	if(unlikely(ret < 0))
+	{
+		m_unFailCnt[a_nIdx]++;
+		return ret;
+	}
+
+	ret = EnqueueData(a_nIdx);
+	if(unlikely(ret < 0 && m_unCurWriteMbufIdx > 0))
+	{
+		//Free Memory Buffer
+		for(int i = 0; i < m_unCurWriteMbufIdx; i++)
+			rte_pktmbuf_free(m_pstWriteMbuf[i]);
+		m_unCurWriteMbufIdx = 0;
+	}
+
+	return ret;
+}
+
+/*!
+ * \brief Write Data to Queue (Blocking / Timeout)
+ * \details Ring Full 혹은 Memory Pool 부족이면 Write Ring 의 Futex Word 에서 대기한 뒤 다시 시도한다. (CLQManager::WriteDataWait 참조)
+ * \param a_pszData is Data Pointer to Insert
+ * \param a_nSize is Size of Data
+ * \param a_nIdx is Index of Write Ring
+ * \param a_nTimeout is Timeout (msec, -1 : 공간이 생길 때까지 대기)
+ * \return
+ *   - WriteData 참조
+ *   - -E_Q_TIMEDOUT there is no space until timeout
+ */
+int CLQHandle::WriteDataWait( char *a_pszData, int a_nSize, int a_nIdx, int a_nTimeout )
+{
+	int ret = 0;
+	uint64_t unDeadline = UINT64_MAX;
+
+	if(a_nTimeout >= 0)
+		unDeadline = rte_rdtsc() + (uint64_t)a_nTimeout * rte_get_tsc_hz() / 1000;
+
+	while(1)
+	{
+		//입력 전 단계의 실패만 재시도 (입력 후 Backup 실패는 -E_Q_BACKUP)
+		ret = WriteData(a_pszData, a_nSize, a_nIdx);
+		if(likely(ret != -ENOBUFS && ret != -E_Q_NOSPC))
+			return ret;
+
+		ret = m_pclsLQ->WaitWriteSpace(m_pstEpochSlot, a_nIdx, ret, unDeadline);
+		if(ret < 0)
+			return ret;
+	}
+}
+
+/*!
+ * \brief Commit Data to Queue (Blocking / Timeout)
+ * \details Ring Full 이면 m_pstWriteMbuf 를 유지한 채 대기한 뒤 다시 시도한다.
+ * \param a_nIdx is Index of Write Ring
+ * \param a_nTimeout is Timeout (msec, -1 : 공간이 생길 때까지 대기)
+ * \return
+ *   - CommitData 참조
+ *   - -E_Q_TIMEDOUT there is no space until timeout (m_pstWriteMbuf 는 유지된다)
+ */
+int CLQHandle::CommitDataWait( int a_nIdx, int a_nTimeout )
+{
+	int ret = 0;
+	uint64_t unDeadline = UINT64_MAX;
+
+	if(a_nTimeout >= 0)
+		unDeadline = rte_rdtsc() + (uint64_t)a_nTimeout * rte_get_tsc_hz() / 1000;
+
+	while(1)
+	{
+		//입력하지 못한 Memory Buffer 가 남아 있을 때만 재시도
+		ret = EnqueueData(a_nIdx);
+		if(likely(ret != -ENOBUFS && ret != -E_Q_NOSPC) || m_unCurWriteMbufIdx == 0)
+			return ret;
+
+		ret = m_pclsLQ->WaitWriteSpace(m_pstEpochSlot, a_nIdx, ret, unDeadline);
+		if(ret < 0)
+			return ret;
+	}
+}
+
+/*!
+ * \brief Reserve Memory Buffer to Write Data in Place
+ * \details 기록 후 Commit() 혹은 Abort() 를 호출해야 한다. (CLQManager::Reserve 참조)
+ * \param a_pszBuff is Buffer Pointer to Write Data
+ * \param a_nSize is Size of Data (<= 가장 큰 Size Class 의 Segment Size)
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Size Over; Already Reserved
+ *   - -E_Q_NOSPC there is no space for alloc;
+ */
+int CLQHandle::Reserve( char **a_pszBuff, int a_nSize )
+{
+	int ret = 0;
+	MBUF_CLASS_TABLE *pstTbl = m_pclsLQ->m_pstMbufClass;
+
+	//가장 큰 Size Class 의 Memory Buffer 한개에 들어가야 한다
+	if(unlikely(pstTbl->nCnt == 0 || (uint32_t)a_nSize > pstTbl->stClass[pstTbl->nCnt - 1].unSegSize))
+	{
+		SetErrorMsg("Reserve Size Over, [Size:%d]", a_nSize);
+		return -E_Q_INVAL;
+	}
+
+	if(unlikely(m_pstReserveMbuf != NULL))
+	{
+		SetErrorMsg("Memory Buffer is Already Reserved");
+		return -E_Q_INVAL;
+	}
+
+	AttachSlot();
+
+	ret = m_pclsLQ->AllocDataMbuf(a_nSize, &m_pstReserveMbuf);
+	if(unlikely(ret < 0))
+	{
+		m_pstReserveMbuf = NULL;
+		SetErrorMsg("Mbuf Alloc Failed [Size:%d]", a_nSize);
+		return ret;
+	}
+
+	*a_pszBuff = rte_pktmbuf_mtod(m_pstReserveMbuf, char *);
+
+	return 0;
+}
+
+/*!
+ * \brief Reserve Memory Buffer Chain to Write Data in Place (Segment List)
+ * \param a_pstIov is Segment List to Write Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
+ * \param a_nSize is Size of Data
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Already Reserved
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory; Segment List Size < Count of Segment
+ */
+int CLQHandle::Reserve( struct iovec *a_pstIov, int *a_pnIovCnt, int a_nSize )
+{
+	int ret = 0;
+
+	if(unlikely(m_pstReserveMbuf != NULL))
+	{
+		SetErrorMsg("Memory Buffer is Already Reserved");
+		return -E_Q_INVAL;
+	}
+
+	AttachSlot();
+
+	ret = m_pclsLQ->AllocDataMbuf(a_nSize, &m_pstReserveMbuf);
+	if(unlikely(ret < 0))
+	{
+		m_pstReserveMbuf = NULL;
+		SetErrorMsg("Mbuf Alloc Failed [Size:%d]", a_nSize);
+		return ret;
+	}
+
+	//Segment List 가 부족하면 할당한 Memory Buffer 를 해제
+	ret = CLQManager::GetMbufIov(m_pstReserveMbuf, a_pstIov, a_pnIovCnt);
+	if(unlikely(ret < 0))
+	{
+		rte_pktmbuf_free(m_pstReserveMbuf);
+		m_pstReserveMbuf = NULL;
+		SetErrorMsg("Over Segment List Size, seg_cnt : %d", *a_pnIovCnt);
+		return ret;
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Commit Reserved Memory Buffer to Queue
+ * \details -E_Q_NOSPC 로 실패한 경우 Memory Buffer 는 유지되므로 다시 호출하여 재시도 할 수 있다.
+ * \param a_nIdx is Index of Write Ring
+ * \return CommitData() 참조
+ */
+int CLQHandle::Commit( int a_nIdx )
+{
+	if(m_pstReserveMbuf != NULL)
+	{
+		if(unlikely(m_unCurWriteMbufIdx >= DEF_MAX_BURST))
+			return -E_Q_NOMEM;
+
+		m_pstWriteMbuf[m_unCurWriteMbufIdx++] = m_pstReserveMbuf;
+		m_pstReserveMbuf = NULL;
+	}
+
+	return EnqueueData(a_nIdx);
+}
+
+/*!
+ * \brief Abort Reserved Memory Buffer
+ * \return None
+ */
+void CLQHandle::Abort()
+{
+	if(m_pstReserveMbuf != NULL)
+	{
+		rte_pktmbuf_free(m_pstReserveMbuf);
+		m_pstReserveMbuf = NULL;
+	}
+}
+
+/*!
+ * \brief Enqueue m_pstWriteMbuf to Write Ring and Backup
+ * \details Backup Mode 에서는 Producer Info 의 Tail 과 Backup File 을 맞추기 위하여
+ * Enqueue 부터 Backup 까지 Process 의 Backup Lock 을 잡는다.
+ * Async Backup Mode 에서는 Enqueue 로 Ring 의 위치(Seq)를 할당한 뒤 Lock 을 해제하고 Stage 에 전달한다.
+ * Stage 가 없어서 대기하는 동안(Backpressure) 다른 Thread 의 Enqueue 를 막지 않는다.
+ * \param a_nIdx is Index of Write Ring
+ * \return CommitData() 참조
+ */
+int CLQHandle::EnqueueData( int a_nIdx )
+{
+	int ret = 0;
+	int nProdIdx = 0;
+	uint32_t unSeq = 0;
+	struct rte_ring *pstRing = NULL;
+	struct rte_mbuf *pSeg = NULL;
+
+	if(unlikely(a_nIdx < 0 || a_nIdx >= m_pclsLQ->m_unWriteRingCount))
+		return -E_Q_INVAL;
+
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(m_pstEpochSlot, &m_pclsLQ->m_unTopoEpoch);
+
+	pstRing = m_pclsLQ->m_stWriteRingInfo[a_nIdx].pstRing;
+
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		return -E_Q_INVAL;
+	}
+
+	nProdIdx = GetProdIdx(a_nIdx, pstRing);
+	if(unlikely(nProdIdx < 0))
+		return nProdIdx;
+
+	if(unlikely(m_unCurWriteMbufIdx == 0))
+		return 0;
+
+	//Fail 이 일정 Count 의 배수일 때 Consumer Process 가 Signal 을 유실하였다고 판단하여 다시 전송
+	if(unlikely((m_unFailCnt[a_nIdx] % DEF_MAX_FAIL_CNT) == 0))
+	{
+		m_pclsLQ->SendRTS(pstRing, nProdIdx);
+	}
+
+	//High Watermark 를 넘은 Write Ring 이 있을 때만 Low Watermark 와 Throttling 을 확인
+	if(unlikely(m_pclsLQ->m_unWmOverCnt > 0))
+		m_pclsLQ->CheckWatermark(pstRing);
+
+	if(m_pclsLQ->m_bBackup)
+		pthread_mutex_lock(&m_pclsLQ->m_stBackupLock);
+
+	if(pstRing->flags & RING_F_BCAST)
+	{
+		ret = CLQManager::EnqueueBcast(pstRing, m_pstWriteMbuf, m_unCurWriteMbufIdx, nProdIdx, m_pclsLQ->m_bBackup, &unSeq);
+		if(unlikely(ret == -EDQUOT))
+		{
+			m_pclsLQ->RaiseWatermark(pstRing);
+			ret = 0;
+		}
+	}
+	else
+	{
+		//Backup 이 끝날 때까지 Consumer 가 Memory Buffer 를 반환하지 않도록 모든 Segment 의 Reference 를 보유
+		if(m_pclsLQ->m_bBackup)
+		{
+			for(uint16_t i = 0; i < m_unCurWriteMbufIdx; i++)
+			{
+				for(pSeg = m_pstWriteMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+					rte_mbuf_refcnt_update(pSeg, 1);
+			}
+		}
+
+		ret = rte_ring_mp_enqueue_bulk_pos(
+				pstRing, (void**)m_pstWriteMbuf, m_unCurWriteMbufIdx, RTE_RING_QUEUE_FIXED, nProdIdx, &unSeq);
+
+		//입력은 성공하였고 High Watermark 를 넘음
+		if(unlikely(ret == -EDQUOT))
+		{
+			m_pclsLQ->RaiseWatermark(pstRing);
+			ret = 0;
+		}
+
+		if(unlikely(ret < 0) && m_pclsLQ->m_bBackup)
+		{
+			for(uint16_t i = 0; i < m_unCurWriteMbufIdx; i++)
+			{
+				for(pSeg = m_pstWriteMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+					rte_mbuf_refcnt_update(pSeg, -1);
+			}
+		}
+	}
+
+	if(unlikely(ret < 0))
+	{
+		if(m_pclsLQ->m_bBackup)
+			pthread_mutex_unlock(&m_pclsLQ->m_stBackupLock);
+
+		m_unFailCnt[a_nIdx]++;
+		return ret;
+	}
+
+	if(m_pclsLQ->m_bBackup)
+	{
+		//Stage 는 Seq 로 기록 위치를 찾으므로 Enqueue 순서와 달라도 됨 (WriteBackupFile)
+		if(m_pclsLQ->m_bAsyncBackup)
+		{
+			pthread_mutex_unlock(&m_pclsLQ->m_stBackupLock);
+			ret = m_pclsLQ->BackupWriteData(pstRing, nProdIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx);
+		}
+		else
+		{
+			ret = m_pclsLQ->BackupWriteData(pstRing, nProdIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx);
+			pthread_mutex_unlock(&m_pclsLQ->m_stBackupLock);
+		}
+
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	m_unCurWriteMbufIdx = 0;
+
+	m_pclsLQ->SendRTS(pstRing, nProdIdx);
+
+	return ret;
+}
+
+/*!
+ * \brief Get Producer Info Index of this Handle in Write Ring
+ * \details rte_ring_mp_enqueue_bulk_idx 는 Producer Info 의 Head/Tail (복구 위치) 을 Lock 없이 기록하므로
+ * 여러 Handle 이 같은 Index 를 사용하면 서로의 복구 위치를 덮어쓴다. 따라서 Handle 은 Ring 마다 처음 입력할 때
+ * 자신의 Producer Info ("<Process>.H<Epoch Slot>") 를 등록하여 사용한다.
+ * Backup Mode 에서는 Backup File 이 Process 의 Producer Info 에 연결되어 있으므로 Process 의 Index 를 사용하며,
+ * Enqueue 부터 Backup 까지 Backup Lock 을 잡아 Handle 간에 순서를 맞춘다. (EnqueueData 참조)
+ * \param a_nIdx is Index of Write Ring
+ * \param a_pstRing is Write Ring
+ * \return
+ *   - Index of Producer Info on Success
+ *   - -E_Q_NOMEM Producer Count Over; No Epoch Slot
+ */
+int CLQHandle::GetProdIdx( int a_nIdx, struct rte_ring *a_pstRing )
+{
+	int ret = 0;
+	char szName[DEF_MEM_BUF_128];
+
+	if(m_pclsLQ->m_bBackup)
+		return m_pclsLQ->m_stWriteRingInfo[a_nIdx].nIdx;
+
+	if(likely(m_pstProdRing[a_nIdx] == a_pstRing))
+		return m_nProdIdx[a_nIdx];
+
+	//Epoch Slot 번호로 Handle 의 이름을 구분
+	if(unlikely(m_nEpochSlot < 0))
+	{
+		SetErrorMsg("There is no Epoch Slot to Register Producer Info");
+		return -E_Q_NOMEM;
+	}
+
+	snprintf(szName, sizeof(szName), "%s.H%d", m_pclsLQ->m_szProcName, m_nEpochSlot);
+
+	ret = (int)m_pclsLQ->InsertProdInfo(szName, m_pclsLQ->m_nInstanceID, getpid(), a_pstRing);
+	if(unlikely(ret < 0))
+	{
+		SetErrorMsg("Register Producer Info %s in Ring %s Failed", szName, a_pstRing->name);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return ret;
+	}
+
+	m_nProdIdx[a_nIdx] = ret;
+	m_pstProdRing[a_nIdx] = a_pstRing;
+
+	return ret;
+}
+
+/*!
+ * \brief Read up to N Data from Read Rings
+ * \details Process 에 Attach 된 Read Ring 을 Round Robin 으로 확인하여 데이터가 있는 Ring 에서
+ * 최대 a_nCount 개 까지 읽어들인다. 대기하지 않으므로 데이터가 없을 경우 0 을 Return 한다.
+ * 읽은 위치는 Handle 에 보관되므로 여러 Thread 가 같은 Ring 을 동시에 읽을 수 있다.
+ * 다음 Read 전에 반드시 ReadComplete() 를 호출해야 한다.
+ * \param a_nCount is max count of element (<= DEF_MAX_BURST)
+ * \return
+ *   - Count of Read Data on Success (0 : There is no Data)
+ *   - -E_Q_INVAL burst Count > Max Burst Count
+ */
+int CLQHandle::ReadBurstData( int a_nCount )
+{
+	int ret = 0;
+	int nIdx = 0;
+	struct rte_ring *pstRing = NULL;
+
+	if(unlikely(a_nCount > DEF_MAX_BURST || a_nCount <= 0))
+	{
+		SetErrorMsg("Invalid Burst Count %d (Max %d)", a_nCount, DEF_MAX_BURST);
+		return -E_Q_INVAL;
+	}
+
+	m_unCurReadMbufIdx = 0;
+	m_unTotReadMbufIdx = 0;
+
+	AttachSlot();
+
+	CLQEpochGuard clsGuard(m_pstEpochSlot, &m_pclsLQ->m_unTopoEpoch);
+
+	for(int i = 0; i < m_pclsLQ->m_unReadRingCount; i++)
+	{
+		nIdx = (m_nWaitRingIdx + i) % m_pclsLQ->m_unReadRingCount;
+		pstRing = m_pclsLQ->m_stReadRingInfo[nIdx].pstRing;
+
+		//Detach 된 Ring
+		if(pstRing == NULL)
+			continue;
+
+		//Broadcast Queue 는 Process 당 하나의 위치만 가지므로 CLQManager 로만 읽는다
+		if(pstRing->flags & RING_F_BCAST)
+			continue;
+
+		ret = rte_ring_mc_dequeue_bulk_pos(pstRing, (void**)m_pstReadMbuf, a_nCount, RTE_RING_QUEUE_VARIABLE, &m_unConsHead);
+		if(ret > 0)
+		{
+			m_nReadRingIdx = nIdx;
+			m_nWaitRingIdx = nIdx + 1;
+			m_pstReadRing = pstRing;
+			m_nConsIdx = m_pclsLQ->m_stReadRingInfo[nIdx].nIdx;
+			m_unTotReadMbufIdx = ret;
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Get Next Data
+ * \details 여러개의 Memory Buffer 로 나누어진 데이터는 Handle 의 Jumbo Buffer 로 복사하여 넘겨 준다.
+ * \param a_pszBuff is Buffer Pointer to Store Data
+ * \return
+ *   - Size of Data on Success
+ *   - -E_Q_INVAL Read buffer Index Over;
+ *   - -E_Q_NOMEM out of Memory;
+ */
+int CLQHandle::GetNext( char **a_pszBuff )
+{
+	char *p = NULL;
+	struct rte_mbuf *pMbuf = NULL;
+
+	if(unlikely(m_unCurReadMbufIdx >= m_unTotReadMbufIdx))
+		return -E_Q_INVAL;
+
+	m_pstCurMbuf = pMbuf = m_pstReadMbuf[m_unCurReadMbufIdx++];
+
+	if(unlikely(pMbuf->nb_segs > 1))
+	{
+		if( rte_pktmbuf_pkt_len(pMbuf) > DEF_MEM_JUMBO )
+		{
+			SetErrorMsg("Over Jumbo Memory Buffer Size %d, data_size : %d", DEF_MEM_JUMBO, rte_pktmbuf_pkt_len(pMbuf));
+			return -E_Q_NOMEM;
+		}
+
+		if(m_pszJumboBuff == NULL)
+		{
+			m_pszJumboBuff = (char*)malloc(DEF_MEM_JUMBO);
+			if(m_pszJumboBuff == NULL)
+			{
+				SetErrorMsg("Jumbo Buffer Alloc Failed");
+				return -E_Q_NOMEM;
+			}
+		}
+
+		p = m_pszJumboBuff;
+		for(; pMbuf != NULL; pMbuf = pMbuf->next)
+		{
+			memcpy(p, rte_pktmbuf_mtod(pMbuf, char *), rte_pktmbuf_data_len(pMbuf));
+			p += rte_pktmbuf_data_len(pMbuf);
+		}
+
+		*a_pszBuff = m_pszJumboBuff;
+	}
+	else
+	{
+		*a_pszBuff = rte_pktmbuf_mtod( pMbuf, char * );
+	}
+
+	if(unlikely(m_unCurReadMbufIdx == m_unTotReadMbufIdx))
+	{
+		m_bReadComplete = true;
+	}
+
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+}
+
+/*!
+ * \brief Get Next Data as Segment List (Zero Copy)
+ * \param a_pstIov is Segment List to Store Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
+ * \return
+ *   - Size of Data on Success
+ *   - -E_Q_INVAL Read buffer Index Over;
+ *   - -E_Q_NOMEM Segment List Size < Count of Segment (a_pnIovCnt 에 필요한 Segment 수를 기록, 더 큰 Segment List 로 다시 호출하면 같은 데이터를 읽음)
+ */
+int CLQHandle::GetNext( struct iovec *a_pstIov, int *a_pnIovCnt )
+{
+	int ret = 0;
+
+	if(unlikely(m_unCurReadMbufIdx >= m_unTotReadMbufIdx))
+		return -E_Q_INVAL;
+
+	m_pstCurMbuf = m_pstReadMbuf[m_unCurReadMbufIdx++];
+
+	ret = CLQManager::GetMbufIov(m_pstCurMbuf, a_pstIov, a_pnIovCnt);
+	if(unlikely(ret < 0))
+	{
+		//a_pnIovCnt 크기의 Segment List 로 같은 데이터를 다시 읽을 수 있도록 Index 를 되돌림
+		m_unCurReadMbufIdx--;
+		SetErrorMsg("Over Segment List Size, seg_cnt : %d", *a_pnIovCnt);
+		return ret;
+	}
+
+	if(unlikely(m_unCurReadMbufIdx == m_unTotReadMbufIdx))
+	{
+		m_bReadComplete = true;
+	}
+
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+}
+
+/*!
+ * \brief Read Complete
+ * \details 읽은 Slot 을 완료 처리한다. (rte_ring_read_complete 는 대기하지 않음)
+ * Ring 의 Tail 은 연속으로 완료된 Slot 까지만 이동하므로 Process 의 Consumer Info 에는
+ * 그 위치 중 더 큰 값만 기록하며, Backup Mode 일 경우 Backup File 에 반영한다.
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_MSYNC msync function error
+ */
+int CLQHandle::ReadComplete()
+{
+	int ret = 0;
+	uint32_t unOld = 0;
+	uint32_t unNext = 0;
+	struct rte_ring *pstRing = NULL;
+	struct rte_ring_cons_info *pstConsInfo = NULL;
+
+	if(likely(m_bReadComplete))
+	{
+		CLQEpochGuard clsGuard(m_pstEpochSlot, &m_pclsLQ->m_unTopoEpoch);
+
+		//읽은 뒤에 Ring 이 Detach 되어도 Slot 은 완료 처리 (Ring 의 Tail 이 멈추지 않도록)
+		pstRing = m_pstReadRing;
+		pstConsInfo = &(pstRing->cons.cons_info[m_nConsIdx]);
+		rte_ring_read_complete(pstRing, m_unConsHead, m_unConsHead + m_unTotReadMbufIdx);
+		unNext = pstRing->cons.tail;
+
+		do
+		{
+			unOld = pstConsInfo->tail;
+			if((int32_t)(unNext - unOld) <= 0)
+				break;
+		} while(rte_atomic32_cmpset(&(pstConsInfo->tail), unOld, unNext) == 0);
+
+		do
+		{
+			unOld = pstConsInfo->head;
+			if((int32_t)(unNext - unOld) <= 0)
+				break;
+		} while(rte_atomic32_cmpset(&(pstConsInfo->head), unOld, unNext) == 0);
+
+		m_bReadComplete = false;
+
+		//Low Watermark 이상 비었으면 대기중인 Producer 를 깨움
+		CLQManager::WakeProducer(pstRing);
+		//High Watermark 를 넘은 Ring 을 Low Watermark 까지 비웠으면 상태 해제
+		rte_ring_wm_leave(pstRing);
+
+		if(m_pclsLQ->m_bBackup && m_pclsLQ->m_stReadRingInfo[m_nReadRingIdx].pstRing == pstRing)
+		{
+			pthread_mutex_lock(&m_pclsLQ->m_stBackupLock);
+			ret = m_pclsLQ->BackupReadData(pstRing, m_nConsIdx);
+			pthread_mutex_unlock(&m_pclsLQ->m_stBackupLock);
+
+			if(ret < 0)
+			{
+				SetErrorMsg("Backup Read Data Failed");
+				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+				return ret;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Free Read Bulk Data
+ * \details 처리가 완전히 완료된 Memory Buffer 를 해제한다.
+ * \return None
+ */
+void CLQHandle::FreeReadBulkData()
+{
+	for(int i = 0; i < m_unTotReadMbufIdx ; i++)
+	{
+		rte_pktmbuf_free(m_pstReadMbuf[i]);
+	}
+
+	//Memory Pool 부족으로 대기중인 Producer 를 깨움
+	if(m_pstReadRing != NULL)
+		CLQManager::WakeProducer(m_pstReadRing);
+
+	m_unTotReadMbufIdx = 0;
+	m_unCurReadMbufIdx = 0;
+}
+
+/*!
+ * \brief Set Error Msg if Error occur
+ * \param a_szFmt is Format of Error Msg
+ * \param ... is Aurgument For Error Msg
+ * \return None
+ */
+void CLQHandle::SetErrorMsg(const char *a_szFmt, ...)
+{
+	va_list	args;
+
+	va_start(args, a_szFmt);
+	vsnprintf(m_szErrorMsg, sizeof(m_szErrorMsg), a_szFmt, args);
+	va_end(args);
+}
+
+/*!
+ * \brief Get Error Msg
+ * \return Error Msg
+ */
+char *CLQHandle::GetErrorMsg() { return m_szErrorMsg; }
@@ -0,0 +1,133 @@
+/*!
+ * \file CLQHandle.hpp
+ * \brief CLQHandle Class Header File
+ * \details
+ * 하나의 CLQManager(Process 의 Ring, Memory Pool, Config Attach 정보)를 여러 Thread 가 공유하기 위한 Handle
+ * Thread 마다 하나의 CLQHandle 을 생성하며, 각 Handle 은 자신의 Memory Buffer 배열과 Error Msg 를 가진다.
+ * Backup Mode 에서는 같은 Write Ring 에 CLQManager 의 Write 함수와 CLQHandle 을 동시에 사용하지 않는다.
+ * Mempool Cache 의 lcore Slot 은 Handle 을 처음 사용하는 Thread 에서 할당하며, 같은 Thread 에서 Handle 을 삭제해야 반환된다.
+ */
+
+#ifndef _LQ_HANDLE_H_
+#define _LQ_HANDLE_H_
+
+#include "CLQManager.hpp"
+
+/*!
+ * \class CLQHandle
+ * \brief Per-Thread Reader/Writer Handle For LQ API
+ */
+class CLQHandle
+{
+	public:
+		//! Constructor
+		CLQHandle(CLQManager *a_pclsLQ);
+		//! Destructor
+		~CLQHandle();
+		//! Get Error Msg
+		char *GetErrorMsg();
+
+		//################ Write Function ################//
+		//! Insert Data (CommitData 로 Queue 에 입력)
+		int InsertData( char *a_pszData, int a_nSize );
+		//! Commit Data to Queue
+		int CommitData( int a_nIdx = 0 );
+		//! Write Data (Index)
+		int WriteData( char *a_pszData, int a_nSize, int a_nIdx = 0 );
+		//! Write Data (Index, Wait until Consumer frees Space or Timeout)
+		int WriteDataWait( char *a_pszData, int a_nSize, int a_nIdx = 0, int a_nTimeout = -1 );
+		//! Commit Data to Queue (Wait until Consumer frees Space or Timeout)
+		int CommitDataWait( int a_nIdx = 0, int a_nTimeout = -1 );
+		//! Reserve Memory Buffer to Write Data in Place (Zero Copy)
+		int Reserve( char **a_pszBuff, int a_nSize );
+		//! Reserve Memory Buffer Chain to Write Data in Place (Zero Copy, Segment List)
+		int Reserve( struct iovec *a_pstIov, int *a_pnIovCnt, int a_nSize );
+		//! Commit Reserved Memory Buffer to Queue
+		int Commit( int a_nIdx = 0 );
+		//! Abort Reserved Memory Buffer
+		void Abort();
+		//################################################//
+
+		//################ Read Function ################//
+		//! Read up to N Data From Read Rings
+		int ReadBurstData( int a_nCount );
+		//! Read Next Memory Buffer
+		int GetNext( char **a_pszBuff );
+		//! Read Next Memory Buffer as Segment List (Zero Copy)
+		int GetNext( struct iovec *a_pstIov, int *a_pnIovCnt );
+		//! Read Complete
+		int ReadComplete();
+		//! Free Read Bulk Data
+		void FreeReadBulkData();
+		//###############################################//
+
+	private:
+		//! Process 의 Attach 정보 (Ring, Memory Pool, Backup)
+		CLQManager *m_pclsLQ;
+		//! Error Msg
+		char m_szErrorMsg[DEF_MEM_BUF_1024];
+		//! Jumbo Data 를 복사하기 위한 Buffer (처음 사용 시 할당)
+		char *m_pszJumboBuff;
+
+		//! 데이터를 읽어들이기 위한 Memory Buffer
+		struct rte_mbuf *m_pstReadMbuf[DEF_MAX_BURST];
+		//! 데이터를 쓰기 위한 Memory Buffer
+		struct rte_mbuf *m_pstWriteMbuf[DEF_MAX_BURST];
+		//! Reserve 후 Commit 되지 않은 Memory Buffer
+		struct rte_mbuf *m_pstReserveMbuf;
+		//! 현재 읽고 있는 Memory Buffer
+		struct rte_mbuf *m_pstCurMbuf;
+
+		//! m_pstReadMbuf 배열에서 현재 Index 위치
+		uint16_t m_unCurReadMbufIdx;
+		//! m_pstReadMbuf 배열의 Total Size
+		uint16_t m_unTotReadMbufIdx;
+		//! m_pstWriteMbuf 배열에서 현재 Index 위치
+		uint16_t m_unCurWriteMbufIdx;
+		//! Write Ring 별 Send Error Count
+		uint32_t m_unFailCnt[DEF_MAX_RING];
+		//! Write Ring 별 Handle 의 Producer Info Index (Recovery Cursor 를 다른 Handle 과 공유하지 않음)
+		int m_nProdIdx[DEF_MAX_RING];
+		//! m_nProdIdx 를 등록한 Ring (Detach 후 다른 Ring 이 Attach 되면 다시 등록)
+		struct rte_ring *m_pstProdRing[DEF_MAX_RING];
+		//! 현재 읽고 있는 Ring 의 m_stReadRingInfo Index
+		int m_nReadRingIdx;
+		//! 데이터를 찾기 시작할 m_stReadRingInfo 의 Index (Round Robin)
+		int m_nWaitRingIdx;
+		//! 읽어들인 데이터의 Ring 내 시작 위치 (ReadComplete 에서 사용)
+		uint32_t m_unConsHead;
+		//! Read Complete Flag
+		bool m_bReadComplete;
+		//! 읽어들인 데이터의 Ring (Detach 되어도 ReadComplete 에서 완료 처리)
+		struct rte_ring *m_pstReadRing;
+		//! 읽어들인 Ring 에서 Process 의 Consumer Index
+		int m_nConsIdx;
+		//! Ring Table 을 읽기 위한 Epoch Slot Index (CLQManager::RegisterEpoch)
+		int m_nEpochSlot;
+		//! Ring Table 을 읽기 위한 Epoch Slot (NULL : Slot 할당 실패)
+		EPOCH_SLOT *m_pstEpochSlot;
+		//! Mempool Cache 의 lcore Slot 을 할당 받은 Thread (m_bSlotAttached 가 true 일 때 유효)
+		pthread_t m_stSlotThread;
+		//! lcore Slot 할당 여부 (처음 사용하는 Thread 에서 할당)
+		bool m_bSlotAttached;
+
+		//! Set Error Msg
+		void SetErrorMsg(const char *a_szFmt, ...);
+		//! Enqueue m_pstWriteMbuf to Write Ring and Backup
+		int EnqueueData( int a_nIdx );
+		//! Get Producer Info Index of this Handle in Write Ring
+		int GetProdIdx( int a_nIdx, struct rte_ring *a_pstRing );
+
+		//! Attach lcore Slot (Mempool Cache) to the Thread using this Handle
+		inline void AttachSlot()
+		{
+			if(likely(m_bSlotAttached))
+				return;
+
+			rte_lcore_slot_attach();
+			m_stSlotThread = pthread_self();
+			m_bSlotAttached = true;
+		}
+};
+
+#endif
@@ -8,6 +8,10 @@
 #include "CLQManager.hpp"
 #include <string.h>
 #include <unistd.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 
 using namespace std;
@@ -30,6 +34,101 @@ using namespace std;
  */
 int DefaultHashFunc(void *a_pArgs) { return 0; }
 
+//! Futex Wait
+/*!
+ * \brief Futex Word 의 값이 a_nVal 과 같을 경우 Wakeup 또는 Timeout 까지 대기
+ * \details Shared Memory 에 위치한 Word 이므로 FUTEX_PRIVATE_FLAG 를 사용하지 않음
+ * \param a_pstFutex is Futex Word
+ * \param a_nVal is Expected Value of Futex Word
+ * \param a_pstTimeout is Timeout
+ * \return 0 on Wakeup, -1 on Timeout or Value Changed (errno)
+ */
+static inline int FutexWait(rte_atomic32_t *a_pstFutex, int32_t a_nVal, const struct timespec *a_pstTimeout)
+{
+	return syscall(SYS_futex, (int32_t*)&(a_pstFutex->cnt), FUTEX_WAIT, a_nVal, a_pstTimeout, NULL, 0);
+}
+
+//! Futex Wake
+/*!
+ * \brief Futex Word 에서 대기중인 Process 한개를 깨운다
+ * \param a_pstFutex is Futex Word
+ * \return Count of Woken Process
+ */
+static inline int FutexWake(rte_atomic32_t *a_pstFutex)
+{
+	return syscall(SYS_futex, (int32_t*)&(a_pstFutex->cnt), FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+//! Futex Wake All
+/*!
+ * \brief Futex Word 에서 대기중인 모든 Process 를 깨운다
+ * \param a_pstFutex is Futex Word
+ * \return Count of Woken Process
+ */
+static inline int FutexWakeAll(rte_atomic32_t *a_pstFutex)
+{
+	return syscall(SYS_futex, (int32_t*)&(a_pstFutex->cnt), FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+//! Sync Pages
+/*!
+ * \brief mmap 영역 중 [a_unFrom, a_unTo) 를 포함하는 Page 만 msync
+ * \param a_pBase is mmap Pointer (Page Aligned)
+ * \param a_unFrom is Start Offset
+ * \param a_unTo is End Offset
+ * \param a_unLimit is Size of mmap
+ * \param a_nFlags is msync Flags (MS_SYNC / MS_ASYNC)
+ * \return 0 on Success, -1 on Error (errno)
+ */
+static inline int SyncPages(char *a_pBase, size_t a_unFrom, size_t a_unTo, size_t a_unLimit, int a_nFlags)
+{
+	static const size_t unPageMask = (size_t)sysconf(_SC_PAGESIZE) - 1;
+
+	if(a_unTo > a_unLimit)
+		a_unTo = a_unLimit;
+
+	a_unFrom &= ~unPageMask;
+	if(a_unFrom >= a_unTo)
+		return 0;
+
+	return msync(a_pBase + a_unFrom, a_unTo - a_unFrom, a_nFlags);
+}
+
+//! Sync Circular Region
+/*!
+ * \brief 크기가 2 의 제곱인 순환 영역에서 [a_unFrom, a_unTo) 위치가 포함된 Page 만 msync
+ * \param a_pBase is mmap Pointer (Page Aligned)
+ * \param a_unRegion is Offset of Region in mmap
+ * \param a_unRegionSize is Size of Region (Power of 2)
+ * \param a_unFrom is Start Position (Not Masked)
+ * \param a_unTo is End Position (Not Masked)
+ * \param a_unLimit is Size of mmap
+ * \param a_nFlags is msync Flags (MS_SYNC / MS_ASYNC)
+ * \return 0 on Success, -1 on Error (errno)
+ */
+static inline int SyncCircular(char *a_pBase, size_t a_unRegion, uint64_t a_unRegionSize
+								, uint64_t a_unFrom, uint64_t a_unTo, size_t a_unLimit, int a_nFlags)
+{
+	uint64_t unStart = a_unFrom & (a_unRegionSize - 1);
+	uint64_t unEnd = a_unTo & (a_unRegionSize - 1);
+	int ret = 0;
+
+	if(a_unTo - a_unFrom >= a_unRegionSize)
+		return SyncPages(a_pBase, a_unRegion, a_unRegion + a_unRegionSize, a_unLimit, a_nFlags);
+
+	if(unStart < unEnd)
+		return SyncPages(a_pBase, a_unRegion + unStart, a_unRegion + unEnd, a_unLimit, a_nFlags);
+
+	if(unStart > unEnd)
+	{
+		ret = SyncPages(a_pBase, a_unRegion + unStart, a_unRegion + a_unRegionSize, a_unLimit, a_nFlags);
+		if(ret == 0)
+			ret = SyncPages(a_pBase, a_unRegion, a_unRegion + unEnd, a_unLimit, a_nFlags);
+	}
+
+	return ret;
+}
+
 
 //! Constructor
 /*!
@@ -86,6 +185,38 @@ CLQManager::CLQManager(char *a_szPkgName, char *a_szNodeType, char *a_szProcName
 
 	//Init Base Mempool Pointer
 	m_pstDataMemPool = NULL;
+	memset(m_stMbufClassTbl, 0x00, sizeof(m_stMbufClassTbl));
+	m_pstMbufClass = &m_stMbufClassTbl[0];
+	m_nMbufClassVer = 0;
+	m_nGrowChunk = 0;
+	m_nMaxGrowChunk = 0;
+	m_unGrowCount = 0;
+	pthread_mutex_init(&m_stGrowLock, NULL);
+
+	//Init Reserved Memory Buffer
+	m_pstReserveMbuf = NULL;
+
+	//Init Backup Lock
+	pthread_mutex_init(&m_stBackupLock, NULL);
+
+	//Init Group Commit
+	m_bGroupCommit = false;
+	m_bSyncRun = false;
+	m_unSyncMsgCnt = DEF_SYNC_MSG_CNT;
+	m_unSyncUsec = DEF_SYNC_USEC;
+	pthread_mutex_init(&m_stSyncLock, NULL);
+	pthread_cond_init(&m_stSyncCond, NULL);
+
+	//Init Consumer Checkpoint
+	m_unCkptAckCnt = DEF_CKPT_ACK_CNT;
+
+	//Init Async Backup
+	m_bAsyncBackup = false;
+	m_bAsyncRun = false;
+	m_pstStageRing = NULL;
+	m_pstStageFree = NULL;
+	m_pstStage = NULL;
+	m_nAsyncBackupErr = 0;
 
 	//Init Command Ring
 	m_pstCmdSndRing = NULL;
@@ -101,13 +232,17 @@ CLQManager::CLQManager(char *a_szPkgName, char *a_szNodeType, char *a_szProcName
 		m_stReadRingInfo[i].pstRing		= NULL;
 		m_stReadRingInfo[i].unFailCnt	= 0;
 		m_stReadRingInfo[i].nIdx		= 0;
-		m_stReadRingInfo[i].vecRelProc.clear();
+		m_stReadRingInfo[i].unArrivalGap	= 0;
+		m_stReadRingInfo[i].unWmOver	= 0;
+		m_stReadRingInfo[i].pvecRelProc	= NULL;
 		memset(m_stReadRingInfo[i].szName, 0x00, sizeof(m_stReadRingInfo[i].szName));
 
 		m_stWriteRingInfo[i].pstRing	= NULL;
 		m_stWriteRingInfo[i].unFailCnt	= 0;
 		m_stWriteRingInfo[i].nIdx		= 0;
-		m_stWriteRingInfo[i].vecRelProc.clear();
+		m_stWriteRingInfo[i].unArrivalGap	= 0;
+		m_stWriteRingInfo[i].unWmOver	= 0;
+		m_stWriteRingInfo[i].pvecRelProc	= NULL;
 		memset(m_stWriteRingInfo[i].szName, 0x00, sizeof(m_stWriteRingInfo[i].szName));
 	}
 
@@ -142,6 +277,27 @@ CLQManager::CLQManager(char *a_szPkgName, char *a_szNodeType, char *a_szProcName
 	//Init Read Complete Flag
 	m_bReadComplete = false;		
 
+	//Init Wait Mode
+	m_nWaitMode = DEF_WAIT_MODE_SIGNAL;
+	m_pstFutex = NULL;
+	m_unCmdRcvIdx = 0;
+	m_unWaitRingIdx = 0;
+	m_unSpinMaxUsec = DEF_SPIN_MAX_USEC;
+	m_unSpinMaxCycles = 0;
+	m_pfuncWatermark = NULL;
+	m_pWmArgs = NULL;
+	m_unWmThrottleUsec = 0;
+	m_unWmOverCnt = 0;
+
+	//Init Epoch (Slot 0 : CLQManager 를 사용하는 Thread)
+	m_unTopoEpoch = 1;
+	m_nSyncEpochSlot = -1;
+	memset((void*)m_stEpochSlot, 0x00, sizeof(m_stEpochSlot));
+	m_stEpochSlot[0].unUsed = 1;
+
+	//lcore Slot 은 Initialize 에서 할당
+	m_bSlotAttached = false;
+
 	m_pclsDbConn = NULL;
 	
 	m_pclsConfig = NULL;
@@ -155,6 +311,32 @@ CLQManager::CLQManager(char *a_szPkgName, char *a_szNodeType, char *a_szProcName
  */
 CLQManager::~CLQManager()
 {	
+	//Backup Writer Thread 는 종료 전에 Staging Ring 에 남은 데이터를 모두 기록한다
+	if(m_bAsyncBackup)
+	{
+		m_bAsyncRun = false;
+		pthread_join(m_stAsyncThread, NULL);
+
+		free(m_pstStageRing);
+		m_pstStageRing = NULL;
+		free(m_pstStageFree);
+		m_pstStageFree = NULL;
+		free(m_pstStage);
+		m_pstStage = NULL;
+	}
+
+	//Group Commit Thread 는 종료 전에 남은 Dirty Range 를 msync 한다
+	if(m_bGroupCommit)
+	{
+		pthread_mutex_lock(&m_stSyncLock);
+		m_bSyncRun = false;
+		pthread_cond_signal(&m_stSyncCond);
+		pthread_mutex_unlock(&m_stSyncLock);
+
+		pthread_join(m_stSyncThread, NULL);
+		UnregisterEpoch(m_nSyncEpochSlot);
+	}
+
 	for(int i = 0; i < m_unReadRingCount ; i++)
 	{
 		if( m_stReadRingInfo[i].pBackup != MAP_FAILED && m_stReadRingInfo[i].pBackup != NULL )
@@ -177,8 +359,27 @@ CLQManager::~CLQManager()
 			close(m_stWriteRingInfo[i].fd);
 	}
 
+	for(int i = 0; i < DEF_MAX_RING; i++)
+	{
+		if(m_stReadRingInfo[i].pvecRelProc)
+			delete m_stReadRingInfo[i].pvecRelProc;
+
+		if(m_stWriteRingInfo[i].pvecRelProc)
+			delete m_stWriteRingInfo[i].pvecRelProc;
+	}
+
 	if(m_pclsConfig)
 		delete m_pclsConfig;
+
+	pthread_mutex_destroy(&m_stBackupLock);
+	pthread_mutex_destroy(&m_stGrowLock);
+	pthread_mutex_destroy(&m_stSyncLock);
+	pthread_cond_destroy(&m_stSyncCond);
+
+	//Mempool Cache 에 남은 Memory Buffer 를 반환하고 lcore Slot 을 해제
+	//lcore Slot 은 Initialize 를 호출한 Thread 에서만 반환 가능 (다른 Thread 에서 삭제하면 Thread 종료 후 다른 Thread 가 재사용)
+	if(m_bSlotAttached && pthread_equal(m_stSlotThread, pthread_self()))
+		rte_lcore_slot_detach();
 }
 
 //! Initialize
@@ -186,23 +387,24 @@ CLQManager::~CLQManager()
  * \brief Initialize Variable, DPDK Lib
  * \details
  * 1. 기본 Memory Pool Attach
- * 2. Load Config from DB
+ * 2. Load Queue Config from Catalog Memory Zone (LQ_INIT), Catalog 가 없으면 DB
  * 3. Attach Read/Write Ring
  * 4. Command Ring Init
  * 5. Init Backup Files 
  * \param a_nCmdType is Command Type (Sender : 1 , Receiver : 0, Util : 3)
  * \param a_pFunc is Hash Function For Select Write Ring 
+ * \param a_nWaitMode is Wakeup Mode of ReadWait (Signal : 0, Futex : 1, Hybrid : 2)
  * \return 
  *   - 0 on Success
- *   - -E_Q_INVAL Process Name 미입력; rte_eal_init 실패
+ *   - -E_Q_INVAL Process Name 미입력; rte_eal_init 실패; Wait Mode 오류
  *   - -E_Q_NOENT required entry not available to return.
  *   - -E_Q_DB_FAIL DB Connection 실패
  *   - -E_Q_NO_CONFIG DB CONFIG 정보 없음, CConfig Class 생성 실패
  */
-int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
+int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc, int a_nWaitMode)
 {
 	int ret = 0;
-	char *pszQuery = NULL;
+	const struct rte_memzone *pstMz = NULL;
 
 
 	//Set Process Type (secondary)
@@ -218,6 +420,12 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		return -E_Q_INVAL;
 	}
 
+	//Secondary Process 는 lcore 가 없으므로 Mempool Cache 를 쓰도록 Process 전용 lcore Slot 을 할당
+	//할당 실패 시에도 Mempool Ring 을 직접 사용하여 동작한다
+	rte_lcore_slot_attach();
+	m_stSlotThread = pthread_self();
+	m_bSlotAttached = true;
+
 	//Attach Mempool, Using For Data Send
 	m_pstDataMemPool = rte_mempool_lookup(DEF_BASE_MEMORY_POOL_NAME);
 	if(m_pstDataMemPool == NULL)
@@ -227,6 +435,9 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		return -rte_errno;
 	}
 
+	//Size Class Memory Pool 을 Data Size 별로 선택하기 위해 Segment Size 순으로 정렬
+	LoadMbufClass();
+
 	//Attach Mempool, Using For Data Send
 	m_pstCmdMemPool = rte_mempool_lookup(DEF_CMD_MEMORY_POOL_NAME);
 	if(m_pstCmdMemPool == NULL)
@@ -245,6 +456,9 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		return -E_Q_NO_CONFIG;
 	}
 
+	//Data Mempool 이 부족할 때 Grow Chunk 를 추가하기 위한 설정
+	InitGrowPool();
+
 
 	//Util 은 여기에서 Init 함수 종료	
 	if(a_nCmdType == DEF_CMD_TYPE_UTIL)
@@ -261,6 +475,183 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 	if(a_pFunc != NULL)
 		m_pfuncHash = a_pFunc;
 
+	if(a_nWaitMode != DEF_WAIT_MODE_SIGNAL && a_nWaitMode != DEF_WAIT_MODE_FUTEX && a_nWaitMode != DEF_WAIT_MODE_HYBRID)
+	{
+		SetErrorMsg("Invalid Wait Mode %d", a_nWaitMode);
+		RTE_LOG (ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+	m_nWaitMode = a_nWaitMode;
+
+	//LQ_INIT 이 Load 한 Catalog 가 있으면 DB 를 조회하지 않는다
+	pstMz = rte_memzone_lookup(DEF_STR_QUEUE_CATALOG);
+	if(pstMz != NULL && ((QUEUE_CATALOG*)pstMz->addr)->unMagic == DEF_CATALOG_MAGIC)
+		ret = AttachCatalog((QUEUE_CATALOG*)pstMz->addr);
+	else
+		ret = AttachQueueDB();
+
+	if(ret < 0)
+		return ret;
+
+	for(int i = 0; i < m_unReadRingCount; i++)
+	{
+		RTE_LOG(INFO, EAL, "Read, Ring, %p, Idx, %d, Name, %s\n",
+							m_stReadRingInfo[i].pstRing,
+							m_stReadRingInfo[i].nIdx,
+							m_stReadRingInfo[i].szName
+						);
+								
+		if(m_stReadRingInfo[i].pvecRelProc == NULL)
+			continue;
+
+		for(unsigned int j = 0; j < m_stReadRingInfo[i].pvecRelProc->size(); j++)
+		{
+			RTE_LOG(INFO, EAL, "    --------- RelProc, %s\n",
+								(*m_stReadRingInfo[i].pvecRelProc)[j].c_str()
+								);
+		}
+	}
+
+	for(int i = 0; i < m_unWriteRingCount; i++)
+	{
+		RTE_LOG(INFO, EAL, "Write, Ring, %p, Idx, %d, Name, %s\n",
+							m_stWriteRingInfo[i].pstRing,
+							m_stWriteRingInfo[i].nIdx,
+							m_stWriteRingInfo[i].szName
+						);
+								
+		if(m_stWriteRingInfo[i].pvecRelProc == NULL)
+			continue;
+
+		for(unsigned int j = 0; j < m_stWriteRingInfo[i].pvecRelProc->size(); j++)
+		{
+			RTE_LOG(INFO, EAL, "    --------- RelProc, %s\n",
+								(*m_stWriteRingInfo[i].pvecRelProc)[j].c_str()
+								);
+		}
+
+	}
+
+	if( ((m_unReadRingCount + m_unWriteRingCount) == 0) && (a_nCmdType != DEF_CMD_TYPE_SEND) )
+	{
+		SetErrorMsg("Not Found Queue Info for %s Process ", m_szProcName);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_NO_CONFIG;
+	}
+
+	ret = InitCommandRing(m_szProcName, m_nInstanceID, a_nCmdType);
+	if(ret < 0)
+		return ret;
+
+	ret = InitWaitMode();
+	if(ret < 0)
+		return ret;
+
+	return 0;
+}
+
+/*!
+ * \brief Attach Queues in Catalog
+ * \details LQ_INIT 이 Memory Zone 에 Load 한 Catalog 에서 PKG_NAME, NODE_TYPE 이 같은 범위를 Binary Search 로 찾고,
+ * DEF_QUERY_INIT_READ_Q, DEF_QUERY_INIT_WRITE_Q 와 같은 순서로 Queue 를 Attach 한다.
+ * \param a_pstCatalog is Queue Topology Catalog
+ * \return 
+ *   - 0 on Success
+ *   - Negative Value on AttachRing Error
+ */
+int CLQManager::AttachCatalog(QUEUE_CATALOG *a_pstCatalog)
+{
+	int ret = 0;
+	int nCmp = 0;
+	uint32_t unLow = 0;
+	uint32_t unHigh = a_pstCatalog->unCount;
+	uint32_t unMid = 0;
+	QUEUE_DEF *pstDef = NULL;
+
+	rte_rmb();
+
+	//PKG_NAME, NODE_TYPE 이 같은 첫번째 위치
+	while(unLow < unHigh)
+	{
+		unMid = (unLow + unHigh) / 2;
+		pstDef = &(a_pstCatalog->stDef[unMid]);
+
+		nCmp = strcmp(pstDef->szPkgName, m_szPkgName);
+		if(nCmp == 0)
+			nCmp = strcmp(pstDef->szNodeType, m_szNodeType);
+
+		if(nCmp < 0)
+			unLow = unMid + 1;
+		else
+			unHigh = unMid;
+	}
+
+	//Read Queue
+	for(uint32_t i = unLow; i < a_pstCatalog->unCount; i++)
+	{
+		pstDef = &(a_pstCatalog->stDef[i]);
+		if(strcmp(pstDef->szPkgName, m_szPkgName) != 0 || strcmp(pstDef->szNodeType, m_szNodeType) != 0)
+			break;
+
+		if(strcmp(pstDef->szReadProc, m_szProcName) != 0)
+			continue;
+
+		RTE_LOG(INFO, EAL, "Catalog, WRITE_PROC, %s, READ_PROC, %s, ELEM_CNT, %u, BI_DIR_YN, %c, Multi Type %c, WM %u/%u\n", 
+				pstDef->szWriteProc, pstDef->szReadProc, pstDef->unElemCnt, pstDef->cBiDir, pstDef->cMultiType, pstDef->unHighWm, pstDef->unLowWm);
+
+		ret = AttachRing( pstDef->szWriteProc, pstDef->szReadProc, pstDef->unElemCnt, DEF_RING_TYPE_READ, pstDef->cMultiType, pstDef->unHighWm, pstDef->unLowWm);
+		if(ret < 0)
+			return ret;
+
+		if(pstDef->cBiDir == 'Y')
+		{
+			ret = AttachRing( pstDef->szReadProc, pstDef->szWriteProc, pstDef->unElemCnt, DEF_RING_TYPE_WRITE, 0, pstDef->unHighWm, pstDef->unLowWm);
+			if(ret < 0)
+				return ret;
+		}
+	}
+
+	//Write Queue
+	for(uint32_t i = unLow; i < a_pstCatalog->unCount; i++)
+	{
+		pstDef = &(a_pstCatalog->stDef[i]);
+		if(strcmp(pstDef->szPkgName, m_szPkgName) != 0 || strcmp(pstDef->szNodeType, m_szNodeType) != 0)
+			break;
+
+		if(strcmp(pstDef->szWriteProc, m_szProcName) != 0)
+			continue;
+
+		RTE_LOG(INFO, EAL, "Catalog, WRITE_PROC, %s, READ_PROC, %s, ELEM_CNT, %u, BI_DIR_YN, %c, Multi Type %c, WM %u/%u\n", 
+				pstDef->szWriteProc, pstDef->szReadProc, pstDef->unElemCnt, pstDef->cBiDir, pstDef->cMultiType, pstDef->unHighWm, pstDef->unLowWm);
+
+		ret = AttachRing( pstDef->szWriteProc, pstDef->szReadProc, pstDef->unElemCnt, DEF_RING_TYPE_WRITE, pstDef->cMultiType, pstDef->unHighWm, pstDef->unLowWm);
+		if(ret < 0)
+			return ret;
+
+		if(pstDef->cBiDir == 'Y')
+		{
+			ret = AttachRing( pstDef->szReadProc, pstDef->szWriteProc, pstDef->unElemCnt, DEF_RING_TYPE_READ, 0, pstDef->unHighWm, pstDef->unLowWm);
+			if(ret < 0)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Attach Queues in TAT_QUEUE_DEF
+ * \details Catalog 가 없을 경우 DB 에서 현재 Process 의 Read, Write Queue 를 조회하여 Attach 한다.
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_DB_FAIL DB Connection 실패, Query 실패
+ *   - Negative Value on AttachRing Error
+ */
+int CLQManager::AttachQueueDB()
+{
+	int ret = 0;
+	char *pszQuery = NULL;
+
 	m_pclsDbConn = new (std::nothrow) MariaDB();
 
 	if(m_pclsDbConn == NULL)
@@ -296,6 +687,14 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 
 	pszQuery = GetQuery(DEF_QUERY_INIT_READ_Q, m_szPkgName, m_szNodeType, m_szProcName);
 	ret = m_pclsDbConn->Query(pszQuery, strlen(pszQuery));
+	if(ret < 0)
+	{
+		//HIGH_WM, LOW_WM Column 이 없는 Table 이면 Watermark 없이 조회
+		RTE_LOG(INFO, EAL, "Query Fail [%s] [%d:%s], Retry without Watermark\n", pszQuery, m_pclsDbConn->GetError(), m_pclsDbConn->GetErrorMsg());
+		pszQuery = GetQuery(DEF_QUERY_INIT_READ_Q_NO_WM, m_szPkgName, m_szNodeType, m_szProcName);
+		ret = m_pclsDbConn->Query(pszQuery, strlen(pszQuery));
+	}
+
 	if(ret < 0)
 	{
 		SetErrorMsg("Query Fail [%s] [%d:%s]", pszQuery, m_pclsDbConn->GetError(), m_pclsDbConn->GetErrorMsg());
@@ -310,6 +709,8 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 	char szElemCnt	[DEF_MEM_BUF_64];
 	char szBiDir	[DEF_MEM_BUF_64];
 	char szMultiType[DEF_MEM_BUF_64];
+	char szHighWm	[DEF_MEM_BUF_64];
+	char szLowWm	[DEF_MEM_BUF_64];
 
 	FetchMaria fdata;
 
@@ -319,6 +720,8 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 	fdata.Set(szElemCnt		, sizeof(szElemCnt));	
 	fdata.Set(szBiDir		, sizeof(szBiDir));	
 	fdata.Set(szMultiType	, sizeof(szMultiType));	
+	fdata.Set(szHighWm		, sizeof(szHighWm));	
+	fdata.Set(szLowWm		, sizeof(szLowWm));	
 
 	while(true)
 	{
@@ -334,7 +737,7 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		);	
 
 
-		ret = AttachRing( szWriteProc, szReadProc, atoi(szElemCnt), DEF_RING_TYPE_READ, szMultiType[0]);
+		ret = AttachRing( szWriteProc, szReadProc, atoi(szElemCnt), DEF_RING_TYPE_READ, szMultiType[0], atoi(szHighWm), atoi(szLowWm));
 		if(ret < 0)
 		{
 			delete m_pclsDbConn;
@@ -344,7 +747,7 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		if(szBiDir[0] == 'Y')
 		{
 			ret = AttachRing( szReadProc, szWriteProc, 
-						atoi(szElemCnt), DEF_RING_TYPE_WRITE, 0);
+						atoi(szElemCnt), DEF_RING_TYPE_WRITE, 0, atoi(szHighWm), atoi(szLowWm));
 			if(ret < 0)
 			{
 				delete m_pclsDbConn;
@@ -360,9 +763,19 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 	fdata.Set(szElemCnt		, sizeof(szElemCnt));	
 	fdata.Set(szBiDir		, sizeof(szBiDir));	
 	fdata.Set(szMultiType	, sizeof(szMultiType));	
+	fdata.Set(szHighWm		, sizeof(szHighWm));	
+	fdata.Set(szLowWm		, sizeof(szLowWm));	
 
 	pszQuery = GetQuery(DEF_QUERY_INIT_WRITE_Q, m_szPkgName, m_szNodeType, m_szProcName);
 	ret = m_pclsDbConn->Query(pszQuery, strlen(pszQuery));
+	if(ret < 0)
+	{
+		//HIGH_WM, LOW_WM Column 이 없는 Table 이면 Watermark 없이 조회
+		RTE_LOG(INFO, EAL, "Query Fail [%s] [%d:%s], Retry without Watermark\n", pszQuery, m_pclsDbConn->GetError(), m_pclsDbConn->GetErrorMsg());
+		pszQuery = GetQuery(DEF_QUERY_INIT_WRITE_Q_NO_WM, m_szPkgName, m_szNodeType, m_szProcName);
+		ret = m_pclsDbConn->Query(pszQuery, strlen(pszQuery));
+	}
+
 	if(ret < 0)
 	{
 		SetErrorMsg("Query Fail [%s] [%d:%s]", pszQuery, m_pclsDbConn->GetError(), m_pclsDbConn->GetErrorMsg());
@@ -385,7 +798,7 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 				szMultiType[0]
 		);	
 
-		ret = AttachRing( szWriteProc, szReadProc, atoi(szElemCnt), DEF_RING_TYPE_WRITE, szMultiType[0]);
+		ret = AttachRing( szWriteProc, szReadProc, atoi(szElemCnt), DEF_RING_TYPE_WRITE, szMultiType[0], atoi(szHighWm), atoi(szLowWm));
 		if(ret < 0)
 		{
 			delete m_pclsDbConn;
@@ -394,7 +807,7 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 
 		if(szBiDir[0] == 'Y')
 		{
-			ret = AttachRing( szReadProc, szWriteProc, atoi(szElemCnt), DEF_RING_TYPE_READ, 0);
+			ret = AttachRing( szReadProc, szWriteProc, atoi(szElemCnt), DEF_RING_TYPE_READ, 0, atoi(szHighWm), atoi(szLowWm));
 			if(ret < 0)
 			{
 				delete m_pclsDbConn;
@@ -403,55 +816,9 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
 		}
 	}
 
-	for(int i = 0; i < m_unReadRingCount; i++)
-	{
-		RTE_LOG(INFO, EAL, "Read, Ring, %p, Idx, %d, Name, %s\n",
-							m_stReadRingInfo[i].pstRing,
-							m_stReadRingInfo[i].nIdx,
-							m_stReadRingInfo[i].szName
-						);
-								
-		for(unsigned int j = 0; j < m_stReadRingInfo[i].vecRelProc.size(); j++)
-		{
-			RTE_LOG(INFO, EAL, "    --------- RelProc, %s\n",
-								m_stReadRingInfo[i].vecRelProc[j].c_str()
-								);
-		}
-	}
-
-	for(int i = 0; i < m_unWriteRingCount; i++)
-	{
-		RTE_LOG(INFO, EAL, "Write, Ring, %p, Idx, %d, Name, %s\n",
-							m_stWriteRingInfo[i].pstRing,
-							m_stWriteRingInfo[i].nIdx,
-							m_stWriteRingInfo[i].szName
-						);
-								
-		for(unsigned int j = 0; j < m_stWriteRingInfo[i].vecRelProc.size(); j++)
-		{
-			RTE_LOG(INFO, EAL, "    --------- RelProc, %s\n",
-								m_stWriteRingInfo[i].vecRelProc[j].c_str()
-								);
-		}
-
-	}
-
-	if( ((m_unReadRingCount + m_unWriteRingCount) == 0) && (a_nCmdType != DEF_CMD_TYPE_SEND) )
-	{
-		SetErrorMsg("Not Found Queue Info for %s Process ", m_szProcName);
-		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-		delete m_pclsDbConn;
-		return -E_Q_NO_CONFIG;
-	}
-
-	ret = InitCommandRing(m_szProcName, m_nInstanceID, a_nCmdType);
-	if(ret < 0)
-	{
-		delete m_pclsDbConn;
-		return ret;
-	}
-	
 	delete m_pclsDbConn;
+	m_pclsDbConn = NULL;
+
 	return 0;
 }
 
@@ -460,6 +827,8 @@ int CLQManager::Initialize(int a_nCmdType, p_function_hash a_pFunc)
  * \details Attach 된 Ring 에 자신의 Process 정보를 기입한다. 목적은 다음과 같다
  * 1. Producer Process 가 데이터 입력 완료 후 Signal 을 전송하기 위해
  * 2. 프로세스 비정상 종료 후 Ring Position 의 복구를 위해
+ * Broadcast Queue 의 새로운 Subscriber 는 현재 Producer 위치부터 읽으며,
+ * 재시작 된 Subscriber 는 완료 처리(ReadComplete)하지 않은 데이터부터 다시 읽는다.
  * \param a_szName is Consumers Name
  * \param a_nInstanceID is Instance ID of Consumer
  * \param a_nPID is Consumers PID
@@ -482,8 +851,8 @@ uint32_t CLQManager::InsertConsInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 	memset(szName, 0x00, sizeof(szName));
 	sprintf(szName, "%s_%d", a_szName, a_nInstanceID);
 
-	//Lock to Ring
-	rte_ring_rw_lock();
+	//Lock to Ring (Registration of this Ring only)
+	rte_ring_reg_lock(a_pstRing);
 	
 	for(i = 0 ; i < a_pstRing->cons.cons_count ; i++)	
 	{
@@ -500,12 +869,29 @@ uint32_t CLQManager::InsertConsInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 	{
 		a_pstRing->cons.cons_info[i].pid = a_stPID;
 		idx = i;
+
+		if(a_pstRing->flags & RING_F_BCAST)
+		{
+			//Detach 로 탈퇴했거나 Join/Leave 중 종료된 Subscriber 는 새 Subscriber 와 같이 현재 Producer 위치부터 읽음
+			//(Leave 중 종료된 경우 leave_end 이후의 Slot 은 Reference 에 포함되지 않았으므로 이어서 읽을 수 없음)
+			if(a_pstRing->cons.cons_info[idx].subscribed != RTE_RING_SUBS_ACTIVE)
+			{
+				rte_ring_bcast_join(a_pstRing, idx);
+			}
+			else
+			{
+				a_pstRing->cons.cons_info[idx].head = a_pstRing->cons.cons_info[idx].tail;
+				rte_wmb();
+				a_pstRing->cons.cons_info[idx].subscribed = RTE_RING_SUBS_ACTIVE;
+			}
+		}
 	}
 	//Insert Reader's INFO
 	else
 	{
 		if(a_pstRing->cons.cons_count >= RTE_RING_MAX_CONS_COUNT )
 		{
+			rte_ring_reg_unlock(a_pstRing);
 			SetErrorMsg("Consumer is Full");
 			RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
 			return -E_Q_NOMEM;
@@ -515,11 +901,19 @@ uint32_t CLQManager::InsertConsInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 		a_pstRing->cons.cons_info[a_pstRing->cons.cons_count].pid = a_stPID;
 		idx = a_pstRing->cons.cons_count;
 
+		a_pstRing->cons.cons_info[idx].subscribed = RTE_RING_SUBS_JOINING;
+		rte_wmb();
+
 		a_pstRing->cons.cons_count++;
+
+		//Broadcast Queue : Producer 가 새 Subscriber 를 볼 수 있도록 한 뒤에 시작 위치를 읽어야
+		//Subscriber 수(Reference Count)를 계산하는 Producer 와 시작 위치가 일치함 (rte_ring_bcast_count)
+		if(a_pstRing->flags & RING_F_BCAST)
+			rte_ring_bcast_join(a_pstRing, idx);
 	}
 
 	//UnLock to Ring
-	rte_ring_rw_unlock();
+	rte_ring_reg_unlock(a_pstRing);
 
 
 	return idx;
@@ -550,8 +944,8 @@ uint32_t CLQManager::InsertProdInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 	memset(szName, 0x00, sizeof(szName));
 	sprintf(szName, "%s_%d", a_szName, a_nInstanceID);
 
-	//Lock to Ring
-	rte_ring_rw_lock();
+	//Lock to Ring (Registration of this Ring only)
+	rte_ring_reg_lock(a_pstRing);
 	
 	for(i = 0 ; i < a_pstRing->prod.prod_count ; i++)	
 	{
@@ -574,6 +968,7 @@ uint32_t CLQManager::InsertProdInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 	{
 		if(a_pstRing->prod.prod_count >= RTE_RING_MAX_PROD_COUNT )
 		{
+			rte_ring_reg_unlock(a_pstRing);
 			SetErrorMsg("Producer is Full");
 			RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
 			return -E_Q_NOMEM;
@@ -587,7 +982,7 @@ uint32_t CLQManager::InsertProdInfo(char *a_szName, int a_nInstanceID, pid_t a_s
 	}
 
 	//UnLock to Ring
-	rte_ring_rw_unlock();
+	rte_ring_reg_unlock(a_pstRing);
 
 
 	return idx;
@@ -616,7 +1011,7 @@ char* CLQManager::GetQuery(const char *a_szFmt, ...)
  * \brief Generate Q Name
  * \param a_szWrite is Name of Write Process
  * \param a_szRead is Name of Read Process
- * \param a_cMultiType is Multi Queue Type (Read:'R', Write : 'W', else : NULL)
+ * \param a_cMultiType is Multi Queue Type (Read:'R', Write : 'W', Broadcast : 'B', else : NULL)
  * \return 
  *   - A Pointer of Q Name on Success
  *   - NULL on error
@@ -637,6 +1032,12 @@ char* CLQManager::GetQName(const char *a_szWrite, const char *a_szRead, char a_c
 					, DEF_STR_MULTI_PREFIX
 			);
 			break;
+		case DEF_MULTI_TYPE_BCAST :
+			sprintf(m_szBuffer, DEF_STR_FORMAT_Q_NAME
+					, a_szWrite
+					, DEF_STR_BCAST_SUFFIX
+			);
+			break;
 		default :
 			sprintf(m_szBuffer, DEF_STR_FORMAT_Q_NAME
 					, a_szWrite
@@ -661,7 +1062,9 @@ char* CLQManager::GetQName(const char *a_szWrite, const char *a_szRead, char a_c
  * \param a_szRead is Name of Read Process
  * \param a_nElemCnt is Count of Ring Elements
  * \param a_nType is Ring Type (Read:0/ Write:1)
- * \param a_cMultiType is Multi Queue Type (Read:'R', Write :'W', else : NULL)
+ * \param a_cMultiType is Multi Queue Type (Read:'R', Write :'W', Broadcast : 'B', else : NULL)
+ * \param a_unHighWm is High Watermark (Ring Size 대비 %, 0 : Ring 의 Watermark 를 변경하지 않음)
+ * \param a_unLowWm is Low Watermark (Ring Size 대비 %, 0 : High Watermark 의 절반)
  * \return 
  *   - 0 on Success
  *   - -E_Q_NO_CONFIG- function could not get pointer to rte_config structure
@@ -675,7 +1078,7 @@ char* CLQManager::GetQName(const char *a_szWrite, const char *a_szRead, char a_c
  *   - -E_Q_TRUN Backup File Truncate Error 
  *   - -E_Q_FLOCK Backup File Locking Error 
  */
-int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nElemCnt, int a_nType, char a_cMultiType)
+int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nElemCnt, int a_nType, char a_cMultiType, uint32_t a_unHighWm, uint32_t a_unLowWm)
 {
 	//result of Function
 	int ret = 0;
@@ -717,6 +1120,18 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 			//If Ring is NULL to Send Creating Request
 			if(pstRing != NULL)
 			{
+				//Broadcast Queue 는 Consumer Info 를 등록하기 전에 Flag 를 설정 (Subscriber 의 위치 초기화)
+				if(a_cMultiType == DEF_MULTI_TYPE_BCAST)
+					__sync_fetch_and_or(&(pstRing->flags), RING_F_BCAST);
+
+				//Queue Definition 의 Watermark 적용 (같은 Ring 을 Attach 하는 모든 Process 가 같은 값을 기록)
+				if(a_unHighWm > 0)
+				{
+					ret = SetRingWatermark(pstRing, a_unHighWm, a_unLowWm);
+					if(ret < 0)
+						return ret;
+				}
+
 				//Insert Consumers Info to Cons Ring
 				unRingIdx = InsertConsInfo(m_szProcName, m_nInstanceID, getpid(), pstRing);
 				if(unRingIdx < 0)
@@ -735,7 +1150,9 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 				//Ring 의 Consumer Head 위치를 Ring 에 기억 되어 있는Consumer 정보의 Head 값으로 강제 변경
 				//변경 하지 않을 경우 연관되어 있는 다른 Process 들의 무한 루프 발생
 				//(어쩔 수 없이 데이터의 유실이 발생할 수 있음)
+				//Broadcast Queue 는 Subscriber 별로 위치를 가지므로 복구하지 않음
 				if( 
+					!(pstRing->flags & RING_F_BCAST) &&
 					pstRing->cons.tail == pstRing->cons.cons_info[unRingIdx].tail
 				)
 				{
@@ -802,23 +1219,31 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 				if(bFind)
 				{
 					bFind = false;
-					
-					for(uint32_t j = 0; j < m_stReadRingInfo[i].vecRelProc.size() ; j++)
+
+					//Detach 된 Ring 을 다시 Attach 하는 경우 같은 Index 를 재사용
+					if(m_stReadRingInfo[i].pstRing == NULL)
 					{
-						if( strcmp(a_szWrite, m_stReadRingInfo[i].vecRelProc[j].c_str()) == 0 )
+						m_stReadRingInfo[i].nIdx = unRingIdx;
+						m_stReadRingInfo[i].unFailCnt = 0;
+						m_stReadRingInfo[i].unArrivalGap = 0;
+						SetRelProc(&m_stReadRingInfo[i], NULL);
+
+						if(m_bBackup)
 						{
-							bFind = true;
-							break;
+							ret = InitBackupFile( pstRing, pszQName, DEF_RING_TYPE_READ, unRingIdx);
+							if( ret < 0)
+							{
+								return ret;
+							}
 						}
-					}
 
-					//not found Process Name in Queue
-					//And Insert Process Name to Queue
-					if(bFind == false)
-					{
-						m_stReadRingInfo[i].vecRelProc.push_back(a_szWrite);
+						//Slot 을 모두 기록한 뒤에 Ring 을 공개 (Ring Table 을 읽는 Thread 는 Lock 을 잡지 않음)
+						rte_wmb();
+						m_stReadRingInfo[i].pstRing = pstRing;
 					}
 
+					AddRelProc(&m_stReadRingInfo[i], a_szWrite);
+
 				}
 				//Insert Queue Info
 				else
@@ -827,7 +1252,7 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 					m_stReadRingInfo[m_unReadRingCount].nIdx = unRingIdx;
 					sprintf(m_stReadRingInfo[m_unReadRingCount].szName,
 							"%s", pszQName);
-					m_stReadRingInfo[m_unReadRingCount].vecRelProc.push_back(a_szWrite);
+					AddRelProc(&m_stReadRingInfo[m_unReadRingCount], a_szWrite);
 
 					
 					if(m_bBackup)
@@ -838,6 +1263,8 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 							return ret;
 						}
 					}
+					//Slot 을 모두 기록한 뒤에 Ring Count 를 증가 (Ring Table 을 읽는 Thread 는 Lock 을 잡지 않음)
+					rte_wmb();
 					m_unReadRingCount++;
 
 				}
@@ -860,6 +1287,17 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 			//If Ring is NULL to Send Creating Request
 			if(pstRing != NULL)
 			{
+				if(a_cMultiType == DEF_MULTI_TYPE_BCAST)
+					__sync_fetch_and_or(&(pstRing->flags), RING_F_BCAST);
+
+				//Queue Definition 의 Watermark 적용 (같은 Ring 을 Attach 하는 모든 Process 가 같은 값을 기록)
+				if(a_unHighWm > 0)
+				{
+					ret = SetRingWatermark(pstRing, a_unHighWm, a_unLowWm);
+					if(ret < 0)
+						return ret;
+				}
+
 				//Insert Producer Info to Prod Ring
 				unRingIdx = InsertProdInfo(m_szProcName, m_nInstanceID, getpid(), pstRing);
 				if(unRingIdx < 0)
@@ -879,7 +1317,8 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 				//Ring 의 Producer Head 위치를 Ring 에 기억 되어 있는Producer 정보의 Tail 값으로 강제 변경
 				//변경 하지 않을 경우 연관되어 있는 다른 Process 들의 무한 루프 발생
 				//(어쩔 수 없이 데이터의 유실이 발생할 수 있음)
-				if(	pstRing->prod.tail == pstRing->prod.prod_info[unRingIdx].tail )
+				if(	!(pstRing->flags & RING_F_BCAST) &&
+					pstRing->prod.tail == pstRing->prod.prod_info[unRingIdx].tail )
 				{
 					for(uint32_t i = 0 ; i < pstRing->prod.prod_count; i++)
 					{
@@ -944,22 +1383,30 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 				{
 					bFind = false;
 
-					for(uint32_t j = 0; j < m_stWriteRingInfo[i].vecRelProc.size() ; j++)
+					//Detach 된 Ring 을 다시 Attach 하는 경우 같은 Index 를 재사용
+					if(m_stWriteRingInfo[i].pstRing == NULL)
 					{
-						if( strcmp(a_szRead, m_stWriteRingInfo[i].vecRelProc[j].c_str()) == 0 )
+						m_stWriteRingInfo[i].nIdx = unRingIdx;
+						m_stWriteRingInfo[i].unFailCnt = 0;
+						m_stWriteRingInfo[i].unArrivalGap = 0;
+						SetRelProc(&m_stWriteRingInfo[i], NULL);
+
+						if(m_bBackup)
 						{
-							bFind = true;
-							break;
+							ret = InitBackupFile( pstRing, pszQName, DEF_RING_TYPE_WRITE, unRingIdx);
+							if( ret < 0)
+							{
+								return ret;
+							}
 						}
-					}
 
-					//not found Process Name in Queue
-					//so, Insert Process Name to Queue
-					if(bFind == false)
-					{
-						m_stWriteRingInfo[i].vecRelProc.push_back(a_szRead);
+						//Slot 을 모두 기록한 뒤에 Ring 을 공개 (Ring Table 을 읽는 Thread 는 Lock 을 잡지 않음)
+						rte_wmb();
+						m_stWriteRingInfo[i].pstRing = pstRing;
 					}
 
+					AddRelProc(&m_stWriteRingInfo[i], a_szRead);
+
 				}
 				//Insert Queue Info
 				else
@@ -968,7 +1415,7 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 					m_stWriteRingInfo[m_unWriteRingCount].nIdx = unRingIdx;
 					sprintf(m_stWriteRingInfo[m_unWriteRingCount].szName,
 							"%s", pszQName);
-					m_stWriteRingInfo[m_unWriteRingCount].vecRelProc.push_back(a_szRead);
+					AddRelProc(&m_stWriteRingInfo[m_unWriteRingCount], a_szRead);
 
 					if(m_bBackup)
 					{
@@ -979,6 +1426,8 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 						}
 					}
 
+					//Slot 을 모두 기록한 뒤에 Ring Count 를 증가 (Ring Table 을 읽는 Thread 는 Lock 을 잡지 않음)
+					rte_wmb();
 					m_unWriteRingCount++;
 				}
 
@@ -993,6 +1442,147 @@ int CLQManager::AttachRing(const char *a_szWrite, const char *a_szRead, int a_nE
 	return -1;
 }
 
+/*!
+ * \brief Detach Ring
+ * \details Ring Table 에서 Ring 을 제거한다. Slot 의 Index 는 유지되므로 다른 Ring 의 Index 는 바뀌지 않는다.
+ * Slot 의 Ring 을 NULL 로 변경한 뒤 모든 Thread 가 이전 Epoch 을 벗어날 때까지(SyncEpoch) 기다린 후에
+ * Consumer/Producer Info 를 정리하고 Backup File 을 해제한다.
+ * 같은 Ring 에 다른 Relation Process 가 남아 있으면 Relation 만 제거한다.
+ * Topology Command 를 수신한 Thread(ReceiveCommand) 에서 호출되므로 CLQManager 의 Read/Write 함수와 같은 Thread 에서 사용한다.
+ * \param a_szWrite is Name of Write Process
+ * \param a_szRead is Name of Read Process
+ * \param a_nType is Ring Type (Read:0/ Write:1)
+ * \param a_cMultiType is Multi Queue Type (Read:'R', Write :'W', Broadcast : 'B', else : NULL)
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Q Name is NULL; Invalid Ring Type
+ *   - -E_Q_NOENT Ring is not Attached
+ */
+int CLQManager::DetachRing(const char *a_szWrite, const char *a_szRead, int a_nType, char a_cMultiType)
+{
+	int i = 0;
+	int nCount = 0;
+	RING_INFO *pstTable = NULL;
+	const char *pszRelProc = NULL;
+	struct rte_ring *pstRing = NULL;
+	struct rte_ring_cons_info *pstConsInfo = NULL;
+	struct rte_ring_prod_info *pstProdInfo = NULL;
+	uint32_t unEnd = 0;
+	uint32_t unWait = 0;
+
+	char *pszQName = GetQName(a_szWrite, a_szRead, a_cMultiType);
+	if(pszQName == NULL)
+	{
+		SetErrorMsg("Q Name is NULL");
+		RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	if(a_nType == DEF_RING_TYPE_READ)
+	{
+		pstTable = m_stReadRingInfo;
+		nCount = m_unReadRingCount;
+		pszRelProc = a_szWrite;
+	}
+	else if(a_nType == DEF_RING_TYPE_WRITE)
+	{
+		pstTable = m_stWriteRingInfo;
+		nCount = m_unWriteRingCount;
+		pszRelProc = a_szRead;
+	}
+	else
+	{
+		SetErrorMsg("Invalid Ring Type %d", a_nType);
+		RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	for(i = 0; i < nCount; i++)
+	{
+		if(pstTable[i].pstRing != NULL && strcmp(pszQName, pstTable[i].szName) == 0)
+			break;
+	}
+
+	if(i == nCount)
+	{
+		SetErrorMsg("Ring %s is not Attached", pszQName);
+		RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_NOENT;
+	}
+
+	//같은 Ring 을 사용하는 다른 Relation Process 가 남아 있음
+	if(DelRelProc(&pstTable[i], pszRelProc) > 0)
+		return 0;
+
+	pstRing = pstTable[i].pstRing;
+
+	//읽고 완료하지 않은 데이터를 먼저 완료
+	if(m_pstReadRing == pstRing && m_bReadComplete)
+		ReadComplete();
+
+	//Ring Table 에서 제거한 뒤 이전 Epoch 에 진입한 Thread 가 모두 벗어날 때까지 대기
+	pstTable[i].pstRing = NULL;
+	SyncEpoch();
+
+	//High Watermark Event 를 전달한 Write Ring 이면 Watermark 를 확인할 Ring 수에서 제외
+	if(__sync_bool_compare_and_swap(&pstTable[i].unWmOver, 1, 0))
+		__sync_fetch_and_sub(&m_unWmOverCnt, 1);
+
+	if(a_nType == DEF_RING_TYPE_READ)
+	{
+		pstConsInfo = &(pstRing->cons.cons_info[pstTable[i].nIdx]);
+
+		if(m_pstReadRing == pstRing)
+			m_pstReadRing = NULL;
+
+		//Producer 가 더 이상 RTS 를 보내지 않도록 Sleep 해제
+		SetConsSleep(pstRing, pstTable[i].nIdx, 0);
+
+		//Broadcast Queue : 새 데이터의 Reference Count 에서 제외한 뒤, 이미 Reference 가 계산된 데이터를 반환하고 탈퇴
+		if(pstRing->flags & RING_F_BCAST)
+		{
+			//leave_end 이전에 Reserve 한 Producer 는 이 Consumer 를 Reference 에 포함하므로 Publish 를 대기한 뒤 반환
+			unEnd = rte_ring_bcast_leave(pstRing, pstTable[i].nIdx);
+
+			for(uint32_t unPos = pstConsInfo->head; unPos != unEnd; unPos++)
+				rte_pktmbuf_free((struct rte_mbuf*)pstRing->ring[unPos & pstRing->prod.mask]);
+
+			pstConsInfo->head = unEnd;
+			pstConsInfo->tail = unEnd;
+			rte_wmb();
+			pstConsInfo->subscribed = RTE_RING_SUBS_LEFT;
+
+			rte_ring_bcast_retire(pstRing);
+		}
+
+		ReleaseBackup(&(pstConsInfo->backup_info));
+	}
+	else
+	{
+		pstProdInfo = &(pstRing->prod.prod_info[pstTable[i].nIdx]);
+
+		//Backup Writer Thread 가 Staging Ring 에 남은 데이터를 모두 처리할 때까지 대기 (기록에 실패한 데이터는 bk_failed 로 집계)
+		for(unWait = 0; m_bAsyncBackup && pstProdInfo->bk_written + pstProdInfo->bk_failed != pstProdInfo->bk_staged; unWait += DEF_BK_IDLE_USEC)
+		{
+			if(unWait >= DEF_BK_DETACH_WAIT_USEC)
+			{
+				SetErrorMsg("Ring %s Staged Backup Data is not Written (Staged %lu, Written %lu, Failed %lu)"
+							, pszQName, pstProdInfo->bk_staged, pstProdInfo->bk_written, pstProdInfo->bk_failed);
+				RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
+				break;
+			}
+
+			usleep(DEF_BK_IDLE_USEC);
+		}
+
+		ReleaseBackup(&(pstProdInfo->backup_info));
+	}
+
+	RTE_LOG (INFO, RING, "Ring %s Detached (Idx %d)\n", pszQName, i);
+
+	return 0;
+}
+
 /*!
  * \brief Create Ring 
  * \details 모든 Ring 의 이름은 [WriteProcess]_[ReadProcess] 형태로 구성
@@ -1058,17 +1648,27 @@ int CLQManager::CreateRing(char *a_szName, struct rte_ring **a_stRing, int a_nSi
  * SIGRTMIN+1 를 받는 다는 것은 해당하는 Queue 에서 Consumer Info 를 저장하는 배열의 
  * 자신의 Index 번호가 0이라는 뜻이다.
  * 즉, SIGRTMIN+1+[index] 번호이다.
+ * Futex Mode 일 경우 Signal 대신 Shared Memory 의 Futex Word 에서 대기한다. (ReadWaitFutex)
+ * Hybrid Mode 일 경우 Spin Budget 동안 Ring 을 Polling 한 후 Futex Word 에서 대기한다. (ReadWaitHybrid)
  * \return 
- *   - 0 on Recieved Signal 
+ *   - DEF_SIG_DATA on Recieved Data
+ *   - DEF_SIG_COMMAND on Recieved Command
  *   - -1 Timed out
  *   - -E_Q_NOMEM Ring Index Over
  */
 int CLQManager::ReadWait()
 {
 	int ret = 0;
+
+	if(m_nWaitMode == DEF_WAIT_MODE_HYBRID)
+		return ReadWaitHybrid();
+
+	if(m_pstFutex != NULL)
+		return ReadWaitFutex();
+
 	//Set to Timeout Sec
 	struct timespec tWait;
-	tWait.tv_sec = 1;
+	tWait.tv_sec = DEF_WAIT_TIMEOUT_SEC;
 	tWait.tv_nsec = 0;
 
 	//ReadRing Init
@@ -1104,7 +1704,16 @@ int CLQManager::ReadWait()
 				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
 				return -E_Q_NOMEM;
 			}
-			return DEF_SIG_DATA;
+
+			//Detach 된 Ring 의 Producer 가 보낸 RTS 는 무시
+			for(int i = 0; i < m_unReadRingCount; i++)
+			{
+				if(m_stReadRingInfo[i].pstRing == m_pstReadRing)
+					return DEF_SIG_DATA;
+			}
+
+			m_pstReadRing = NULL;
+			return -1;
 		}
 	}
 
@@ -1124,12 +1733,14 @@ int CLQManager::SetSleepFlag( struct rte_ring *a_pstRing )
 	if(a_pstRing == NULL)
 		return -1;
 
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
 	for(int i = 0; i < m_unReadRingCount ; i++)
 	{
 //		printf("m_stReadRingInfo %p, a_pstRing %p, idx %d \n", m_stReadRingInfo[i].pstRing, a_pstRing, m_stReadRingInfo[i].nIdx);
 		if(m_stReadRingInfo[i].pstRing == a_pstRing)
 		{
-			a_pstRing->cons.cons_info[m_stReadRingInfo[i].nIdx].sleep = 1;
+			SetConsSleep(a_pstRing, m_stReadRingInfo[i].nIdx, 1);
 			break;
 		}
 	}
@@ -1138,1406 +1749,3426 @@ int CLQManager::SetSleepFlag( struct rte_ring *a_pstRing )
 }
 
 /*!
- * \brief Read a Data From a Ring
- * \details Queue 로 부터 한개의 데이터를 읽어들여 입력된 포인터에 데이터의 주소값을 대입
- * \param  a_pszBuff is Buffer Pointer to Store Data
- * \return 
- *   - size of data on Success
- *   - -E_Q_INVAL ring pointer invalid 
- *   - -E_Q_NOENT Not enough entries in the ring to dequeue; no object is dequeued.
- *   - -E_Q_NOMEM out of Memory
+ * \brief Set or Clear Sleep Status and Sleep Mask of a Consumer
+ * \details Sleep 설정 시에는 Sleep Flag 이후에 Mask 를 설정하고, 해제 시에는 Sleep Flag 이후에 Mask 를 해제한다.
+ * Producer 는 Mask 를 보고 Consumer 를 선택한 뒤 Sleep Flag 를 CAS 로 획득하므로
+ * Mask 가 설정되어 있는 한 Sleep 상태의 Consumer 가 RTS 를 받지 못하는 경우는 없다.
+ * \param a_pstRing is Ring Pointer
+ * \param a_nIdx is Index of Consumer Info Array in the ring
+ * \param a_unSleep is Sleep Status (1 : Sleep, 0 : Awake)
+ * \return None
  */
-int CLQManager::ReadData( char **a_pszBuff )
+void CLQManager::SetConsSleep(struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSleep)
 {
-	//Result
-	int ret = 0;
-	int nSegs = 0;
-	char *p = m_szJumboBuff;
-	struct rte_mbuf *pMbuf = NULL;
+	a_pstRing->cons.cons_info[a_nIdx].sleep = a_unSleep;
 
-	if(m_pstReadRing == NULL)
-	{
-		SetErrorMsg("m_pstReadRing is NULL");
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
-		return -E_Q_INVAL;
-	}
+	if(a_unSleep)
+		__sync_fetch_and_or(&(a_pstRing->cons.sleep_mask), (1ULL << a_nIdx));
+	else
+		__sync_fetch_and_and(&(a_pstRing->cons.sleep_mask), ~(1ULL << a_nIdx));
+}
 
-	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, 1, RTE_RING_QUEUE_FIXED, m_unReadIdx);
+/*!
+ * \brief Init Wait Mode
+ * \details Attach 된 모든 Read Ring 과 Command Ring 의 Consumer Info 에 Wakeup Mode 를 기입한다.
+ * Futex Mode 일 경우 첫번째 Read Ring(없을 경우 Command Ring) 의 Consumer Info 에 있는
+ * Futex Word 를 프로세스의 대기 Word 로 사용하며, 모든 Ring 의 Consumer Info 에 그 주소를 기입하여
+ * 어느 Ring 의 Producer 라도 같은 Word 로 Consumer 를 깨울 수 있도록 한다.
+ * Hybrid Mode 는 Producer 입장에서 Futex Mode 와 동일하므로 Consumer Info 에는 Futex Mode 로 기입한다.
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL There is no Ring to wait
+ */
+int CLQManager::InitWaitMode()
+{
+	struct rte_ring_cons_info *pstConsInfo = NULL;
+	int nConsWaitMode = m_nWaitMode;
 
-	if(unlikely(ret != 0))
+	if(m_nWaitMode == DEF_WAIT_MODE_HYBRID)
 	{
-		return ret;
+		nConsWaitMode = DEF_WAIT_MODE_FUTEX;
+		SetSpinBudget(m_unSpinMaxUsec);
 	}
 
-	m_pstCurMbuf = pMbuf = m_pstReadMbuf[0];
-
-	//데이터의 크기가 Memory Buffer 한개의 사이즈를 초과한 경우에
-	//여러개의 Memory Buffer 가 Linked list 형태로 연결 되어 있기 때문에
-	//하나의 Memory Buffer 에 넣어서 포인터만 넘겨 줌
-	if(unlikely(pMbuf->nb_segs > 1))
+	if(nConsWaitMode == DEF_WAIT_MODE_FUTEX)
 	{
-		nSegs = pMbuf->nb_segs;
-		if( rte_pktmbuf_pkt_len(pMbuf) > DEF_MEM_JUMBO )
+		if(m_unReadRingCount > 0)
 		{
-			SetErrorMsg("Over Jumbo Memory Buffer Size %d, data_size : %d"
-								, DEF_MEM_JUMBO, rte_pktmbuf_pkt_len(pMbuf));
-
-			RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
-			rte_pktmbuf_free(pMbuf);
-			return -E_Q_NOMEM;
+			m_pstFutex = &(m_stReadRingInfo[0].pstRing->cons.cons_info[m_stReadRingInfo[0].nIdx].futex);
 		}
-
-		for(int i = 0; i < nSegs ; i++)
+		else if(m_pstCmdRcvRing != NULL)
 		{
-			if(pMbuf)
-			{
-				memcpy(p, rte_pktmbuf_mtod(pMbuf, char *), rte_pktmbuf_data_len(pMbuf)); 
-				p += rte_pktmbuf_data_len(pMbuf);
-				pMbuf = pMbuf->next;
-			}
-			else
-			{
-				break;
-			}
+			m_pstFutex = &(m_pstCmdRcvRing->cons.cons_info[m_unCmdRcvIdx].futex);
+		}
+		else
+		{
+			SetErrorMsg("There is no Ring to Wait (Futex Mode)");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			return -E_Q_INVAL;
 		}
+	}
 
-		*a_pszBuff = m_szJumboBuff;
+	for(int i = 0; i < m_unReadRingCount; i++)
+	{
+		if(m_stReadRingInfo[i].pstRing == NULL)
+			continue;
+
+		pstConsInfo = &(m_stReadRingInfo[i].pstRing->cons.cons_info[m_stReadRingInfo[i].nIdx]);
+		pstConsInfo->futex_ptr = m_pstFutex;
+		//Producer 는 wait_mode 를 확인 후 futex_ptr 를 사용하므로 Store 순서 보장
+		rte_wmb();
+		pstConsInfo->wait_mode = nConsWaitMode;
 	}
-	else
+
+	if(m_pstCmdRcvRing != NULL)
 	{
-		*a_pszBuff = rte_pktmbuf_mtod( pMbuf, char * );
+		pstConsInfo = &(m_pstCmdRcvRing->cons.cons_info[m_unCmdRcvIdx]);
+		pstConsInfo->futex_ptr = m_pstFutex;
+		rte_wmb();
+		pstConsInfo->wait_mode = nConsWaitMode;
 	}
 
-	m_bReadComplete = true;
-	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+	return 0;
 }
 
 /*!
- * \brief Read several Data from a ring
- * \details Queue 로 부터 여러개의 데이터를 읽어들인다.(Bulk Mode 에서만 사용)
- * 읽어들인 데이터는 GetNext() 함수로만 데이터를 전달 받을 수 있다.
- * \param a_nCount is count of element 
+ * \brief Wait Data on Futex Word (Futex Mode)
+ * \details Sleep Flag 를 설정하기 전에 Futex Word 의 값을 읽어두고
+ * Sleep Flag 설정 후 Ring 을 다시 확인한 뒤 FUTEX_WAIT 로 대기한다.
+ * 그 사이에 Producer 가 Futex Word 를 증가시키면 FUTEX_WAIT 는 즉시 Return 하므로
+ * Sleep Flag 와 Wakeup 사이의 유실 구간이 없다.
  * \return 
- *   - 0 on Success
- *   - -E_Q_INVAL bulk Count > Max Bulk Count; ring pointer invalid 
- *   - -E_Q_NOENT Not enough entries in the ring to dequeue; no object is dequeued.
- *   - -E_Q_NOMEM out of Memory
- *         Fail : -1
+ *   - DEF_SIG_DATA on Recieved Data (m_pstReadRing, m_unReadIdx 설정)
+ *   - DEF_SIG_COMMAND on Recieved Command
+ *   - -1 Timed out
  */
-int CLQManager::ReadBulkData( int a_nCount )
+int CLQManager::ReadWaitFutex()
 {
-	//Result
 	int ret = 0;
-	int nCount = a_nCount;
-
-	if(unlikely(nCount > DEF_MAX_BULK))
-	{
-		SetErrorMsg("Bulk Count Over > %d", DEF_MAX_BULK);
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
-		return -E_Q_INVAL;
-	}
+	int32_t nSeq = 0;
+	//Set to Timeout Sec
+	struct timespec tWait;
+	tWait.tv_sec = DEF_WAIT_TIMEOUT_SEC;
+	tWait.tv_nsec = 0;
 
-	if(unlikely(m_pstReadRing == NULL))
-	{
-		SetErrorMsg("m_pstReadRing is NULL");
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
-		return -E_Q_INVAL;
-	}
+	nSeq = rte_atomic32_read(m_pstFutex);
 
+	SetAllSleepFlag(1);
+	//Sleep Flag 의 Store 이후에 Ring 의 prod.tail 을 Load 하도록 보장
+	rte_mb();
 
-	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, nCount, RTE_RING_QUEUE_FIXED, m_unReadIdx);
-	
-	if(unlikely(ret != 0))
+	ret = FindReadyRing();
+	if(ret < 0)
 	{
-		m_unTotReadMbufIdx = 0;
-		m_unCurReadMbufIdx = 0;
-//		SetSleepFlag(m_pstReadRing);
-		return ret;
+		FutexWait(m_pstFutex, nSeq, &tWait);
+		ret = FindReadyRing();
 	}
 
-	m_unTotReadMbufIdx = nCount;
-	m_unCurReadMbufIdx = 0;
-	return 0;
-}
+	//깨어 있는 동안 Producer 가 불필요한 System Call 을 하지 않도록 Sleep Flag 해제
+	SetAllSleepFlag(0);
 
+	return ret;
+}
 
 /*!
- * \brief Get Next Data From m_pstMbuf
- * \details Bulk Mode 로 동작할 때 ReadBulkData 함수 호출 이후
- *          GetNext() 함수를 이용하여서 데이터를 하나씩 Read
- * \param  a_pszBuff is Buffer Pointer to Store Data
+ * \brief Spin and Wait Data on Futex Word (Hybrid Mode)
+ * \details Spin Budget 동안 rte_pause 로 Ring 을 Polling 하고, 그 안에 데이터가 없을 경우
+ * ReadWaitFutex 로 대기한다. 데이터 도착까지 걸린 시간은 Ring 별 Arrival Gap 에 반영되어
+ * 다음 Spin Budget 을 결정한다. (도착 간격이 Max Budget 보다 길면 Spin 없이 바로 대기)
  * \return 
- *   - Size of Data on Success
- *   - -E_Q_INVAL Read buffer Index Over;
- *   - -E_Q_NOMEM out of Memory;
+ *   - DEF_SIG_DATA on Recieved Data (m_pstReadRing, m_unReadIdx 설정)
+ *   - DEF_SIG_COMMAND on Recieved Command
+ *   - -1 Timed out
  */
-int CLQManager::GetNext(char **a_pszBuff)
+int CLQManager::ReadWaitHybrid()
 {
-	char *p = m_szJumboBuff;
-	struct rte_mbuf *pMbuf = NULL;
-	int nSegs = 0;
+	int ret = -1;
+	uint64_t unStart = rte_rdtsc();
+	uint64_t unBudget = GetSpinBudget();
 
-	if(unlikely(m_unCurReadMbufIdx >= m_unTotReadMbufIdx))
-		return -E_Q_INVAL;
+	do
+	{
+		ret = FindReadyRing();
+		if(ret >= 0)
+			break;
 
-	m_pstCurMbuf = pMbuf = m_pstReadMbuf[m_unCurReadMbufIdx++];
-//	RTE_LOG(ERR, MBUF, "pMbuf %p, m_pstCurMbuf, %p\n", pMbuf, m_pstCurMbuf);
+		rte_pause();
+	} while(rte_rdtsc() - unStart < unBudget);
 
-	//데이터의 크기가 Memory Buffer 한개의 사이즈를 초과한 경우에
-	//여러개의 Memory Buffer 가 Linked list 형태로 연결 되어 있기 때문에
-	//하나의 Memory Buffer 에 넣어서 포인터만 넘겨 줌
-	if(unlikely(pMbuf->nb_segs > 1))
-	{
-		nSegs = pMbuf->nb_segs;
-			
-		if( rte_pktmbuf_pkt_len(pMbuf) > DEF_MEM_JUMBO )
-		{
-			SetErrorMsg("Over Jumbo Memory Buffer Size %d, data_size : %d", DEF_MEM_JUMBO, rte_pktmbuf_pkt_len(pMbuf));
-			RTE_LOG(ERR, MBUF, "%s\n"
-								, GetErrorMsg());
-			rte_pktmbuf_free(pMbuf);
-			return -E_Q_NOMEM;
-		}
-	
-		for(int i = 0; i < nSegs; i++)
-		{
-			if(pMbuf)
-			{
-				memcpy(p, rte_pktmbuf_mtod(pMbuf, char *), rte_pktmbuf_data_len(pMbuf)); 
-				p += rte_pktmbuf_data_len(pMbuf);
-				pMbuf = pMbuf->next;
-			}
-			else
-			{
-				break;
-			}
-		}
+	if(ret < 0)
+		ret = ReadWaitFutex();
 
-		*a_pszBuff = m_szJumboBuff;
-	}
-	else
+	if(ret == DEF_SIG_DATA)
 	{
-		*a_pszBuff = rte_pktmbuf_mtod( pMbuf, char * );
+		UpdateArrivalGap((m_unWaitRingIdx - 1) % m_unReadRingCount, rte_rdtsc() - unStart);
 	}
-
-	if(unlikely(m_unCurReadMbufIdx == m_unTotReadMbufIdx))
+	else if(ret < 0)
 	{
-		m_bReadComplete = true;
+		//Timeout 동안 데이터가 없는 Ring 은 Spin 하지 않도록 모든 Ring 에 반영
+		for(int i = 0; i < m_unReadRingCount; i++)
+			UpdateArrivalGap(i, rte_rdtsc() - unStart);
 	}
 
-	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+	return ret;
 }
 
 /*!
- * \brief Read Complete
- * \details 데이터 처리 완료 후 호출 된다.
- *          1. 현재 읽고 있는 Ring 의 Consumer Position 을 변경한다.
- *          2. 현재 읽고 있는 Memory Buffer 를 Memory Pool 로 돌려 준다.
- * \param None
- * \return 
- *   - 0 on Success
- *   - -E_Q_MSYNC msync function error
+ * \brief Get Spin Budget From Arrival Gap of Read Rings (Hybrid Mode)
+ * \details 가장 짧은 Arrival Gap 의 2배를 Spin Budget 으로 사용하며,
+ * 그 값이 Max Budget 을 넘으면 Spin 하지 않는다. (Arrival Gap 을 모를 경우 Max Budget)
+ * \return Spin Budget (TSC Cycles)
  */
-int CLQManager::ReadComplete()
+uint64_t CLQManager::GetSpinBudget()
 {
-	int ret = 0;
+	uint64_t unGap = 0;
 
-	if(likely(m_bReadComplete))
+	for(int i = 0; i < m_unReadRingCount; i++)
 	{
-		rte_ring_read_complete(m_pstReadRing
-							, m_pstReadRing->cons.cons_info[m_unReadIdx].tail
-							, m_pstReadRing->cons.cons_info[m_unReadIdx].head
-							);
-		//Read Complete 함수 호출 뒤에 consumer Info 의 Tail 값을 Head 값으로 변경
-		m_pstReadRing->cons.cons_info[m_unReadIdx].tail = m_pstReadRing->cons.cons_info[m_unReadIdx].head;
-		m_bReadComplete = false;
+		if(m_stReadRingInfo[i].pstRing == NULL)
+			continue;
 
-		if(m_bBackup)
-		{
-			ret = BackupReadData(m_pstReadRing, m_unReadIdx) ;
-			if(ret < 0)
-			{
-				SetErrorMsg("Backup Read Data Failed");
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				return ret;
-			}
-		}
+		if(m_stReadRingInfo[i].unArrivalGap == 0)
+			return m_unSpinMaxCycles;
 
+		if(unGap == 0 || m_stReadRingInfo[i].unArrivalGap < unGap)
+			unGap = m_stReadRingInfo[i].unArrivalGap;
 	}
 
+	if(unGap == 0)
+		return m_unSpinMaxCycles;
+
+	if(unGap * 2 <= m_unSpinMaxCycles)
+		return unGap * 2;
+
 	return 0;
 }
 
 /*!
- * \brief Free Read Data
- * \details 처리가 완전히 완료된 Memory Buffer 를해제한다.
- * \param None
+ * \brief Update Arrival Gap of Read Ring (Hybrid Mode)
+ * \details 이동 평균 (1/8 가중치) 으로 Arrival Gap 을 갱신한다.
+ * \param a_nIdx is Index of m_stReadRingInfo
+ * \param a_unGap is Wait Cycles until Data Arrival
  * \return None
  */
-void CLQManager::FreeReadData()
+void CLQManager::UpdateArrivalGap(int a_nIdx, uint64_t a_unGap)
 {
-	rte_pktmbuf_free(m_pstCurMbuf);
+	uint64_t unAvg = m_stReadRingInfo[a_nIdx].unArrivalGap;
+
+	if(unAvg == 0)
+		m_stReadRingInfo[a_nIdx].unArrivalGap = a_unGap + 1;
+	else
+		m_stReadRingInfo[a_nIdx].unArrivalGap = unAvg - (unAvg >> 3) + (a_unGap >> 3) + 1;
 }
 
 /*!
- * \brief Free Read Bulk Data
- * \details 처리가 완전히 완료된 Memory Buffer 를 해제한다(Bulk Mode)
- * \param None
+ * \brief Set Max Spin Budget of Hybrid Wait Mode
+ * \details Initialize 이전에 호출할 경우 TSC Hz 가 유효하지 않으므로 Initialize 시에 다시 변환된다.
+ * \param a_unMaxUsec is Max Spin Budget (usec, 0 : Spin 하지 않음)
  * \return None
  */
-void CLQManager::FreeReadBulkData()
+void CLQManager::SetSpinBudget(uint32_t a_unMaxUsec)
 {
-	for(int i = 0; i < m_unTotReadMbufIdx ; i++)
-	{
-		rte_pktmbuf_free(m_pstReadMbuf[i]);
-	}
+	m_unSpinMaxUsec = a_unMaxUsec;
+	m_unSpinMaxCycles = (uint64_t)a_unMaxUsec * rte_get_tsc_hz() / 1000000;
 }
 
 /*!
- * \brief Insert Data To m_pstWriteMbuf
- * \details 만약 현재 읽은 Memory Buffer 를 그대로 다음 Queue 에 전달하고 싶을 때 사용
- * \param None
+ * \brief Set Watermark Event Function and Throttling of Write Rings
+ * \details Queue Definition 의 HIGH_WM / LOW_WM 이 설정된 Write Ring 에서 Event 가 발생하면 a_pFunc 를 호출한다.
+ * Event 는 Write Path(CLQHandle 포함)에서 호출되므로 a_pFunc 는 Thread Safe 해야 하며 대기하지 않아야 한다.
+ * a_unThrottleUsec 가 0 보다 크면 High Watermark 를 넘은 Write Ring 에 입력할 때마다 그 시간만큼 대기한다.
+ * \param a_pFunc is Watermark Event Function (NULL : Event 미사용)
+ * \param a_pArgs is Arguments of Watermark Event Function
+ * \param a_unThrottleUsec is Throttling Time (usec, 0 : Throttling 미사용)
+ * \return None
+ */
+void CLQManager::SetWatermarkFunc(p_function_watermark *a_pFunc, void *a_pArgs, uint32_t a_unThrottleUsec)
+{
+	m_pWmArgs = a_pArgs;
+	m_unWmThrottleUsec = a_unThrottleUsec;
+	rte_wmb();
+	m_pfuncWatermark = a_pFunc;
+}
+
+/*!
+ * \brief Start Group Commit of Backup Files
+ * \details Backup 시 매번 msync 하지 않고 Dirty Range 만 기록하며, Background Thread 가
+ * a_unUsec 마다 혹은 한 Backup File 에 a_unMsgCnt 개의 데이터가 쌓이면 Dirty Range 를 msync 한다.
+ * 이미 실행 중일 경우 Count 와 Interval 만 변경한다.
+ * \param a_unMsgCnt is Count of Unsynced Data to msync at once
+ * \param a_unUsec is Interval of Group Commit (usec)
  * \return 
  *   - 0 on Success
- *   - -E_Q_NOMEM out of memory
+ *   - -E_Q_INVAL Backup Mode 가 아님; Invalid Count or Interval
+ *   - -E_Q_AGAIN Thread Create Failed
  */
-int CLQManager::InsertData()
+int CLQManager::SetGroupCommit(uint32_t a_unMsgCnt, uint32_t a_unUsec)
 {
-	if( unlikely( (m_unCurWriteMbufIdx + m_pstCurMbuf->nb_segs) >= (DEF_MEM_BUF_1024)) )
-		return -E_Q_NOMEM;
+	int ret = 0;
 
-	for(int i = 0; i < m_pstCurMbuf->nb_segs ; i++)
+	if(m_bBackup == false)
 	{
-		m_pstWriteMbuf[m_unCurWriteMbufIdx++] = m_pstCurMbuf;
-		m_pstCurMbuf = m_pstCurMbuf->next;
+		SetErrorMsg("Group Commit needs Backup Mode");
+		return -E_Q_INVAL;
+	}
 
-		if( NULL == m_pstCurMbuf )
-			break;
+	if(a_unMsgCnt == 0 || a_unUsec == 0)
+	{
+		SetErrorMsg("Invalid Group Commit Count %u, Interval %u", a_unMsgCnt, a_unUsec);
+		return -E_Q_INVAL;
 	}
 
+	pthread_mutex_lock(&m_stSyncLock);
+	m_unSyncMsgCnt = a_unMsgCnt;
+	m_unSyncUsec = a_unUsec;
+	pthread_mutex_unlock(&m_stSyncLock);
+
+	if(m_bGroupCommit)
+		return 0;
+
+	//Group Commit Thread 도 Ring Table 을 읽으므로 Epoch Slot 을 할당
+	m_nSyncEpochSlot = RegisterEpoch();
+	if(m_nSyncEpochSlot < 0)
+	{
+		SetErrorMsg("There is no Epoch Slot for Group Commit Thread");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return m_nSyncEpochSlot;
+	}
+
+	m_bSyncRun = true;
+	ret = pthread_create(&m_stSyncThread, NULL, SyncThread, this);
+	if(ret != 0)
+	{
+		m_bSyncRun = false;
+		UnregisterEpoch(m_nSyncEpochSlot);
+		m_nSyncEpochSlot = -1;
+		SetErrorMsg("Group Commit Thread Create Failed %d", ret);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_AGAIN;
+	}
+
+	m_bGroupCommit = true;
+
 	return 0;
-	
 }
 
 /*!
- * \brief Insert Data To m_pstWriteMbuf
- * \details Bulk Mode 에서 여러개의 Data 를 Buffer 에 넣기 위해서 사용
- * \param a_pszData is Data Pointer to Insert 
- * \param a_nSize is Size of Data
+ * \brief Start Async Backup
+ * \details Backup 을 Write 함수 안에서 기록하지 않고, Enqueue 한 Memory Buffer 의 Reference 를
+ * Process 내부 Staging Ring 으로 Backup Writer Thread 에 전달하여 Batch 로 기록한다.
+ * Staging Ring 이 가득 차면 Producer 는 Backup Writer Thread 가 기록할 때까지 대기한다. (Backpressure)
+ * Backup Writer Thread 가 기록하지 않은 데이터 수는 Producer 별 bk_staged - bk_written - bk_failed 로 확인할 수 있다.
+ * \param a_unStageCnt is Size of Staging Ring (Power of 2)
  * \return 
  *   - 0 on Success
- *   - -E_Q_NOSPC there is no space for alloc;
- *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_INVAL Backup Mode 가 아님; Invalid Size
+ *   - -E_Q_NOMEM Memory Allocation Failed
+ *   - -E_Q_AGAIN Thread Create Failed
  */
-int CLQManager::InsertData( char *a_pszData, int a_nSize )
+int CLQManager::SetAsyncBackup(uint32_t a_unStageCnt)
 {
-	int nSegCnt = 0;
-	int nLastLen = 0;
-	uint16_t unBuffLen = 0;
-	char *pCur = a_pszData;
-	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL, *pTmpMbuf = NULL;
+	int ret = 0;
+	ssize_t nSize = 0;
+	void *pRing = NULL;
+	void *pFree = NULL;
 
-	if(unlikely(m_unCurWriteMbufIdx >= DEF_MEM_BUF_1024))
-		return -1;
-	
-	if(unlikely(a_nSize > DEF_MEM_BUF_1M))
+	if(m_bBackup == false)
 	{
-		SetErrorMsg("Data Length Over 1M , [Size:%d]", a_nSize);
-		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
-		return -E_Q_NOMEM;
+		SetErrorMsg("Async Backup needs Backup Mode");
+		return -E_Q_INVAL;
 	}
 
-	pHeadMbuf = rte_pktmbuf_alloc(m_pstDataMemPool);
-	if(unlikely(pHeadMbuf == NULL))
+	if(m_bAsyncBackup)
+		return 0;
+
+	//한 번에 Enqueue 하는 Memory Buffer (최대 DEF_MEM_BUF_1024) 가 모두 들어갈 수 있어야 한다
+	nSize = rte_ring_get_memsize(a_unStageCnt);
+	if(nSize < 0 || a_unStageCnt <= DEF_MEM_BUF_1024)
 	{
-//		RTE_LOG(ERR, MBUF, "Mbuf Alloc Failed\n");
-		return -E_Q_NOSPC;
+		SetErrorMsg("Invalid Async Backup Stage Count %u", a_unStageCnt);
+		return -E_Q_INVAL;
 	}
 
-	unBuffLen = RTE_MBUF_DATA_SIZE;
-	if(likely(a_nSize <= unBuffLen))
+	//Staging Ring 과 사용하지 않는 Stage 의 Ring, Stage Array (Staging Ring 에 모두 들어가는 크기)
+	m_pstStage = (BACKUP_STAGE*)malloc(sizeof(BACKUP_STAGE) * (a_unStageCnt - 1));
+	if(m_pstStage == NULL ||
+		posix_memalign(&pRing, RTE_CACHE_LINE_SIZE, nSize) != 0 ||
+		posix_memalign(&pFree, RTE_CACHE_LINE_SIZE, nSize) != 0)
 	{
-		pHeadMbuf->data_len = a_nSize;
-		pHeadMbuf->nb_segs = 1;
-		pHeadMbuf->pkt_len = a_nSize;
-
-		memcpy( rte_pktmbuf_mtod(pHeadMbuf, char*), a_pszData, a_nSize);
+		free(pRing);
+		free(m_pstStage);
+		m_pstStage = NULL;
+		SetErrorMsg("Async Backup Stage Ring Alloc Failed Size %ld", (long)nSize);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_NOMEM;
 	}
-	//만약 데이터의 Size 가 Memory Buffer 의 Size 를 초과한 경우
-	//여러개의 Memory Buffer 를 Linked list 형태로 연결
-	else
-	{
-		nSegCnt = a_nSize / unBuffLen;
-		nLastLen = a_nSize - (unBuffLen * nSegCnt);
-		if(nLastLen == 0)
-		{
-			nLastLen = unBuffLen;
-		}
-		else
-		{
-			nSegCnt++;
-		}
-
-		for(int i = 1; i <= nSegCnt ; i++)
-		{
-			if(pTmpMbuf != NULL)
-			{
-				pMbuf = rte_pktmbuf_alloc(m_pstDataMemPool);
-				if(pMbuf == NULL)
-				{
-					rte_pktmbuf_free(pHeadMbuf);
-					SetErrorMsg("Mbuf Alloc Failed");
-					RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
-					return -E_Q_NOSPC;
-				}
 
-				pTmpMbuf->next = pMbuf;
-			}
-			else
-			{
-				pMbuf = pHeadMbuf;
-			}
+	m_pstStageRing = (struct rte_ring*)pRing;
+	rte_ring_init(m_pstStageRing, "BACKUP_STAGE", a_unStageCnt, RING_F_SC_DEQ);
 
-			if( i < nSegCnt )
-			{
-				pMbuf->data_len = unBuffLen;
-			}
-			else
-			{
-				pMbuf->data_len = nLastLen;
-			}
+	m_pstStageFree = (struct rte_ring*)pFree;
+	rte_ring_init(m_pstStageFree, "BACKUP_STAGE_FREE", a_unStageCnt, RING_F_SP_ENQ);
+	for(uint32_t i = 0; i < a_unStageCnt - 1; i++)
+		rte_ring_sp_enqueue(m_pstStageFree, &m_pstStage[i]);
 
-			pMbuf->nb_segs = nSegCnt;
-			pMbuf->pkt_len = a_nSize;
-			memcpy( rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+	m_nAsyncBackupErr = 0;
+	m_bAsyncRun = true;
+	ret = pthread_create(&m_stAsyncThread, NULL, AsyncBackupThread, this);
+	if(ret != 0)
+	{
+		m_bAsyncRun = false;
+		free(m_pstStageRing);
+		m_pstStageRing = NULL;
+		free(m_pstStageFree);
+		m_pstStageFree = NULL;
+		free(m_pstStage);
+		m_pstStage = NULL;
+		SetErrorMsg("Async Backup Thread Create Failed %d", ret);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_AGAIN;
+	}
 
-			pCur += pMbuf->data_len;
-			pTmpMbuf = pMbuf;
+	m_bAsyncBackup = true;
 
-		}
+	return 0;
+}
 
+/*!
+ * \brief Set Ack Interval to msync Consumer Checkpoint File
+ * \details Consumer 는 ReadComplete 시 Checkpoint File 의 Cursor 만 변경하고, a_unAckCnt 번 마다 msync 한다.
+ * Group Commit Mode 에서는 Ack Interval 과 관계없이 Group Commit Thread 가 주기적으로 msync 한다.
+ * \param a_unAckCnt is Count of ReadComplete to msync at once
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Count
+ */
+int CLQManager::SetCheckpointInterval(uint32_t a_unAckCnt)
+{
+	if(a_unAckCnt == 0)
+	{
+		SetErrorMsg("Invalid Checkpoint Ack Interval %u", a_unAckCnt);
+		return -E_Q_INVAL;
 	}
 
-	m_pstWriteMbuf[m_unCurWriteMbufIdx++] = pHeadMbuf;
+	m_unCkptAckCnt = a_unAckCnt;
+
 	return 0;
 }
 
 /*!
- * \brief Insert Command Data To m_pstWriteMbuf
- * \details m_pstCmdPool 에서 Memory Buffer 를 가져와서 Command Data 를 입력
- * \param a_pszData is Data Pointer to Insert 
- * \param a_nSize is Size of Data
+ * \brief Find Ring which has Data (Futex Mode)
+ * \details Command Ring 을 먼저 확인하고, Read Ring 은 Round Robin 으로 확인한다.
  * \return 
- *   - 0 on Success
- *   - -E_Q_NOSPC there is no space for alloc;
- *   - -E_Q_NOMEM out of memory;
+ *   - DEF_SIG_DATA Read Ring has Data (m_pstReadRing, m_unReadIdx 설정)
+ *   - DEF_SIG_COMMAND Command Ring has Data
+ *   - -1 There is no Data
  */
-int CLQManager::InsertCommandData( char *a_pszData, int a_nSize )
+int CLQManager::FindReadyRing()
 {
-	int nSegCnt = 0;
-	int nLastLen = 0;
-	uint16_t unBuffLen = 0;
-	char *pCur = a_pszData;
-	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL, *pTmpMbuf = NULL;
+	int nIdx = 0;
+	struct rte_ring *pstRing = NULL;
 
-	if(m_unCurWriteMbufIdx >= DEF_MEM_BUF_1024)
-		return -1;
-	
-	if(a_nSize > DEF_MEM_BUF_1M)
+	if(m_pstCmdRcvRing != NULL && m_pstCmdRcvRing->prod.tail != m_pstCmdRcvRing->cons.head)
 	{
-		SetErrorMsg("Data Length Over 1M , [Size:%d]", a_nSize);
-		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
-		return -E_Q_NOMEM;
+		m_pstReadRing = m_pstCmdRcvRing;
+		return DEF_SIG_COMMAND;
 	}
 
-	pHeadMbuf = rte_pktmbuf_alloc(m_pstCmdMemPool);
-	if(pHeadMbuf == NULL)
-	{
-//		RTE_LOG(ERR, MBUF, "Mbuf Alloc Failed\n");
-		return -E_Q_NOSPC;
-	}
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
 
-	unBuffLen = RTE_MBUF_DATA_SIZE;
-	if(likely(a_nSize <= unBuffLen))
+	for(int i = 0; i < m_unReadRingCount; i++)
 	{
+		nIdx = (m_unWaitRingIdx + i) % m_unReadRingCount;
+		pstRing = m_stReadRingInfo[nIdx].pstRing;
 
-		pHeadMbuf->data_len = a_nSize;
-		pHeadMbuf->nb_segs = 1;
-		pHeadMbuf->pkt_len = a_nSize;
+		//Detach 된 Ring
+		if(pstRing == NULL)
+			continue;
 
-		memcpy( rte_pktmbuf_mtod(pHeadMbuf, char*), a_pszData, a_nSize);
-	}
-	//만약 데이터의 Size 가 Memory Buffer 의 Size 를 초과한 경우
-	//여러개의 Memory Buffer 를 Linked list 형태로 연결
-	else
-	{
-		nSegCnt = (a_nSize / unBuffLen);
-		nLastLen = a_nSize - (unBuffLen * nSegCnt);
-		if(nLastLen == 0)
+		//Broadcast Queue 는 Subscriber 자신의 위치로 확인
+		if( (pstRing->flags & RING_F_BCAST) ?
+				pstRing->prod.tail != pstRing->cons.cons_info[m_stReadRingInfo[nIdx].nIdx].head :
+				pstRing->prod.tail != pstRing->cons.head )
 		{
-			nLastLen = unBuffLen;
-		}
-		else
-		{
-			nSegCnt++;
+			m_pstReadRing = pstRing;
+			m_unReadIdx = m_stReadRingInfo[nIdx].nIdx;
+			m_unWaitRingIdx = nIdx + 1;
+			return DEF_SIG_DATA;
 		}
+	}
 
-		for(int i = 0; i < nSegCnt ; i++)
-		{
-
-			if(pTmpMbuf != NULL)
-			{
-				pMbuf = rte_pktmbuf_alloc(m_pstCmdMemPool);
-				if(pMbuf == NULL)
-				{
-					rte_pktmbuf_free(pHeadMbuf);
-					SetErrorMsg("Mbuf Alloc Failed");
-					RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
-					return -E_Q_NOSPC;
-				}
-
-				pTmpMbuf->next = pMbuf;
-			}
-			else
-			{
-				pMbuf = pHeadMbuf;
-			}
-
-			if( i < nSegCnt )
-			{
-				pMbuf->data_len = unBuffLen;
-			}
-			else
-			{
-				pMbuf->data_len = nLastLen;
-			}
-
-			pMbuf->nb_segs = nSegCnt + 1;
-			pMbuf->pkt_len = a_nSize;
-
-			memcpy( rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+	return -1;
+}
 
-			pCur += pMbuf->data_len;
-			pTmpMbuf = pMbuf;
+/*!
+ * \brief Set or Clear Sleep Flag in All Read Rings (Futex Mode)
+ * \param a_unSleep is Sleep Status (1 : Sleep, 0 : Awake)
+ * \return None
+ */
+void CLQManager::SetAllSleepFlag(uint32_t a_unSleep)
+{
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
 
-		}
+	for(int i = 0; i < m_unReadRingCount ; i++)
+	{
+		if(m_stReadRingInfo[i].pstRing == NULL)
+			continue;
 
+		SetConsSleep(m_stReadRingInfo[i].pstRing, m_stReadRingInfo[i].nIdx, a_unSleep);
 	}
-
-	m_pstWriteMbuf[m_unCurWriteMbufIdx++] = pHeadMbuf;
-	return 0;
-}
+}
 
 /*!
- * \brief Enqeue Data (Index)
- * \details 현재 읽고 있는 Memory Buffer 구조체 그대로 다음 Queue 로 전달
- *          데이터의 Length 의 변경 없이 Filed 의 변경만 있을 때 사용 가능
- *          혹은 데이터의 변경이 Memory Buffer 의 최대 Length 를 넘지 않을 경우 사용 가능
- * \param a_nIdx is Index of m_stWriteRingInfo Array (Default : 0)
+ * \brief Read a Data From a Ring
+ * \details Queue 로 부터 한개의 데이터를 읽어들여 입력된 포인터에 데이터의 주소값을 대입
+ * \param  a_pszBuff is Buffer Pointer to Store Data
  * \return 
- *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
- *   - -E_Q_NOMEM out of memory;
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
+ *   - size of data on Success
+ *   - -E_Q_INVAL ring pointer invalid 
+ *   - -E_Q_NOENT Not enough entries in the ring to dequeue; no object is dequeued.
+ *   - -E_Q_NOMEM out of Memory
  */
-int CLQManager::WriteData( int a_nIdx )
+int CLQManager::ReadData( char **a_pszBuff )
 {
+	//Result
 	int ret = 0;
-	//Ring Pointer
-	struct rte_ring *pstRing = NULL;
+	int nSegs = 0;
+	char *p = m_szJumboBuff;
+	struct rte_mbuf *pMbuf = NULL;
 
-	//Check Idx Error
-	if(unlikely(a_nIdx < 0))
-		return -E_Q_INVAL;
-	
-	if(unlikely(a_nIdx > m_unWriteRingCount))
-		return -E_Q_INVAL;
-	
-	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
-	if(unlikely(pstRing == NULL))
+	if(m_pstReadRing == NULL)
 	{
-		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		SetErrorMsg("m_pstReadRing is NULL");
 		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
 		return -E_Q_INVAL;
 	}
 
-	//Fail 이 일정 Count 의 배수일 때
-	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
-	//다시 한번 Signal 을 전송
-	if(unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0))
-	{
-		SendRTS(pstRing);
-	}
+	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, 1, RTE_RING_QUEUE_FIXED, m_unReadIdx);
 
-	ret = InsertData();
-	if(unlikely(ret < 0))
+	if(unlikely(ret != 0))
 	{
-		m_unCurWriteMbufIdx = 0;
-		SetErrorMsg("Insert Data Failed");
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
 		return ret;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				pstRing
-				,m_unCurWriteMbufIdx 
-				,m_stWriteRingInfo[a_nIdx].nIdx	);
-
-	if(unlikely(ret < 0))
-	{
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[a_nIdx].unFailCnt++;
-		return ret;
-	}
+	m_pstCurMbuf = pMbuf = m_pstReadMbuf[0];
 
-	//Backup Data
-	if(m_bBackup)
+	//데이터의 크기가 Memory Buffer 한개의 사이즈를 초과한 경우에
+	//여러개의 Memory Buffer 가 Linked list 형태로 연결 되어 있기 때문에
+	//하나의 Memory Buffer 에 넣어서 포인터만 넘겨 줌
+	if(unlikely(pMbuf->nb_segs > 1))
 	{
-		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx ) ;
-		if(ret < 0)
+		nSegs = pMbuf->nb_segs;
+		if( rte_pktmbuf_pkt_len(pMbuf) > DEF_MEM_JUMBO )
 		{
-			SetErrorMsg("Write Data Backup Failed");
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			SetErrorMsg("Over Jumbo Memory Buffer Size %d, data_size : %d"
+								, DEF_MEM_JUMBO, rte_pktmbuf_pkt_len(pMbuf));
+
+			RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
+			rte_pktmbuf_free(pMbuf);
+			return -E_Q_NOMEM;
 		}
-	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
+		for(int i = 0; i < nSegs ; i++)
+		{
+			if(pMbuf)
+			{
+				memcpy(p, rte_pktmbuf_mtod(pMbuf, char *), rte_pktmbuf_data_len(pMbuf)); 
+				p += rte_pktmbuf_data_len(pMbuf);
+				pMbuf = pMbuf->next;
+			}
+			else
+			{
+				break;
+			}
+		}
 
-	SendRTS(pstRing);
+		*a_pszBuff = m_szJumboBuff;
+	}
+	else
+	{
+		*a_pszBuff = rte_pktmbuf_mtod( pMbuf, char * );
+	}
 
-	return ret;
+	m_bReadComplete = true;
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
 }
 
 /*!
- * \brief Enqeue Data (Hash Function)
- * \details 현재 읽고 있는 Memory Buffer 구조체 그대로 다음 Queue 로 전달
- *          데이터의 Length 의 변경 없이 Filed 의 변경만 있을 때 사용 가능
- *          혹은 데이터의 변경이 Memory Buffer 의 최대 Length 를 넘지 않을 경우 사용 가능
- *          Hash 함수를 이용하여서 Write 할 Queue 를 선택
- * \param a_pArgs is Arguments for Hash Function
+ * \brief Read a Data From a Ring (Zero Copy)
+ * \details Queue 로 부터 한개의 데이터를 읽어들여 Memory Buffer Chain 의 각 Segment 주소와 길이를
+ * 입력된 Segment List 에 대입한다. Jumbo Buffer 로 복사하지 않으므로 Segment List 는
+ * FreeReadData() 호출 전까지 유효하다.
+ * \param a_pstIov is Segment List to Store Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
  * \return 
- *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
- *   - -E_Q_NOMEM out of memory;
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
+ *   - size of data on Success
+ *   - -E_Q_INVAL ring pointer invalid 
+ *   - -E_Q_NOENT Not enough entries in the ring to dequeue; no object is dequeued.
+ *   - -E_Q_NOMEM Segment List Size < Count of Segment (데이터는 Dequeue 되었으므로 ReadComplete, FreeReadData 로 처리)
  */
-int CLQManager::WriteDataHash( void *a_pArgs )
+int CLQManager::ReadData( struct iovec *a_pstIov, int *a_pnIovCnt )
 {
+	//Result
 	int ret = 0;
-	//Idx of Write Ring
-	int idx = m_pfuncHash(a_pArgs);
-	//Ring Pointer
-	struct rte_ring *pstRing = NULL;
-
-	//Check Idx Error
-	if(unlikely(idx < 0))
-		return -E_Q_INVAL;
-	
-	if(unlikely(idx > m_unWriteRingCount))
-		return -E_Q_INVAL;
-	
-	pstRing = m_stWriteRingInfo[idx].pstRing;
 
-	if(unlikely(pstRing == NULL))
+	if(m_pstReadRing == NULL)
 	{
-		SetErrorMsg("Queue Idx[%d] is NULL", idx);
+		SetErrorMsg("m_pstReadRing is NULL");
 		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
 		return -E_Q_INVAL;
 	}
 
-	//Fail 이 일정 Count 의 배수일 때
-	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
-	//다시 한번 Signal 을 전송
-	if( unlikely((m_stWriteRingInfo[idx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, 1, RTE_RING_QUEUE_FIXED, m_unReadIdx);
+
+	if(unlikely(ret != 0))
 	{
-		SendRTS(pstRing);
+		return ret;
 	}
 
-	ret = InsertData();
+	m_pstCurMbuf = m_pstReadMbuf[0];
+
+	//Dequeue 된 Slot 은 완료 처리해야 하므로 Segment List 가 부족해도 ReadComplete, FreeReadData 를 호출한다
+	m_bReadComplete = true;
+
+	ret = GetMbufIov(m_pstCurMbuf, a_pstIov, a_pnIovCnt);
 	if(unlikely(ret < 0))
 	{
-		m_unCurWriteMbufIdx = 0;
-		SetErrorMsg("Insert Data Failed");
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		SetErrorMsg("Over Segment List Size, seg_cnt : %d", *a_pnIovCnt);
 		return ret;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				pstRing
-				,m_unCurWriteMbufIdx 
-				,m_stWriteRingInfo[idx].nIdx ) ;
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+}
 
-	if(unlikely(ret < 0))
+/*!
+ * \brief Read several Data from a ring
+ * \details Queue 로 부터 여러개의 데이터를 읽어들인다.(Bulk Mode 에서만 사용)
+ * 읽어들인 데이터는 GetNext() 함수로만 데이터를 전달 받을 수 있다.
+ * \param a_nCount is count of element 
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL bulk Count > Max Bulk Count; ring pointer invalid 
+ *   - -E_Q_NOENT Not enough entries in the ring to dequeue; no object is dequeued.
+ *   - -E_Q_NOMEM out of Memory
+ *         Fail : -1
+ */
+int CLQManager::ReadBulkData( int a_nCount )
+{
+	//Result
+	int ret = 0;
+	int nCount = a_nCount;
+
+	if(unlikely(nCount > DEF_MAX_BULK))
 	{
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[idx].unFailCnt++;
-		return ret;
+		SetErrorMsg("Bulk Count Over > %d", DEF_MAX_BULK);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
 	}
 
-	//Backup Data
-	if(m_bBackup)
+	if(unlikely(m_pstReadRing == NULL))
 	{
-		ret = BackupWriteData( pstRing, m_stWriteRingInfo[idx].nIdx );
-		if(ret < 0)
-		{
-			SetErrorMsg("Write Data Backup Failed");
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-		}
+		SetErrorMsg("m_pstReadRing is NULL");
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
 	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
 
-	SendRTS(pstRing);
+	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, nCount, RTE_RING_QUEUE_FIXED, m_unReadIdx);
+	
+	if(unlikely(ret != 0))
+	{
+		m_unTotReadMbufIdx = 0;
+		m_unCurReadMbufIdx = 0;
+//		SetSleepFlag(m_pstReadRing);
+		return ret;
+	}
 
-	return ret;
+	m_unTotReadMbufIdx = nCount;
+	m_unCurReadMbufIdx = 0;
+	return 0;
 }
 
+
 /*!
- * \brief Enqueue Data (Index)
- * \details Enqueue Data and Send RTS to Consumer 
- *          (Write Queue 선택 기준은 Write Queue 의 Index)
- * \param a_pszData is Data Pointer to Insert 
- * \param a_nSize is Size of Data
- * \param a_nIdx is Index of m_stWriteRingInfo Array(Default : 0)
- * \return
- *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
- *   - -E_Q_NOMEM out of memory;
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
+ * \brief Read up to N Data from a ring
+ * \details Queue 에 있는 데이터를 최대 a_nCount 개 까지 읽어들인다. (RTE_RING_QUEUE_VARIABLE)
+ * ReadBulkData 와 달리 a_nCount 보다 적은 데이터만 있어도 실패하지 않으므로 쌓여 있는 데이터를 빠르게 처리 가능
+ * 읽어들인 데이터는 GetNext() 함수로만 데이터를 전달 받을 수 있다.
+ * \param a_nCount is max count of element (<= DEF_MAX_BURST)
+ * \return 
+ *   - Count of Read Data on Success (0 : There is no Data)
+ *   - -E_Q_INVAL burst Count > Max Burst Count; ring pointer invalid 
  */
-int CLQManager::WriteData( char *a_pszData, int a_nSize, int a_nIdx )
+int CLQManager::ReadBurstData( int a_nCount )
 {
+	//Result
 	int ret = 0;
-	//Ring Pointer
-	struct rte_ring *pstRing = NULL;
 
-	//Check Idx Error
-	if(unlikely(a_nIdx < 0))
-		return -E_Q_INVAL;
-	
-	if(unlikely(a_nIdx > m_unWriteRingCount))
+	if(unlikely(a_nCount > DEF_MAX_BURST || a_nCount <= 0))
+	{
+		SetErrorMsg("Invalid Burst Count %d (Max %d)", a_nCount, DEF_MAX_BURST);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
 		return -E_Q_INVAL;
+	}
 
-	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
-
-	if(unlikely(pstRing == NULL))
+	if(unlikely(m_pstReadRing == NULL))
 	{
-		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		SetErrorMsg("m_pstReadRing is NULL");
 		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
 		return -E_Q_INVAL;
 	}
 
-	//Fail 이 일정 Count 의 배수일 때
+	ret = rte_ring_mc_dequeue_bulk_idx(m_pstReadRing, (void**)m_pstReadMbuf, a_nCount, RTE_RING_QUEUE_VARIABLE, m_unReadIdx);
+
+	m_unCurReadMbufIdx = 0;
+
+	if(unlikely(ret <= 0))
+	{
+		m_unTotReadMbufIdx = 0;
+		return ret;
+	}
+
+	m_unTotReadMbufIdx = ret;
+	return ret;
+}
+
+/*!
+ * \brief Get Next Data From m_pstMbuf
+ * \details Bulk Mode 로 동작할 때 ReadBulkData 함수 호출 이후
+ *          GetNext() 함수를 이용하여서 데이터를 하나씩 Read
+ * \param  a_pszBuff is Buffer Pointer to Store Data
+ * \return 
+ *   - Size of Data on Success
+ *   - -E_Q_INVAL Read buffer Index Over;
+ *   - -E_Q_NOMEM out of Memory;
+ */
+int CLQManager::GetNext(char **a_pszBuff)
+{
+	char *p = m_szJumboBuff;
+	struct rte_mbuf *pMbuf = NULL;
+	int nSegs = 0;
+
+	if(unlikely(m_unCurReadMbufIdx >= m_unTotReadMbufIdx))
+		return -E_Q_INVAL;
+
+	m_pstCurMbuf = pMbuf = m_pstReadMbuf[m_unCurReadMbufIdx++];
+//	RTE_LOG(ERR, MBUF, "pMbuf %p, m_pstCurMbuf, %p\n", pMbuf, m_pstCurMbuf);
+
+	//데이터의 크기가 Memory Buffer 한개의 사이즈를 초과한 경우에
+	//여러개의 Memory Buffer 가 Linked list 형태로 연결 되어 있기 때문에
+	//하나의 Memory Buffer 에 넣어서 포인터만 넘겨 줌
+	if(unlikely(pMbuf->nb_segs > 1))
+	{
+		nSegs = pMbuf->nb_segs;
+			
+		if( rte_pktmbuf_pkt_len(pMbuf) > DEF_MEM_JUMBO )
+		{
+			SetErrorMsg("Over Jumbo Memory Buffer Size %d, data_size : %d", DEF_MEM_JUMBO, rte_pktmbuf_pkt_len(pMbuf));
+			RTE_LOG(ERR, MBUF, "%s\n"
+								, GetErrorMsg());
+			rte_pktmbuf_free(pMbuf);
+			return -E_Q_NOMEM;
+		}
+	
+		for(int i = 0; i < nSegs; i++)
+		{
+			if(pMbuf)
+			{
+				memcpy(p, rte_pktmbuf_mtod(pMbuf, char *), rte_pktmbuf_data_len(pMbuf)); 
+				p += rte_pktmbuf_data_len(pMbuf);
+				pMbuf = pMbuf->next;
+			}
+			else
+			{
+				break;
+			}
+		}
+
+		*a_pszBuff = m_szJumboBuff;
+	}
+	else
+	{
+		*a_pszBuff = rte_pktmbuf_mtod( pMbuf, char * );
+	}
+
+	if(unlikely(m_unCurReadMbufIdx == m_unTotReadMbufIdx))
+	{
+		m_bReadComplete = true;
+	}
+
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+}
+
+/*!
+ * \brief Get Next Data From m_pstMbuf (Zero Copy)
+ * \details Bulk Mode 로 동작할 때 ReadBulkData 함수 호출 이후
+ *          Memory Buffer Chain 의 Segment List 를 하나씩 Read
+ *          Segment List 는 FreeReadBulkData() 호출 전까지 유효하므로 여러개의 Jumbo Data 를 동시에 보관 가능
+ * \param a_pstIov is Segment List to Store Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
+ * \return 
+ *   - Size of Data on Success
+ *   - -E_Q_INVAL Read buffer Index Over;
+ *   - -E_Q_NOMEM Segment List Size < Count of Segment (a_pnIovCnt 에 필요한 Segment 수를 기록, 더 큰 Segment List 로 다시 호출하면 같은 데이터를 읽음)
+ */
+int CLQManager::GetNext( struct iovec *a_pstIov, int *a_pnIovCnt )
+{
+	int ret = 0;
+
+	if(unlikely(m_unCurReadMbufIdx >= m_unTotReadMbufIdx))
+		return -E_Q_INVAL;
+
+	m_pstCurMbuf = m_pstReadMbuf[m_unCurReadMbufIdx++];
+
+	ret = GetMbufIov(m_pstCurMbuf, a_pstIov, a_pnIovCnt);
+	if(unlikely(ret < 0))
+	{
+		//a_pnIovCnt 크기의 Segment List 로 같은 데이터를 다시 읽을 수 있도록 Index 를 되돌림
+		m_unCurReadMbufIdx--;
+		SetErrorMsg("Over Segment List Size, seg_cnt : %d", *a_pnIovCnt);
+		return ret;
+	}
+
+	if(unlikely(m_unCurReadMbufIdx == m_unTotReadMbufIdx))
+	{
+		m_bReadComplete = true;
+	}
+
+	return rte_pktmbuf_pkt_len(m_pstCurMbuf);
+}
+
+/*!
+ * \brief Fill Segment List From Memory Buffer Chain
+ * \details Error Msg 를 설정하지 않으므로 (CLQHandle 에서도 사용) 호출한 쪽에서 설정한다.
+ * Segment List 가 부족해도 Memory Buffer 는 해제하지 않으며, a_pnIovCnt 에 필요한 Segment 수를 기록한다.
+ * \param a_pstMbuf is Head of Memory Buffer Chain
+ * \param a_pstIov is Segment List to Store Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOMEM Segment List Size < Count of Segment
+ */
+int CLQManager::GetMbufIov(struct rte_mbuf *a_pstMbuf, struct iovec *a_pstIov, int *a_pnIovCnt)
+{
+	int nSegs = 0;
+	struct rte_mbuf *pMbuf = a_pstMbuf;
+
+	if(unlikely(a_pstMbuf->nb_segs > *a_pnIovCnt))
+	{
+		RTE_LOG(ERR, MBUF, "Over Segment List Size %d, seg_cnt : %d\n", *a_pnIovCnt, a_pstMbuf->nb_segs);
+		*a_pnIovCnt = a_pstMbuf->nb_segs;
+		return -E_Q_NOMEM;
+	}
+
+	while(pMbuf != NULL && nSegs < a_pstMbuf->nb_segs)
+	{
+		a_pstIov[nSegs].iov_base = rte_pktmbuf_mtod(pMbuf, char *);
+		a_pstIov[nSegs].iov_len = rte_pktmbuf_data_len(pMbuf);
+		nSegs++;
+		pMbuf = pMbuf->next;
+	}
+
+	*a_pnIovCnt = nSegs;
+
+	return 0;
+}
+
+/*!
+ * \brief Read Complete
+ * \details 데이터 처리 완료 후 호출 된다.
+ *          1. 현재 읽고 있는 Ring 의 Consumer Position 을 변경한다.
+ *             (다른 Consumer 의 완료를 기다리지 않으며, Ring 의 Tail 은 연속으로 완료된 위치까지 이동)
+ *          2. 현재 읽고 있는 Memory Buffer 를 Memory Pool 로 돌려 준다.
+ * \param None
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_MSYNC msync function error
+ */
+int CLQManager::ReadComplete()
+{
+	int ret = 0;
+
+	if(likely(m_bReadComplete))
+	{
+		//Broadcast Queue 는 가장 느린 Subscriber 의 위치까지 Slot 을 반환
+		if(m_pstReadRing->flags & RING_F_BCAST)
+			rte_ring_bcast_read_complete(m_pstReadRing, m_unReadIdx);
+		else
+			rte_ring_read_complete(m_pstReadRing
+								, m_pstReadRing->cons.cons_info[m_unReadIdx].tail
+								, m_pstReadRing->cons.cons_info[m_unReadIdx].head
+								);
+		//Read Complete 함수 호출 뒤에 consumer Info 의 Tail 값을 Head 값으로 변경
+		m_pstReadRing->cons.cons_info[m_unReadIdx].tail = m_pstReadRing->cons.cons_info[m_unReadIdx].head;
+		m_bReadComplete = false;
+
+		//Low Watermark 이상 비었으면 대기중인 Producer 를 깨움
+		WakeProducer(m_pstReadRing);
+		//High Watermark 를 넘은 Ring 을 Low Watermark 까지 비웠으면 상태 해제 (Producer 가 Event 를 전달)
+		rte_ring_wm_leave(m_pstReadRing);
+
+		if(m_bBackup)
+		{
+			ret = BackupReadData(m_pstReadRing, m_unReadIdx) ;
+			if(ret < 0)
+			{
+				SetErrorMsg("Backup Read Data Failed");
+				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+				return ret;
+			}
+		}
+
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Free Read Data
+ * \details 처리가 완전히 완료된 Memory Buffer 를해제한다.
+ * \param None
+ * \return None
+ */
+void CLQManager::FreeReadData()
+{
+	rte_pktmbuf_free(m_pstCurMbuf);
+
+	//Memory Pool 부족으로 대기중인 Producer 를 깨움
+	if(m_pstReadRing != NULL)
+		WakeProducer(m_pstReadRing);
+}
+
+/*!
+ * \brief Free Read Bulk Data
+ * \details 처리가 완전히 완료된 Memory Buffer 를 해제한다(Bulk Mode)
+ * \param None
+ * \return None
+ */
+void CLQManager::FreeReadBulkData()
+{
+	for(int i = 0; i < m_unTotReadMbufIdx ; i++)
+	{
+		rte_pktmbuf_free(m_pstReadMbuf[i]);
+	}
+
+	//Memory Pool 부족으로 대기중인 Producer 를 깨움
+	if(m_pstReadRing != NULL)
+		WakeProducer(m_pstReadRing);
+}
+
+/*!
+ * \brief Insert Data To m_pstWriteMbuf
+ * \details 만약 현재 읽은 Memory Buffer 를 그대로 다음 Queue 에 전달하고 싶을 때 사용
+ * \param None
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOMEM out of memory
+ */
+int CLQManager::InsertData()
+{
+	if( unlikely( (m_unCurWriteMbufIdx + m_pstCurMbuf->nb_segs) >= (DEF_MEM_BUF_1024)) )
+		return -E_Q_NOMEM;
+
+	for(int i = 0; i < m_pstCurMbuf->nb_segs ; i++)
+	{
+		m_pstWriteMbuf[m_unCurWriteMbufIdx++] = m_pstCurMbuf;
+		m_pstCurMbuf = m_pstCurMbuf->next;
+
+		if( NULL == m_pstCurMbuf )
+			break;
+	}
+
+	return 0;
+	
+}
+
+/*!
+ * \brief Insert Data To m_pstWriteMbuf
+ * \details Bulk Mode 에서 여러개의 Data 를 Buffer 에 넣기 위해서 사용
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory;
+ */
+int CLQManager::InsertData( char *a_pszData, int a_nSize )
+{
+	int ret = 0;
+	char *pCur = a_pszData;
+	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL;
+
+	if(unlikely(m_unCurWriteMbufIdx >= DEF_MEM_BUF_1024))
+		return -1;
+
+	ret = AllocDataMbuf(a_nSize, &pHeadMbuf);
+	if(unlikely(ret < 0))
+		return ret;
+
+	//만약 데이터의 Size 가 Memory Buffer 의 Size 를 초과한 경우
+	//Linked list 형태로 연결된 Memory Buffer 에 나누어 복사
+	for(pMbuf = pHeadMbuf; pMbuf != NULL; pMbuf = pMbuf->next)
+	{
+		memcpy( rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+		pCur += pMbuf->data_len;
+	}
+
+	m_pstWriteMbuf[m_unCurWriteMbufIdx++] = pHeadMbuf;
+	return 0;
+}
+
+/*!
+ * \brief Alloc Memory Buffer Chain for Data Size
+ * \details Memory Pool 에서 Memory Buffer 를 가져와서 데이터의 길이를 설정한다.
+ * 데이터의 Size 가 Memory Buffer 의 Size 를 초과한 경우 여러개의 Memory Buffer 를 Linked list 형태로 연결
+ * \param a_pstMemPool is Memory Pool
+ * \param a_nSize is Size of Data
+ * \param a_ppstMbuf is Pointer to Store Head of Memory Buffer Chain
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory;
+ */
+int CLQManager::AllocMbuf(struct rte_mempool *a_pstMemPool, int a_nSize, struct rte_mbuf **a_ppstMbuf)
+{
+	int nSegCnt = 0;
+	int nLastLen = 0;
+	uint16_t unBuffLen = 0;
+	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL, *pTmpMbuf = NULL;
+
+	if(unlikely(a_nSize > DEF_MEM_BUF_1M))
+	{
+		RTE_LOG(ERR, MBUF, "Data Length Over 1M , [Size:%d]\n", a_nSize);
+		return -E_Q_NOMEM;
+	}
+
+	pHeadMbuf = rte_pktmbuf_alloc(a_pstMemPool);
+	if(unlikely(pHeadMbuf == NULL))
+	{
+//		RTE_LOG(ERR, MBUF, "Mbuf Alloc Failed\n");
+		return -E_Q_NOSPC;
+	}
+
+	//Memory Pool (Size Class) 마다 Memory Buffer 의 Data Size 가 다르다
+	unBuffLen = rte_pktmbuf_data_room_size(a_pstMemPool) - RTE_PKTMBUF_HEADROOM;
+	if(likely(a_nSize <= unBuffLen))
+	{
+		pHeadMbuf->data_len = a_nSize;
+		pHeadMbuf->nb_segs = 1;
+		pHeadMbuf->pkt_len = a_nSize;
+	}
+	//만약 데이터의 Size 가 Memory Buffer 의 Size 를 초과한 경우
+	//여러개의 Memory Buffer 를 Linked list 형태로 연결
+	else
+	{
+		nSegCnt = a_nSize / unBuffLen;
+		nLastLen = a_nSize - (unBuffLen * nSegCnt);
+		if(nLastLen == 0)
+		{
+			nLastLen = unBuffLen;
+		}
+		else
+		{
+			nSegCnt++;
+		}
+
+		for(int i = 1; i <= nSegCnt ; i++)
+		{
+			if(pTmpMbuf != NULL)
+			{
+				pMbuf = rte_pktmbuf_alloc(a_pstMemPool);
+				if(pMbuf == NULL)
+				{
+					rte_pktmbuf_free(pHeadMbuf);
+					RTE_LOG(ERR, MBUF, "Mbuf Alloc Failed\n");
+					return -E_Q_NOSPC;
+				}
+
+				pTmpMbuf->next = pMbuf;
+			}
+			else
+			{
+				pMbuf = pHeadMbuf;
+			}
+
+			if( i < nSegCnt )
+			{
+				pMbuf->data_len = unBuffLen;
+			}
+			else
+			{
+				pMbuf->data_len = nLastLen;
+			}
+
+			pMbuf->nb_segs = nSegCnt;
+			pMbuf->pkt_len = a_nSize;
+
+			pTmpMbuf = pMbuf;
+		}
+	}
+
+	*a_ppstMbuf = pHeadMbuf;
+	return 0;
+}
+
+/*!
+ * \brief Load Size Class Memory Pools Created by LQ_INIT
+ * \details BASE_MEMORY_POOL 과 DEF_MBUF_CLASS_POOL_PREFIX 로 시작하는 Memory Pool (다른 Process 가 만든 Grow Chunk 포함) 을
+ * Segment Size 오름차순으로 정렬한다. Size Class 가 없으면 BASE_MEMORY_POOL 만 사용한다.
+ * \return 
+ *   - Count of Size Class
+ */
+int CLQManager::LoadMbufClass()
+{
+	MBUF_CLASS_TABLE *pstTbl = &m_stMbufClassTbl[0];
+
+	pstTbl->nCnt = 0;
+	AddMbufClass(m_pstDataMemPool, pstTbl);
+	rte_mempool_walk(AddMbufClass, pstTbl);
+	SortMbufClass(pstTbl);
+
+	for(int i = 0; i < pstTbl->nCnt; i++)
+	{
+		RTE_LOG(INFO, MEMPOOL, "Size Class [%d] %s, Segment Size %u, Count %u\n"
+				, i, pstTbl->stClass[i].pstMemPool->name, pstTbl->stClass[i].unSegSize, pstTbl->stClass[i].pstMemPool->size);
+	}
+
+	m_nMbufClassVer = 0;
+	m_pstMbufClass = pstTbl;
+
+	return pstTbl->nCnt;
+}
+
+/*!
+ * \brief Add Size Class Memory Pool (rte_mempool_walk Callback)
+ * \details 첫번째 호출은 BASE_MEMORY_POOL 이며, 이후에는 DEF_MBUF_CLASS_POOL_PREFIX 로 시작하는 Memory Pool 만 추가한다.
+ * \param a_pstMemPool is Memory Pool
+ * \param a_pArg is Size Class Table
+ * \return void
+ */
+void CLQManager::AddMbufClass(const struct rte_mempool *a_pstMemPool, void *a_pArg)
+{
+	MBUF_CLASS_TABLE *pstTbl = (MBUF_CLASS_TABLE*)a_pArg;
+	struct rte_mempool *pstMemPool = (struct rte_mempool*)a_pstMemPool;
+	MBUF_CLASS *pstClass = NULL;
+
+	if(pstTbl->nCnt >= DEF_MAX_MBUF_CLASS + DEF_MAX_GROW_CHUNK)
+		return;
+
+	if( pstTbl->nCnt > 0 && 
+		strncmp(pstMemPool->name, DEF_MBUF_CLASS_POOL_PREFIX, strlen(DEF_MBUF_CLASS_POOL_PREFIX)) != 0 )
+		return;
+
+	if(rte_pktmbuf_data_room_size(pstMemPool) <= RTE_PKTMBUF_HEADROOM)
+		return;
+
+	pstClass = &(pstTbl->stClass[pstTbl->nCnt++]);
+	pstClass->pstMemPool = pstMemPool;
+	pstClass->unSegSize = rte_pktmbuf_data_room_size(pstMemPool) - RTE_PKTMBUF_HEADROOM;
+}
+
+/*!
+ * \brief Sort Size Class Table by Segment Size
+ * \details Insertion Sort 이며, 같은 Segment Size 는 추가된 순서 (BASE_MEMORY_POOL, Grow Chunk 순) 를 유지한다.
+ * \param a_pstTbl is Size Class Table
+ * \return void
+ */
+void CLQManager::SortMbufClass(MBUF_CLASS_TABLE *a_pstTbl)
+{
+	int j = 0;
+	MBUF_CLASS stTmp;
+
+	for(int i = 1; i < a_pstTbl->nCnt; i++)
+	{
+		stTmp = a_pstTbl->stClass[i];
+		for(j = i - 1; j >= 0 && a_pstTbl->stClass[j].unSegSize > stTmp.unSegSize; j--)
+			a_pstTbl->stClass[j + 1] = a_pstTbl->stClass[j];
+		a_pstTbl->stClass[j + 1] = stTmp;
+	}
+}
+
+/*!
+ * \brief Select Smallest Size Class which Data Fits in One Memory Buffer
+ * \param a_pstTbl is Size Class Table
+ * \param a_unSize is Size of Data
+ * \return 
+ *   - Index of Size Class (한개의 Memory Buffer 에 들어가지 않으면 가장 큰 Size Class)
+ */
+int CLQManager::SelectMbufClass(MBUF_CLASS_TABLE *a_pstTbl, uint32_t a_unSize)
+{
+	int i = 0;
+
+	for(i = 0; i < a_pstTbl->nCnt - 1; i++)
+	{
+		if(a_unSize <= a_pstTbl->stClass[i].unSegSize)
+			break;
+	}
+
+	return i;
+}
+
+/*!
+ * \brief Init Grow Chunk Config of Data Mempool
+ * \details MBUF_GROW_COUNT 혹은 MBUF_MAX_COUNT 설정이 없으면 Data Mempool 을 늘리지 않는다.
+ * 이미 다른 Process 가 만든 Grow Chunk 는 LoadMbufClass 에서 Size Class 로 추가되어 있으며, 그 다음 Chunk 부터 생성한다.
+ * \return void
+ */
+void CLQManager::InitGrowPool()
+{
+	char *pValue = NULL;
+	char szName[RTE_MEMPOOL_NAMESIZE];
+	uint32_t unMaxCount = 0;
+
+	m_nGrowChunk = 0;
+	m_nMaxGrowChunk = 0;
+	m_unGrowCount = 0;
+
+	pValue = m_pclsConfig->GetConfigValue("QUEUE", "MBUF_GROW_COUNT");
+	if(pValue != NULL)
+		m_unGrowCount = strtoul(pValue, NULL, 16);
+
+	pValue = m_pclsConfig->GetConfigValue("QUEUE", "MBUF_MAX_COUNT");
+	if(pValue != NULL)
+		unMaxCount = strtoul(pValue, NULL, 16);
+
+	if(m_unGrowCount == 0 || unMaxCount <= m_pstDataMemPool->size)
+		return;
+
+	m_nMaxGrowChunk = RTE_MIN((unMaxCount - m_pstDataMemPool->size) / m_unGrowCount, (uint32_t)DEF_MAX_GROW_CHUNK);
+
+	for( ; m_nGrowChunk < m_nMaxGrowChunk; m_nGrowChunk++)
+	{
+		snprintf(szName, sizeof(szName), DEF_MBUF_GROW_POOL_NAME, m_nGrowChunk);
+		if(rte_mempool_lookup(szName) == NULL)
+			break;
+	}
+
+	RTE_LOG(INFO, MEMPOOL, "Data Memory Pool Grow Chunk %u, Max Chunk %d, Current Chunk %d\n"
+			, m_unGrowCount, m_nMaxGrowChunk, m_nGrowChunk);
+}
+
+/*!
+ * \brief Grow Data Mempool by Adding a Chunk
+ * \details 다음 Grow Chunk 를 IPC Memory 에서 생성 (이미 다른 Process 가 생성했으면 Attach) 하고
+ * Chunk 를 추가한 새 Size Class Table 로 교체한다.
+ * Chunk 의 이름은 Process 간에 유일하므로 여러 Process 가 동시에 늘리더라도 같은 Chunk 는 한번만 생성된다.
+ * \param a_pstTbl is Size Class Table which Failed to Alloc
+ * \return 
+ *   - 0 on Success (다른 Thread 가 이미 교체한 경우 포함)
+ *   - -E_Q_NOSPC Max Count of Chunk; IPC Memory 부족
+ */
+int CLQManager::GrowDataPool(MBUF_CLASS_TABLE *a_pstTbl)
+{
+	char szName[RTE_MEMPOOL_NAMESIZE];
+	struct rte_mempool *pstMemPool = NULL;
+	MBUF_CLASS_TABLE *pstTbl = NULL;
+
+	if(m_nGrowChunk >= m_nMaxGrowChunk)
+		return -E_Q_NOSPC;
+
+	pthread_mutex_lock(&m_stGrowLock);
+
+	if(m_pstMbufClass != a_pstTbl)
+	{
+		pthread_mutex_unlock(&m_stGrowLock);
+		return 0;
+	}
+
+	if(m_nGrowChunk >= m_nMaxGrowChunk || m_nMbufClassVer >= DEF_MAX_GROW_CHUNK)
+	{
+		pthread_mutex_unlock(&m_stGrowLock);
+		return -E_Q_NOSPC;
+	}
+
+	snprintf(szName, sizeof(szName), DEF_MBUF_GROW_POOL_NAME, m_nGrowChunk);
+	pstMemPool = rte_mempool_lookup(szName);
+	if(pstMemPool == NULL)
+	{
+		pstMemPool = rte_mempool_create(szName, m_unGrowCount,
+										RTE_MBUF_SIZE, RTE_MIN((uint32_t)RTE_MBUF_CACHE_SIZE, m_unGrowCount / 2),
+										sizeof(struct rte_pktmbuf_pool_private), rte_pktmbuf_pool_init,
+										NULL, rte_pktmbuf_init, NULL, SOCKET_ID_ANY, 0); 
+
+		//다른 Process 가 먼저 생성
+		if(pstMemPool == NULL && rte_errno == EEXIST)
+			pstMemPool = rte_mempool_lookup(szName);
+	}
+
+	//IPC Memory 부족, 이후에는 늘리지 않음
+	if(pstMemPool == NULL)
+	{
+		m_nMaxGrowChunk = m_nGrowChunk;
+		pthread_mutex_unlock(&m_stGrowLock);
+
+		SetErrorMsg("Cannot Grow Data Memory Pool %s errno : %d", szName, rte_errno);
+		RTE_LOG(ERR, MEMPOOL, "%s\n", GetErrorMsg());
+		return -E_Q_NOSPC;
+	}
+
+	//Lock 없이 읽는 Thread 가 있으므로 다음 Table 에 복사한 뒤 교체
+	pstTbl = &m_stMbufClassTbl[m_nMbufClassVer + 1];
+	memcpy(pstTbl, a_pstTbl, sizeof(MBUF_CLASS_TABLE));
+	AddMbufClass(pstMemPool, pstTbl);
+	SortMbufClass(pstTbl);
+
+	rte_wmb();
+	m_pstMbufClass = pstTbl;
+	m_nMbufClassVer++;
+	m_nGrowChunk++;
+
+	pthread_mutex_unlock(&m_stGrowLock);
+
+	RTE_LOG(INFO, MEMPOOL, "Grow Data Memory Pool %s, Count %u\n", szName, pstMemPool->size);
+
+	return 0;
+}
+
+/*!
+ * \brief Alloc Memory Buffer Chain From Size Class Memory Pool
+ * \details 데이터가 한개의 Memory Buffer 에 들어가는 가장 작은 Size Class 에서 할당하고,
+ * 해당 Memory Pool 이 부족하면 다음 Size Class 에서 할당한다.
+ * 모든 Size Class 가 부족하면 Data Mempool 에 Grow Chunk 를 추가한 뒤 다시 할당한다.
+ * \param a_nSize is Size of Data
+ * \param a_ppstMbuf is Pointer to Store Head of Memory Buffer Chain
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory;
+ */
+int CLQManager::AllocDataMbuf(int a_nSize, struct rte_mbuf **a_ppstMbuf)
+{
+	int ret = -E_Q_NOSPC;
+	MBUF_CLASS_TABLE *pstTbl = NULL;
+
+	for(;;)
+	{
+		pstTbl = m_pstMbufClass;
+		if(unlikely(pstTbl->nCnt == 0))
+			return AllocMbuf(m_pstDataMemPool, a_nSize, a_ppstMbuf);
+
+		for(int i = SelectMbufClass(pstTbl, a_nSize); i < pstTbl->nCnt; i++)
+		{
+			ret = AllocMbuf(pstTbl->stClass[i].pstMemPool, a_nSize, a_ppstMbuf);
+			if(ret != -E_Q_NOSPC)
+				return ret;
+		}
+
+		if(GrowDataPool(pstTbl) < 0)
+			return ret;
+	}
+}
+
+/*!
+ * \brief Insert Command Data To m_pstWriteMbuf
+ * \details m_pstCmdPool 에서 Memory Buffer 를 가져와서 Command Data 를 입력
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory;
+ */
+int CLQManager::InsertCommandData( char *a_pszData, int a_nSize )
+{
+	int ret = 0;
+	char *pCur = a_pszData;
+	struct rte_mbuf *pHeadMbuf = NULL, *pMbuf = NULL;
+
+	if(m_unCurWriteMbufIdx >= DEF_MEM_BUF_1024)
+		return -1;
+	
+	if(a_nSize > DEF_MEM_BUF_1M)
+	{
+		SetErrorMsg("Data Length Over 1M , [Size:%d]", a_nSize);
+		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
+		return -E_Q_NOMEM;
+	}
+
+	//Command Memory Buffer 는 작으므로 Memory Buffer 의 Size 를 초과한 Command 는
+	//Linked list 형태로 연결된 Memory Buffer 에 나누어 복사
+	ret = AllocMbuf(m_pstCmdMemPool, a_nSize, &pHeadMbuf);
+	if(ret < 0)
+		return ret;
+
+	for(pMbuf = pHeadMbuf; pMbuf != NULL; pMbuf = pMbuf->next)
+	{
+		memcpy( rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+		pCur += pMbuf->data_len;
+	}
+
+	m_pstWriteMbuf[m_unCurWriteMbufIdx++] = pHeadMbuf;
+	return 0;
+}
+
+/*!
+ * \brief Enqeue Data (Index)
+ * \details 현재 읽고 있는 Memory Buffer 구조체 그대로 다음 Queue 로 전달
+ *          데이터의 Length 의 변경 없이 Filed 의 변경만 있을 때 사용 가능
+ *          혹은 데이터의 변경이 Memory Buffer 의 최대 Length 를 넘지 않을 경우 사용 가능
+ * \param a_nIdx is Index of m_stWriteRingInfo Array (Default : 0)
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::WriteData( int a_nIdx )
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+	//Ring Pointer
+	struct rte_ring *pstRing = NULL;
+
+	//Check Idx Error
+	if(unlikely(a_nIdx < 0))
+		return -E_Q_INVAL;
+	
+	if(unlikely(a_nIdx > m_unWriteRingCount))
+		return -E_Q_INVAL;
+	
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Fail 이 일정 Count 의 배수일 때
+	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
+	//다시 한번 Signal 을 전송
+	if(unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0))
+	{
+		SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+	}
+
+	ret = InsertData();
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		SetErrorMsg("Insert Data Failed");
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return ret;
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				pstRing
+				,m_unCurWriteMbufIdx 
+				,m_stWriteRingInfo[a_nIdx].nIdx
+				,&unSeq );
+
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[a_nIdx].unFailCnt++;
+		return ret;
+	}
+
+	//Backup Data
+	if(m_bBackup)
+	{
+		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx ) ;
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+
+	SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+
+	return ret;
+}
+
+/*!
+ * \brief Enqeue Data (Hash Function)
+ * \details 현재 읽고 있는 Memory Buffer 구조체 그대로 다음 Queue 로 전달
+ *          데이터의 Length 의 변경 없이 Filed 의 변경만 있을 때 사용 가능
+ *          혹은 데이터의 변경이 Memory Buffer 의 최대 Length 를 넘지 않을 경우 사용 가능
+ *          Hash 함수를 이용하여서 Write 할 Queue 를 선택
+ * \param a_pArgs is Arguments for Hash Function
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::WriteDataHash( void *a_pArgs )
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+	//Idx of Write Ring
+	int idx = m_pfuncHash(a_pArgs);
+	//Ring Pointer
+	struct rte_ring *pstRing = NULL;
+
+	//Check Idx Error
+	if(unlikely(idx < 0))
+		return -E_Q_INVAL;
+	
+	if(unlikely(idx > m_unWriteRingCount))
+		return -E_Q_INVAL;
+	
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[idx].pstRing;
+
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", idx);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Fail 이 일정 Count 의 배수일 때
+	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
+	//다시 한번 Signal 을 전송
+	if( unlikely((m_stWriteRingInfo[idx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	{
+		SendRTS(pstRing, m_stWriteRingInfo[idx].nIdx);
+	}
+
+	ret = InsertData();
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		SetErrorMsg("Insert Data Failed");
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return ret;
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				pstRing
+				,m_unCurWriteMbufIdx 
+				,m_stWriteRingInfo[idx].nIdx
+				,&unSeq );
+
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[idx].unFailCnt++;
+		return ret;
+	}
+
+	//Backup Data
+	if(m_bBackup)
+	{
+		ret = BackupWriteData( pstRing, m_stWriteRingInfo[idx].nIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx );
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+
+	SendRTS(pstRing, m_stWriteRingInfo[idx].nIdx);
+
+	return ret;
+}
+
+/*!
+ * \brief Enqueue Data (Index)
+ * \details Enqueue Data and Send RTS to Consumer 
+ *          (Write Queue 선택 기준은 Write Queue 의 Index)
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \param a_nIdx is Index of m_stWriteRingInfo Array(Default : 0)
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::WriteData( char *a_pszData, int a_nSize, int a_nIdx )
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+	//Ring Pointer
+	struct rte_ring *pstRing = NULL;
+
+	//Check Idx Error
+	if(unlikely(a_nIdx < 0))
+		return -E_Q_INVAL;
+	
+	if(unlikely(a_nIdx > m_unWriteRingCount))
+		return -E_Q_INVAL;
+
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
+
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Fail 이 일정 Count 의 배수일 때
+	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
+	//다시 한번 Signal 을 전송
+	if( unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	{
+		SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+	}
+
+	ret = InsertData(a_pszData, a_nSize) ;
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[a_nIdx].unFailCnt++;
+		return ret;
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				pstRing
+				,m_unCurWriteMbufIdx
+				,m_stWriteRingInfo[a_nIdx].nIdx
+				,&unSeq );
+
+	if(unlikely(ret < 0))
+	{
+		//Free Memory Buffer
+		rte_pktmbuf_free(m_pstWriteMbuf[0]);
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[a_nIdx].unFailCnt++;
+		return ret;
+	}
+
+	//Backup Data
+	if(m_bBackup)
+	{
+		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx );
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+	
+	SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+
+	return ret;
+}
+
+/*!
+ * \brief Enqueue Data (Index, Blocking / Timeout)
+ * \details WriteData 가 Ring Full 혹은 Memory Pool 부족으로 실패하면 Write Ring 의 Futex Word 에서 대기한 뒤 다시 시도한다.
+ *          Consumer 가 ReadComplete / Free 로 Low Watermark 이상의 공간을 확보하면 깨운다. (WaitWriteSpace 참조)
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \param a_nIdx is Index of m_stWriteRingInfo Array(Default : 0)
+ * \param a_nTimeout is Timeout (msec, -1 : 공간이 생길 때까지 대기)
+ * \return
+ *   - WriteData 참조
+ *   - -E_Q_TIMEDOUT there is no space until timeout
+ */
+int CLQManager::WriteDataWait( char *a_pszData, int a_nSize, int a_nIdx, int a_nTimeout )
+{
+	int ret = 0;
+	uint64_t unDeadline = UINT64_MAX;
+
+	if(a_nTimeout >= 0)
+		unDeadline = rte_rdtsc() + (uint64_t)a_nTimeout * rte_get_tsc_hz() / 1000;
+
+	while(1)
+	{
+		//입력 전 단계(Memory Pool 부족, Ring Full)의 실패만 재시도
+		//입력 후 Backup 실패는 -E_Q_BACKUP 으로 구분되므로 다시 입력하지 않음
+		ret = WriteData(a_pszData, a_nSize, a_nIdx);
+		if(likely(ret != -ENOBUFS && ret != -E_Q_NOSPC))
+			return ret;
+
+		ret = WaitWriteSpace(&m_stEpochSlot[0], a_nIdx, ret, unDeadline);
+		if(ret < 0)
+			return ret;
+	}
+}
+
+
+/*!
+ * \brief Enqueue Data (HashFunction)
+ * \details Enqueue Data and Send RTS to Consumer 
+ *          Hash 함수를 이용하여서 Write 할 Queue 를 선택
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \param a_pArgs is Arguments for Hash Function
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::WriteDataHash( char *a_pszData, int a_nSize, void *a_pArgs )
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+	//Idx of Write Ring
+	int idx = m_pfuncHash(a_pArgs);
+	//Ring Pointer
+	struct rte_ring *pstRing = NULL;
+
+	//Check Idx Error
+	if(unlikely(idx < 0))
+		return -E_Q_INVAL;
+	
+	if(unlikely(idx > m_unWriteRingCount))
+		return -E_Q_INVAL;
+
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[idx].pstRing;
+
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", idx);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Fail 이 일정 Count 의 배수일 때
+	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
+	//다시 한번 Signal 을 전송
+	if( unlikely((m_stWriteRingInfo[idx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	{
+		SendRTS(pstRing, m_stWriteRingInfo[idx].nIdx);
+	}
+
+	ret = InsertData(a_pszData, a_nSize);
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[idx].unFailCnt++;
+		return ret;
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				pstRing
+				,m_unCurWriteMbufIdx
+				,m_stWriteRingInfo[idx].nIdx
+				,&unSeq );
+
+	if(unlikely(ret < 0))
+	{
+		//Free Memory Buffer
+		rte_pktmbuf_free(m_pstWriteMbuf[0]);
+		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[idx].unFailCnt++;
+		return ret;
+	}
+
+	//Backup Data
+	if(m_bBackup)
+	{
+		ret = BackupWriteData( pstRing, m_stWriteRingInfo[idx].nIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx ) ;
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+	
+	SendRTS(pstRing, m_stWriteRingInfo[idx].nIdx);
+	
+	return ret;
+}
+
+/*!
+ * \brief Write Data to Ring
+ * \details Backup File 을 이용하여서 Queue 를 복구하는 기능을 위한 함수
+ * \param a_pstRing is Ring Pointer
+ * \param a_pszData is Data Pointer to Insert 
+ * \param a_nSize is Size of Data
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::WriteData( struct rte_ring *a_pstRing, char *a_pszData, int a_nSize )
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+
+	ret = InsertData(a_pszData, a_nSize) ;
+	if(unlikely(ret < 0))
+	{
+		m_unCurWriteMbufIdx = 0;
+		return ret;
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				a_pstRing
+				,m_unCurWriteMbufIdx
+				,0
+				,&unSeq );
+
+	if(unlikely(ret < 0))
+	{
+		//Free Memory Buffer
+		rte_pktmbuf_free(m_pstWriteMbuf[0]);
+		m_unCurWriteMbufIdx = 0;
+		return ret;
+	}
+
+	//Backup 하지 않으므로 Enqueue 시 보유한 Reference 를 바로 반환
+	if(m_bBackup)
+		rte_pktmbuf_free(m_pstWriteMbuf[0]);
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+
+	return ret;
+}
+
+/*!
+ * \brief Write Bulk Data to Ring (For Util)
+ * \details 여러 데이터를 위한 Memory Buffer 를 Memory Pool 에서 한번에 가져와(rte_mempool_get_bulk) 복사하고,
+ * Ring 에 한번에 입력한다. m_pstWriteMbuf 를 사용하지 않으므로 여러 Thread 가 서로 다른 Ring 에 동시에 호출할 수 있다.
+ * 모두 입력하거나 하나도 입력하지 않는다.
+ * \param a_pstRing is Ring Pointer
+ * \param a_pstIov is Data List
+ * \param a_nCnt is Count of Data (Max DEF_MAX_BURST)
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Count; Invalid Ring Pointer;
+ *   - -E_Q_NOMEM Too many Segments;
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -ENOBUFS there is no space for enqueue;
+ */
+int CLQManager::WriteBulkData( struct rte_ring *a_pstRing, struct iovec *a_pstIov, int a_nCnt )
+{
+	int ret = 0;
+	unsigned unSegTot = 0;
+	unsigned unSegIdx = 0;
+	uint16_t unSegCnt = 0;
+	uint32_t unLen = 0;
+	uint32_t unMaxLen = 0;
+	uint32_t unSegSize = RTE_MBUF_DATA_SIZE;
+	int nClass = 0;
+	MBUF_CLASS_TABLE *pstTbl = NULL;
+	char *pCur = NULL;
+	struct rte_mbuf *pstMbuf[DEF_MAX_BURST];
+	void *pSeg[DEF_MEM_BUF_1024];
+	struct rte_mbuf *pMbuf = NULL, *pPrev = NULL;
+
+	if(unlikely(a_pstRing == NULL || a_nCnt <= 0 || a_nCnt > DEF_MAX_BURST))
+		return -E_Q_INVAL;
+
+	for(int i = 0; i < a_nCnt; i++)
+	{
+		if(unlikely(a_pstIov[i].iov_len > DEF_MEM_BUF_1M))
+			return -E_Q_NOMEM;
+
+		if(a_pstIov[i].iov_len > unMaxLen)
+			unMaxLen = a_pstIov[i].iov_len;
+	}
+
+	//가장 긴 데이터가 한개의 Memory Buffer 에 들어가는 Size Class 에서 할당하고, 부족하면 다음 Size Class 에서 할당
+	//모든 Size Class 가 부족하면 Data Mempool 에 Grow Chunk 를 추가한 뒤 다시 할당
+	for(;;)
+	{
+		pstTbl = m_pstMbufClass;
+		ret = -E_Q_NOSPC;
+		for(nClass = SelectMbufClass(pstTbl, unMaxLen); nClass < pstTbl->nCnt; nClass++)
+		{
+			unSegSize = pstTbl->stClass[nClass].unSegSize;
+
+			unSegTot = 0;
+			for(int i = 0; i < a_nCnt; i++)
+				unSegTot += (a_pstIov[i].iov_len == 0) ? 1 : (a_pstIov[i].iov_len + unSegSize - 1) / unSegSize;
+
+			if(unlikely(unSegTot > DEF_MEM_BUF_1024))
+			{
+				ret = -E_Q_NOMEM;
+				continue;
+			}
+
+			if(likely(rte_mempool_get_bulk(pstTbl->stClass[nClass].pstMemPool, pSeg, unSegTot) == 0))
+				break;
+
+			ret = -E_Q_NOSPC;
+		}
+
+		if(likely(nClass < pstTbl->nCnt))
+			break;
+
+		if(ret != -E_Q_NOSPC || GrowDataPool(pstTbl) < 0)
+			return ret;
+	}
+
+	//Memory Buffer Chain 구성 후 복사 (AllocMbuf 와 같이 모든 Segment 에 nb_segs, pkt_len 설정)
+	for(int i = 0; i < a_nCnt; i++)
+	{
+		unLen = a_pstIov[i].iov_len;
+		unSegCnt = (unLen == 0) ? 1 : (unLen + unSegSize - 1) / unSegSize;
+		pCur = (char*)a_pstIov[i].iov_base;
+		pPrev = NULL;
+
+		for(uint16_t j = 0; j < unSegCnt; j++)
+		{
+			pMbuf = (struct rte_mbuf*)pSeg[unSegIdx++];
+			rte_mbuf_refcnt_set(pMbuf, 1);
+			rte_pktmbuf_reset(pMbuf);
+
+			pMbuf->data_len = (unLen > unSegSize) ? unSegSize : unLen;
+			pMbuf->nb_segs = unSegCnt;
+			pMbuf->pkt_len = a_pstIov[i].iov_len;
+			memcpy(rte_pktmbuf_mtod(pMbuf, char*), pCur, pMbuf->data_len);
+			pCur += pMbuf->data_len;
+			unLen -= pMbuf->data_len;
+
+			if(pPrev != NULL)
+				pPrev->next = pMbuf;
+			else
+				pstMbuf[i] = pMbuf;
+
+			pPrev = pMbuf;
+		}
+	}
+
+	if(a_pstRing->flags & RING_F_BCAST)
+		ret = EnqueueBcast(a_pstRing, pstMbuf, a_nCnt, 0, false, NULL);
+	else
+		ret = rte_ring_mp_enqueue_bulk_idx(a_pstRing, (void**)pstMbuf, a_nCnt, RTE_RING_QUEUE_FIXED, 0);
+
+	//입력은 성공하였고 High Watermark 를 넘음
+	if(unlikely(ret == -EDQUOT))
+	{
+		RaiseWatermark(a_pstRing);
+		ret = 0;
+	}
+
+	if(unlikely(ret < 0))
+	{
+		for(int i = 0; i < a_nCnt; i++)
+			rte_pktmbuf_free(pstMbuf[i]);
+	}
+
+	return ret;
+}
+
+/*!
+ * \brief Commit Data to Queue
+ * \details m_pstWriteMbuf 에 저장된 데이터를 Queue 에 Insert
+ *          Hash Function 을 이용한 Queue 의 선택 기능은 지원하지 않음
+ * \param a_nIdx is Index of m_stWriteRingInfo Array 
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::CommitData(int a_nIdx)
+{
+	int ret = 0;
+	//Ring Position of Enqueued Data (Backup)
+	uint32_t unSeq = 0;
+	//Ring Pointer
+	struct rte_ring *pstRing = NULL;
+	
+	//Check Idx Error
+	if(unlikely(a_nIdx < 0))
+	{
+		return -E_Q_INVAL;
+	}
+	
+	if(unlikely(a_nIdx > m_unWriteRingCount))
+	{
+		return -E_Q_INVAL;
+	}
+
+	//Select Ring by Index 
+	//Detach 된 Ring 은 Guard 를 벗어날 때까지 해제되지 않음
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
+
+	if(unlikely(pstRing == NULL))
+	{
+		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Fail 이 일정 Count 의 배수일 때
 	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
 	//다시 한번 Signal 을 전송
-	if( unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	if( unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0))
+	{
+		SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+	}
+
+	//Enqueue Data in Ring
+	ret = EnqueueData(
+				pstRing
+				,m_unCurWriteMbufIdx
+				,m_stWriteRingInfo[a_nIdx].nIdx
+				,&unSeq );
+
+	if(ret < 0)
+	{
+		//NO Space Error 시에는 재시도 하도록 변경. 따라서 m_unCurWriteMbufIdx 를 초기화 할 수 없음
+//		m_unCurWriteMbufIdx = 0;
+		m_stWriteRingInfo[a_nIdx].unFailCnt++;
+		return ret; 
+	}
+
+	//Backup Data
+	if(m_bBackup)
+	{
+		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx, unSeq, m_pstWriteMbuf, m_unCurWriteMbufIdx );
+		if(ret < 0)
+		{
+			SetErrorMsg("Write Data Backup Failed");
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		}
+	}
+
+	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
+	m_unCurWriteMbufIdx = 0;
+
+	SendRTS(pstRing, m_stWriteRingInfo[a_nIdx].nIdx);
+
+	return ret;
+
+}
+
+/*!
+ * \brief Commit Data to Queue (Blocking / Timeout)
+ * \details CommitData 가 Ring Full 로 실패하면 m_pstWriteMbuf 를 유지한 채 Write Ring 의 Futex Word 에서 대기한 뒤 다시 시도한다.
+ * 입력 후의 실패(Backup)나 입력할 Memory Buffer 가 없는 경우는 재시도하지 않는다.
+ * \param a_nIdx is Index of m_stWriteRingInfo Array 
+ * \param a_nTimeout is Timeout (msec, -1 : 공간이 생길 때까지 대기)
+ * \return 
+ *   - CommitData 참조
+ *   - -E_Q_TIMEDOUT there is no space until timeout (m_pstWriteMbuf 는 유지되므로 다시 Commit 할 수 있다)
+ */
+int CLQManager::CommitDataWait(int a_nIdx, int a_nTimeout)
+{
+	int ret = 0;
+	uint64_t unDeadline = UINT64_MAX;
+
+	if(a_nTimeout >= 0)
+		unDeadline = rte_rdtsc() + (uint64_t)a_nTimeout * rte_get_tsc_hz() / 1000;
+
+	while(1)
+	{
+		//입력하지 못한 Memory Buffer 가 남아 있을 때만 재시도 (입력 후 Backup 실패는 -E_Q_BACKUP)
+		ret = CommitData(a_nIdx);
+		if(likely(ret != -ENOBUFS && ret != -E_Q_NOSPC) || m_unCurWriteMbufIdx == 0)
+			return ret;
+
+		ret = WaitWriteSpace(&m_stEpochSlot[0], a_nIdx, ret, unDeadline);
+		if(ret < 0)
+			return ret;
+	}
+}
+
+/*!
+ * \brief Reserve Memory Buffer to Write Data in Place
+ * \details m_pstDataMemPool 에서 Memory Buffer 를 할당 받아 데이터를 직접 기록할 수 있는 주소를 넘겨준다.
+ * 별도의 Buffer 에서 Memory Buffer 로 복사하는 과정이 없으며, 기록 후 Commit() 혹은 Abort() 를 호출해야 한다.
+ * 한개의 Memory Buffer 에 들어가지 않는 Size 는 Segment List 를 사용하는 Reserve() 를 사용한다.
+ * Data Size 가 들어가는 가장 작은 Size Class 의 Memory Buffer 를 할당한다.
+ * \param a_pszBuff is Buffer Pointer to Write Data
+ * \param a_nSize is Size of Data (<= 가장 큰 Size Class 의 Segment Size)
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Size Over; Already Reserved
+ *   - -E_Q_NOSPC there is no space for alloc;
+ */
+int CLQManager::Reserve( char **a_pszBuff, int a_nSize )
+{
+	int ret = 0;
+	MBUF_CLASS_TABLE *pstTbl = m_pstMbufClass;
+
+	if(unlikely(pstTbl->nCnt == 0 || (uint32_t)a_nSize > pstTbl->stClass[pstTbl->nCnt - 1].unSegSize))
+	{
+		SetErrorMsg("Reserve Size Over %u, [Size:%d]", 
+					(pstTbl->nCnt == 0) ? 0 : pstTbl->stClass[pstTbl->nCnt - 1].unSegSize, a_nSize);
+		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	if(unlikely(m_pstReserveMbuf != NULL))
+	{
+		SetErrorMsg("Memory Buffer is Already Reserved");
+		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	ret = AllocDataMbuf(a_nSize, &m_pstReserveMbuf);
+	if(unlikely(ret < 0))
+	{
+		m_pstReserveMbuf = NULL;
+		return ret;
+	}
+
+	*a_pszBuff = rte_pktmbuf_mtod(m_pstReserveMbuf, char *);
+
+	return 0;
+}
+
+/*!
+ * \brief Reserve Memory Buffer Chain to Write Data in Place (Segment List)
+ * \details 데이터의 Size 만큼 Memory Buffer Chain 을 할당 받아 각 Segment 의 주소와 길이를 넘겨준다.
+ * 기록 후 Commit() 혹은 Abort() 를 호출해야 한다.
+ * \param a_pstIov is Segment List to Write Data
+ * \param a_pnIovCnt is Size of Segment List (입력), Count of Segment (출력)
+ * \param a_nSize is Size of Data
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Already Reserved
+ *   - -E_Q_NOSPC there is no space for alloc;
+ *   - -E_Q_NOMEM out of memory; Segment List Size < Count of Segment
+ */
+int CLQManager::Reserve( struct iovec *a_pstIov, int *a_pnIovCnt, int a_nSize )
+{
+	int ret = 0;
+
+	if(unlikely(m_pstReserveMbuf != NULL))
+	{
+		SetErrorMsg("Memory Buffer is Already Reserved");
+		RTE_LOG(ERR, MBUF, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	ret = AllocDataMbuf(a_nSize, &m_pstReserveMbuf);
+	if(unlikely(ret < 0))
+	{
+		m_pstReserveMbuf = NULL;
+		return ret;
+	}
+
+	//Segment List 가 부족하면 할당한 Memory Buffer 를 해제
+	ret = GetMbufIov(m_pstReserveMbuf, a_pstIov, a_pnIovCnt);
+	if(unlikely(ret < 0))
+	{
+		SetErrorMsg("Over Segment List Size, seg_cnt : %d", *a_pnIovCnt);
+		rte_pktmbuf_free(m_pstReserveMbuf);
+		m_pstReserveMbuf = NULL;
+		return ret;
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Commit Reserved Memory Buffer to Queue
+ * \details Reserve() 로 할당 받아 기록을 마친 Memory Buffer 를 Queue 에 입력한다.
+ * -E_Q_NOSPC 로 실패한 경우 Memory Buffer 는 유지되므로 Commit() 을 다시 호출하여 재시도 할 수 있다.
+ * \param a_nIdx is Index of Write Ring
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
+ *   - -E_Q_NOSPC there is no space for enqueue;
+ *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_MMAP MMap Function Error
+ *   - -E_Q_TRUN File Truncate Error
+ *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_BACKUP Enqueued, but Backup File Write Error (Do not retry)
+ */
+int CLQManager::Commit( int a_nIdx )
+{
+	if(m_pstReserveMbuf != NULL)
+	{
+		if(unlikely(m_unCurWriteMbufIdx >= DEF_MEM_BUF_1024))
+			return -E_Q_NOMEM;
+
+		m_pstWriteMbuf[m_unCurWriteMbufIdx++] = m_pstReserveMbuf;
+		m_pstReserveMbuf = NULL;
+	}
+
+	return CommitData(a_nIdx);
+}
+
+/*!
+ * \brief Abort Reserved Memory Buffer
+ * \details Reserve() 로 할당 받은 Memory Buffer 를 Memory Pool 로 돌려 준다.
+ * \param None
+ * \return None
+ */
+void CLQManager::Abort()
+{
+	if(m_pstReserveMbuf != NULL)
+	{
+		rte_pktmbuf_free(m_pstReserveMbuf);
+		m_pstReserveMbuf = NULL;
+	}
+}
+
+/*!
+ * \brief Send RTS To Consumer Process
+ * \details Ring 에서 현재 Sleep 상태인 Consumer Process 로 RTS 전송
+ * Consumer 배열을 순회하지 않고 cons.sleep_mask 만 확인하며, 모든 Consumer 가 깨어 있을 경우
+ * RTS 를 생략한다. Sleep Flag 를 1 -> 0 으로 변경한 Producer 만 RTS 를 전송하므로
+ * Consumer 가 Sleep 상태로 전환될 때마다 한번만 RTS 가 전송된다.
+ * Broadcast Queue 는 모든 Subscriber 가 데이터를 읽으므로 Sleep 상태인 모든 Consumer 에게 전송한다.
+ * \param a_pstRing is Ring Pointer
+ * \param a_nIdx is Index of the Producer (RTS Sent/Suppressed Count 기록)
+ * \return 0 on Success
+ */
+int CLQManager::SendRTS(struct rte_ring *a_pstRing, int a_nIdx)
+{
+	//Signal Value
+	union sigval sv;
+	struct rte_ring_cons_info *pstConsInfo = NULL;
+	struct rte_ring_prod_info *pstProdInfo = &(a_pstRing->prod.prod_info[a_nIdx]);
+	uint64_t unMask = 0;
+	int nConsIdx = 0;
+
+	//Enqueue 결과(prod.tail)의 Store 이후에 Sleep Mask 를 Load 하도록 보장
+	rte_mb();
+
+	unMask = a_pstRing->cons.sleep_mask;
+	if(likely(unMask == 0))
+	{
+		__sync_fetch_and_add(&(pstProdInfo->rts_suppressed), 1);
+		return 0;
+	}
+
+	for(; unMask != 0; unMask &= (unMask - 1))
+	{
+		//Find Sleep Consumer Process
+		nConsIdx = __builtin_ctzll(unMask);
+		pstConsInfo = &(a_pstRing->cons.cons_info[nConsIdx]);
+
+		//Sleep Flag 보다 Mask 를 먼저 해제해야 Consumer 가 다시 Sleep 상태가 되었을 때 Mask 가 유실되지 않음
+		__sync_fetch_and_and(&(a_pstRing->cons.sleep_mask), ~(1ULL << nConsIdx));
+
+		//다른 Producer 가 이미 깨운 경우
+		if(rte_atomic32_cmpset(&(pstConsInfo->sleep), 1, 0) == 0)
+		{
+			__sync_fetch_and_add(&(pstProdInfo->rts_suppressed), 1);
+		}
+		else
+		{
+			if(pstConsInfo->wait_mode == DEF_WAIT_MODE_FUTEX)
+			{
+				WakeFutex(pstConsInfo);
+			}
+			else
+			{
+				sv.sival_ptr = a_pstRing;
+				sigqueue(pstConsInfo->pid, SIGRTMIN + 1 + nConsIdx, sv);
+			}
+			__sync_fetch_and_add(&(pstProdInfo->rts_sent), 1);
+		}
+
+		//한 Consumer 만 깨우면 되는 경우
+		if(!(a_pstRing->flags & RING_F_BCAST))
+			break;
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Wake Consumer Process Parked on Futex Word
+ * \details Sleep Flag 를 1 -> 0 으로 변경한 Producer 만 호출한다. (SendRTS)
+ * \param a_pstConsInfo is Consumer Info
+ * \return None
+ */
+void CLQManager::WakeFutex(struct rte_ring_cons_info *a_pstConsInfo)
+{
+	rte_atomic32_inc(a_pstConsInfo->futex_ptr);
+	FutexWake(a_pstConsInfo->futex_ptr);
+}
+
+/*!
+ * \brief Park Producer on Futex Word of Write Ring until Consumer frees Space
+ * \details Waiter 로 등록하기 전에 Futex Word 를 읽어두므로 그 사이 Consumer 가 Word 를 증가시키면 FUTEX_WAIT 는 즉시 Return 한다.
+ * Ring Full(-ENOBUFS) 이면 등록 후 한번 더 Low Watermark 를 확인하고, Memory Pool 부족(-E_Q_NOSPC) 이면
+ * 다른 Ring 의 Consumer 가 반환할 수도 있으므로 최대 DEF_PROD_WAIT_USEC 만 대기한다.
+ * 대기 중에는 Epoch Guard 를 잡고 있으므로 Detach 는 최대 DEF_PROD_WAIT_USEC 만큼 지연된다.
+ * \param a_pstSlot is Epoch Slot of Caller Thread
+ * \param a_nIdx is Index of m_stWriteRingInfo Array
+ * \param a_nErr is Error of Write (-ENOBUFS, -E_Q_NOSPC)
+ * \param a_unDeadline is Deadline (TSC Cycles, UINT64_MAX : No Timeout)
+ * \return
+ *   - 0 Retry Write
+ *   - -E_Q_INVAL Invalid Ring Pointer
+ *   - -E_Q_TIMEDOUT Deadline Passed
+ */
+int CLQManager::WaitWriteSpace(EPOCH_SLOT *a_pstSlot, int a_nIdx, int a_nErr, uint64_t a_unDeadline)
+{
+	int32_t nSeq = 0;
+	uint64_t unNow = 0;
+	uint64_t unWait = 0;
+	uint64_t unHz = rte_get_tsc_hz();
+	struct timespec tWait;
+	struct rte_ring *pstRing = NULL;
+
+	unNow = rte_rdtsc();
+	if(unNow >= a_unDeadline)
+		return -E_Q_TIMEDOUT;
+
+	unWait = RTE_MIN(a_unDeadline - unNow, (uint64_t)DEF_PROD_WAIT_USEC * unHz / 1000000);
+	tWait.tv_sec = unWait / unHz;
+	tWait.tv_nsec = (unWait % unHz) * 1000000000 / unHz;
+
+	CLQEpochGuard clsGuard(a_pstSlot, &m_unTopoEpoch);
+
+	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
+	if(unlikely(pstRing == NULL))
+		return -E_Q_INVAL;
+
+	nSeq = rte_atomic32_read(&pstRing->cons.prod_futex);
+	rte_atomic32_inc(&pstRing->cons.prod_waiters);
+	//Waiter Count 의 Store 이후에 Ring 의 cons.tail 을 Load 하도록 보장 (WakeProducer 의 Barrier 와 짝)
+	rte_mb();
+
+	//등록 전에 Consumer 가 이미 Low Watermark 까지 비웠으면 대기하지 않음
+	if(a_nErr == -ENOBUFS && rte_ring_free_count(pstRing) >= pstRing->cons.prod_wake_free)
+	{
+		rte_atomic32_dec(&pstRing->cons.prod_waiters);
+		return 0;
+	}
+
+	FutexWait(&pstRing->cons.prod_futex, nSeq, &tWait);
+	rte_atomic32_dec(&pstRing->cons.prod_waiters);
+
+	return 0;
+}
+
+/*!
+ * \brief Wake Producers Parked on Ring
+ * \details ReadComplete / Free 후 호출한다. 대기중인 Producer 가 없거나 빈 공간이 Low Watermark 미만이면
+ * Waiter Count 만 읽고 Return 하므로 Consumer 의 일반 경로에는 System Call 이 없다.
+ * Consumer 는 cons.tail 의 Store 와 Waiter Count 의 Load 사이에, Producer 는 Waiter Count 의 Store 와 빈 공간 확인 사이에
+ * Memory Barrier 를 두므로 둘 중 하나는 반드시 상대의 Store 를 보고 Wakeup 을 놓치지 않는다. (Sleep Flag 와 같은 방식)
+ * \param a_pstRing is Ring which Consumer freed Space
+ * \return None
+ */
+void CLQManager::WakeProducer(struct rte_ring *a_pstRing)
+{
+	//Dequeue 결과(cons.tail)의 Store 이후에 Waiter Count 를 Load 하도록 보장
+	rte_mb();
+
+	if(likely(!rte_ring_prod_wake_needed(a_pstRing)))
+		return;
+
+	rte_atomic32_inc(&a_pstRing->cons.prod_futex);
+	FutexWakeAll(&a_pstRing->cons.prod_futex);
+}
+
+/*!
+ * \brief Set High / Low Watermark of Ring
+ * \details Queue Definition 의 HIGH_WM, LOW_WM(Ring Size 대비 %) 을 Ring 의 Watermark 로 변환하여 설정한다.
+ * High Watermark 를 넘으면 Enqueue 는 -EDQUOT 를 Return 하며(입력은 성공), Producer 는 RaiseWatermark 로 Event 를 발생시킨다.
+ * \param a_pstRing is Ring Pointer
+ * \param a_unHighWm is High Watermark (%, 1 ~ 99)
+ * \param a_unLowWm is Low Watermark (%, 0 : High Watermark 의 절반)
+ * \return
+ *   - 0 on Success
+ *   - -E_Q_INVAL Invalid Watermark
+ */
+int CLQManager::SetRingWatermark(struct rte_ring *a_pstRing, uint32_t a_unHighWm, uint32_t a_unLowWm)
+{
+	uint32_t unHigh = 0;
+	uint32_t unLow = 0;
+
+	if(a_unLowWm == 0)
+		a_unLowWm = a_unHighWm / 2;
+
+	unHigh = (uint32_t)((uint64_t)a_pstRing->prod.size * a_unHighWm / 100);
+	unLow = (uint32_t)((uint64_t)a_pstRing->prod.size * a_unLowWm / 100);
+
+	if(unlikely(a_unHighWm >= 100 || unHigh == 0 || unLow >= unHigh))
+	{
+		SetErrorMsg("Invalid Watermark of Ring %s (High %u%%, Low %u%%)", a_pstRing->name, a_unHighWm, a_unLowWm);
+		RTE_LOG (ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Low Watermark 는 High Watermark 보다 작아야 하므로 High 를 먼저 설정
+	rte_ring_set_water_mark(a_pstRing, unHigh);
+	rte_ring_set_low_water_mark(a_pstRing, unLow);
+
+	return 0;
+}
+
+/*!
+ * \brief Find Index of Write Ring
+ * \details Watermark Event 가 발생했을 때만 호출되므로 Write Ring Table 을 순차 검색한다.
+ * \param a_pstRing is Ring Pointer
+ * \return Index of m_stWriteRingInfo Array, -1 : Not Found (Util 에서 직접 입력한 Ring)
+ */
+int CLQManager::FindWriteRing(struct rte_ring *a_pstRing)
+{
+	for(uint32_t i = 0; i < m_unWriteRingCount; i++)
+	{
+		if(m_stWriteRingInfo[i].pstRing == a_pstRing)
+			return i;
+	}
+
+	return -1;
+}
+
+/*!
+ * \brief Check Low Watermark and Throttle before Enqueue (Producer)
+ * \details High Watermark Event 를 전달한 Write Ring 이 Consumer 에 의해 Low Watermark 까지 비워졌으면(rte_ring_wm_leave)
+ * Low Watermark Event 를 전달하고, 아직 비워지지 않았으면 Throttling 시간만큼 대기한다.
+ * 여러 Thread 가 동시에 확인하더라도 Event 는 한번만 전달된다.
+ * \param a_pstRing is Write Ring
+ * \return None
+ */
+void CLQManager::CheckWatermark(struct rte_ring *a_pstRing)
+{
+	int nIdx = FindWriteRing(a_pstRing);
+
+	if(nIdx < 0 || m_stWriteRingInfo[nIdx].unWmOver == 0)
+		return;
+
+	if(LeaveWatermark(nIdx, a_pstRing) == false && m_unWmThrottleUsec > 0)
+		usleep(m_unWmThrottleUsec);
+}
+
+/*!
+ * \brief Raise Low Watermark Event (Producer)
+ * \details Consumer 가 Ring 의 상태(wm_over) 를 해제했으면 Process 의 상태를 해제하고 Low Watermark Event 를 전달한다.
+ * \param a_nIdx is Index of m_stWriteRingInfo Array
+ * \param a_pstRing is Write Ring
+ * \return true : Ring 이 Low Watermark 까지 비워짐, false : 아직 High Watermark 를 넘은 상태
+ */
+bool CLQManager::LeaveWatermark(int a_nIdx, struct rte_ring *a_pstRing)
+{
+	if(a_pstRing->prod.wm_over != 0)
+		return false;
+
+	if(__sync_bool_compare_and_swap(&m_stWriteRingInfo[a_nIdx].unWmOver, 1, 0))
+	{
+		__sync_fetch_and_sub(&m_unWmOverCnt, 1);
+
+		if(m_pfuncWatermark != NULL)
+			m_pfuncWatermark(a_nIdx, DEF_WM_EVENT_LOW, rte_ring_count(a_pstRing), m_pWmArgs);
+	}
+
+	return true;
+}
+
+/*!
+ * \brief Poll Low Watermark of All Write Rings
+ * \details High Watermark Event 이후 다른 Write Ring 으로 우회하여 해당 Ring 에 입력하지 않는 Producer 는
+ * 이 함수를 주기적으로 호출하여 Low Watermark Event 를 전달받는다.
+ * \param None
+ * \return Count of Write Rings still over High Watermark
+ */
+int CLQManager::PollWatermark()
+{
+	int nCnt = 0;
+	struct rte_ring *pstRing = NULL;
+
+	if(likely(m_unWmOverCnt == 0))
+		return 0;
+
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
+	for(uint32_t i = 0; i < m_unWriteRingCount; i++)
+	{
+		pstRing = m_stWriteRingInfo[i].pstRing;
+		if(pstRing == NULL || m_stWriteRingInfo[i].unWmOver == 0)
+			continue;
+
+		if(LeaveWatermark(i, pstRing) == false)
+			nCnt++;
+	}
+
+	return nCnt;
+}
+
+/*!
+ * \brief Raise High Watermark Event (Producer)
+ * \details Enqueue 가 -EDQUOT 를 Return 하면 호출한다. Ring 의 상태(wm_over) 와 Shared Memory 의 Counter(wm_high_cnt) 를 변경하고,
+ * Process 에서 처음 확인한 Thread 가 High Watermark Event 를 전달한다.
+ * \param a_pstRing is Write Ring
+ * \return None
+ */
+void CLQManager::RaiseWatermark(struct rte_ring *a_pstRing)
+{
+	int nIdx = 0;
+
+	rte_ring_wm_enter(a_pstRing);
+
+	nIdx = FindWriteRing(a_pstRing);
+	if(nIdx < 0)
+		return;
+
+	if(__sync_bool_compare_and_swap(&m_stWriteRingInfo[nIdx].unWmOver, 0, 1))
+	{
+		__sync_fetch_and_add(&m_unWmOverCnt, 1);
+
+		if(m_pfuncWatermark != NULL)
+			m_pfuncWatermark(nIdx, DEF_WM_EVENT_HIGH, rte_ring_count(a_pstRing), m_pWmArgs);
+	}
+}
+
+/*!
+ * \breif Send RTS For Command Send
+ * \details Ring 에 연결 된 Process 에게 RTS 전송
+ * \param a_pstRing is Ring Pointer
+ * \return 0 on Success
+ */
+int CLQManager::SendRTSCommand(struct rte_ring *a_pstRing)
+{
+	//Signal Value
+	union sigval sv;
+	int ret = 0;
+
+	//Futex Mode 의 Consumer 는 Sleep Flag 와 관계 없이 Futex Word 를 변경 후 깨운다
+	if(a_pstRing->cons.cons_info[0].wait_mode == DEF_WAIT_MODE_FUTEX)
+	{
+		rte_atomic32_inc(a_pstRing->cons.cons_info[0].futex_ptr);
+		FutexWake(a_pstRing->cons.cons_info[0].futex_ptr);
+		return 0;
+	}
+
+	sv.sival_ptr = a_pstRing;
+	ret = sigqueue(a_pstRing->cons.cons_info[0].pid, SIGRTMIN, sv);
+	if(ret < 0)
+		return -errno;
+
+	return 0;
+}
+
+/*!
+ * \brief enqueue Data
+ * \details Data 를 Ring 에 입력
+ * \param a_pstRing is Ring
+ * \param a_nCnt is Enqueue Count
+ * \param a_nIdx is Index of the Producer
+ * \param a_punSeq is Ring Position of the First Enqueued Data (Output, BackupWriteData 에 전달)
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC there is no memory buffer
+ */
+int CLQManager::EnqueueData(struct rte_ring *a_pstRing, int a_nCnt, int a_nIdx, uint32_t *a_punSeq)
+{
+	int ret = 0;
+	struct rte_mbuf *pSeg = NULL;
+
+	//High Watermark 를 넘은 Write Ring 이 있을 때만 Low Watermark 와 Throttling 을 확인
+	if(unlikely(m_unWmOverCnt > 0))
+		CheckWatermark(a_pstRing);
+
+	if(a_pstRing->flags & RING_F_BCAST)
+	{
+		ret = EnqueueBcast(a_pstRing, m_pstWriteMbuf, a_nCnt, a_nIdx, m_bBackup, a_punSeq);
+		if(unlikely(ret == -EDQUOT))
+		{
+			RaiseWatermark(a_pstRing);
+			ret = 0;
+		}
+		return ret;
+	}
+
+	//Backup 이 끝날 때까지 Consumer 가 Memory Buffer 를 반환하지 않도록 모든 Segment 의 Reference 를 보유
+	if(m_bBackup)
+	{
+		for(int i = 0; i < a_nCnt ; i++)
+		{
+			for(pSeg = m_pstWriteMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+				rte_mbuf_refcnt_update(pSeg, 1);
+		}
+	}
+
+	//Enqueue Data in Ring (Backup 은 Producer Info 가 아닌 입력한 위치를 사용)
+	ret = rte_ring_mp_enqueue_bulk_pos(
+			a_pstRing, (void**)&m_pstWriteMbuf, a_nCnt, RTE_RING_QUEUE_FIXED, a_nIdx, a_punSeq);
+
+	//입력은 성공하였고 High Watermark 를 넘음
+	if(unlikely(ret == -EDQUOT))
+	{
+		RaiseWatermark(a_pstRing);
+		ret = 0;
+	}
+
+	if(unlikely(ret < 0) && m_bBackup)
+	{
+		for(int i = 0; i < a_nCnt ; i++)
+		{
+			for(pSeg = m_pstWriteMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+				rte_mbuf_refcnt_update(pSeg, -1);
+		}
+	}
+
+
+#if 0
+	//Enqueue Failed
+	if( ret != 0)
 	{
-		SendRTS(pstRing);
+		for(int i = 0; i < a_nCnt ; i++)
+		{
+			//Data Buffer Free
+			rte_pktmbuf_free(m_pstWriteMbuf[i]);
+		}
+		return -E_Q_NOSPC;
 	}
+#endif
+	return ret;
+}
 
-	ret = InsertData(a_pszData, a_nSize) ;
+/*!
+ * \brief Enqueue Data to Broadcast Ring
+ * \details Slot 을 예약한 뒤 데이터를 읽을 Subscriber 수를 각 Memory Buffer 의 Reference Count 로 설정하고 입력한다.
+ * Subscriber 는 데이터를 복사하지 않고 같은 Memory Buffer 를 읽으며, 마지막 Subscriber 가 해제(rte_pktmbuf_free)할 때 반환된다.
+ * a_bHold 가 true 이면 Producer 도 Reference 를 하나 보유하며, Backup 후 BackupWriteData 에서 반환한다.
+ * \param a_pstRing is Broadcast Ring
+ * \param a_pstMbuf is Memory Buffer Array
+ * \param a_unCnt is Enqueue Count
+ * \param a_nIdx is Index of the Producer
+ * \param a_bHold is Hold a Reference until Backup (Backup Mode)
+ * \param a_punSeq is Ring Position of the First Enqueued Data (Output, NULL : 사용하지 않음)
+ * \return 
+ *   - 0 on Success
+ *   - -EDQUOT Enqueued, but High Watermark is exceeded
+ *   - -ENOBUFS Not enough room in the ring
+ */
+int CLQManager::EnqueueBcast(struct rte_ring *a_pstRing, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt, int a_nIdx, bool a_bHold, uint32_t *a_punSeq)
+{
+	int ret = 0;
+	uint32_t unProdHead = 0;
+	unsigned unSubsCnt = 0;
+	unsigned unRefCnt = 0;
+	struct rte_mbuf *pSeg = NULL;
+
+	ret = rte_ring_mp_enqueue_reserve(a_pstRing, a_unCnt, a_nIdx, &unProdHead);
 	if(unlikely(ret < 0))
 	{
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[a_nIdx].unFailCnt++;
+		//Join 중 종료된 Subscriber 가 Tail 을 잡고 있으면 정리 (다음 입력부터 공간 확보)
+		if(ret == -ENOBUFS)
+			rte_ring_bcast_reap(a_pstRing);
+
 		return ret;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				pstRing
-				,m_unCurWriteMbufIdx
-				,m_stWriteRingInfo[a_nIdx].nIdx ) ;
+	if(a_punSeq != NULL)
+		*a_punSeq = unProdHead;
 
-	if(unlikely(ret < 0))
+	unSubsCnt = rte_ring_bcast_count(a_pstRing, unProdHead);
+	unRefCnt = unSubsCnt + (a_bHold ? 1 : 0);
+
+	if(likely(unRefCnt > 0))
 	{
-		//Free Memory Buffer
-		rte_pktmbuf_free(m_pstWriteMbuf[0]);
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[a_nIdx].unFailCnt++;
-		return ret;
+		for(uint32_t i = 0; i < a_unCnt; i++)
+		{
+			for(pSeg = a_pstMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+				rte_mbuf_refcnt_set(pSeg, unRefCnt);
+		}
 	}
 
-	//Backup Data
-	if(m_bBackup)
+	rte_ring_mp_enqueue_publish(a_pstRing, (void**)a_pstMbuf, a_unCnt, unProdHead, a_nIdx);
+
+	//읽을 Subscriber 가 없는 Slot 은 바로 반환
+	if(unlikely(unSubsCnt == 0))
 	{
-		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx );
-		if(ret < 0)
+		if(unRefCnt == 0)
 		{
-			SetErrorMsg("Write Data Backup Failed");
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			for(uint32_t i = 0; i < a_unCnt; i++)
+				rte_pktmbuf_free(a_pstMbuf[i]);
 		}
+
+		rte_ring_bcast_retire(a_pstRing);
 	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
-	
-	SendRTS(pstRing);
+	//Slot 예약은 Watermark 를 확인하지 않으므로 입력 후 확인 (rte_ring_mp_enqueue_bulk_idx 와 같이 -EDQUOT)
+	if(unlikely(rte_ring_count(a_pstRing) > a_pstRing->prod.watermark))
+		return -EDQUOT;
 
-	return ret;
+	return 0;
 }
 
-
 /*!
- * \brief Enqueue Data (HashFunction)
- * \details Enqueue Data and Send RTS to Consumer 
- *          Hash 함수를 이용하여서 Write 할 Queue 를 선택
- * \param a_pszData is Data Pointer to Insert 
- * \param a_nSize is Size of Data
- * \param a_pArgs is Arguments for Hash Function
+ * \brief Init Backup Files
+ * \details Queue 의 Backup 을 위하여서 Backup File 을 초기화
+ * Backup File 이 없으면 새로 생성하며, Record Offset Index 의 크기는 Ring 의 크기와 같다.
+ * 형식(Magic, Size)이 다른 Backup File 은 복구되지 않은 데이터가 있을 수 있으므로 초기화하지 않고 실패한다.
+ * Backup 중에 File 크기가 변경되지 않도록 File 전체를 미리 할당(posix_fallocate)한다.
+ * Read Ring 은 Backup File 대신 Consumer Checkpoint File 을 초기화한다. (InitCheckpointFile)
+ * \param a_pstRing is Ring 
+ * \param a_szFileName is Name of Backup File
+ * \param a_nType is Ring Type (Read:0/ Write:1)
+ * \param a_nIdx is Index of the Process in the Queue
  * \return 
  *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
- *   - -E_Q_NOMEM out of memory;
+ *   - -E_Q_NOENT File Open Error
  *   - -E_Q_MMAP MMap Function Error
  *   - -E_Q_TRUN File Truncate Error
  *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
+ *   - -E_Q_INVAL Invalid Format of Backup File
  */
-int CLQManager::WriteDataHash( char *a_pszData, int a_nSize, void *a_pArgs )
+int CLQManager::InitBackupFile( struct rte_ring *a_pstRing, char *a_szFileName, int a_nType, int a_nIdx )
 {
 	int ret = 0;
-	//Idx of Write Ring
-	int idx = m_pfuncHash(a_pArgs);
-	//Ring Pointer
-	struct rte_ring *pstRing = NULL;
+	char szFileName[DEF_MEM_BUF_1024];
+	uint32_t unMask = a_pstRing->prod.size - 1;
+	uint64_t unDefaultSize = BACKUP_FILE_SIZE(unMask, DEF_BK_LOG_SIZE);
+	struct stat bk_file_stat;
+	//struct flock => { l_type, l_whence, l_start, l_len};
+	//flock for Backup Info Update
+	struct flock wr_info_lock = { F_WRLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
+	//funlock for Backup Info
+	struct flock wr_info_un_lock = { F_UNLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
 
-	//Check Idx Error
-	if(unlikely(idx < 0))
-		return -E_Q_INVAL;
-	
-	if(unlikely(idx > m_unWriteRingCount))
-		return -E_Q_INVAL;
+	struct rte_ring_backup_info *pstRingBackup = NULL;
+	BACKUP_INFO *pstBackup = NULL;
 
-	pstRing = m_stWriteRingInfo[idx].pstRing;
+	//Consumer 는 Backup File 이 아닌 Checkpoint File 에 Cursor 를 기록
+	if(a_nType == DEF_RING_TYPE_READ)
+		return InitCheckpointFile(a_pstRing, a_szFileName, a_nIdx);
 
-	if(unlikely(pstRing == NULL))
+	//Init Backup File Info
+	pstRingBackup = &(a_pstRing->prod.prod_info[a_nIdx].backup_info);
+
+	//이전 Process 의 Dirty Range 초기화 (Group Commit)
+	pstRingBackup->dirty_cnt = 0;
+
+	memset(szFileName, 0x00, sizeof(szFileName));
+
+	sprintf(szFileName, "%s/%s.bak", m_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_szFileName);
+	printf("szFile Name %s\n", szFileName);
+	pstRingBackup->fd = open(szFileName, O_RDWR|O_CREAT, 0660);
+	if(unlikely(pstRingBackup->fd == -1))
 	{
-		SetErrorMsg("Queue Idx[%d] is NULL", idx);
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
-		return -E_Q_INVAL;
+		SetErrorMsg("Backup File Open Error");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_NOENT;
 	}
 
-	//Fail 이 일정 Count 의 배수일 때
-	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
-	//다시 한번 Signal 을 전송
-	if( unlikely((m_stWriteRingInfo[idx].unFailCnt % DEF_MAX_FAIL_CNT) == 0 ))
+	//File Lock For Init
+	if( fcntl(pstRingBackup->fd, F_SETLKW, &wr_info_lock) < 0 )
 	{
-		SendRTS(pstRing);
+		SetErrorMsg("File Lock Failed errno : %d", errno);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_FLOCK;
 	}
 
-	ret = InsertData(a_pszData, a_nSize);
-	if(unlikely(ret < 0))
+	if( unlikely(fstat(pstRingBackup->fd, &bk_file_stat) < 0) )
 	{
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[idx].unFailCnt++;
-		return ret;
+		SetErrorMsg("Stat Function Error");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_NOENT;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				pstRing
-				,m_unCurWriteMbufIdx
-				,m_stWriteRingInfo[idx].nIdx ) ;
+	//기존 Backup File 의 Header 를 읽어 크기를 결정
+	if( (uint64_t)bk_file_stat.st_size >= sizeof(BACKUP_INFO) )
+	{
+		pstBackup = (BACKUP_INFO*)mmap(NULL, sizeof(BACKUP_INFO), PROT_READ, MAP_SHARED, pstRingBackup->fd, 0);
+		if(pstBackup == MAP_FAILED)
+		{
+			SetErrorMsg("Header mmap Failed errno : %d", errno);
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			close(pstRingBackup->fd);
+			return -E_Q_MMAP;
+		}
 
-	if(unlikely(ret < 0))
+		if( pstBackup->unMagic == DEF_BK_MAGIC &&
+			(pstBackup->unLogSize % DEF_BK_SEG_SIZE) == 0 &&
+			(uint64_t)bk_file_stat.st_size == BACKUP_FILE_SIZE(pstBackup->unMask, pstBackup->unLogSize) )
+		{
+			unMask = pstBackup->unMask;
+			unDefaultSize = bk_file_stat.st_size;
+		}
+		else
+		{
+			//이전 형식의 Backup File 을 초기화하면 복구하지 않은 데이터를 잃으므로 실패 처리
+			munmap(pstBackup, sizeof(BACKUP_INFO));
+			SetErrorMsg("Backup File (%s) Format is Invalid, Restore or Remove it", szFileName);
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			close(pstRingBackup->fd);
+			return -E_Q_INVAL;
+		}
+
+		munmap(pstBackup, sizeof(BACKUP_INFO));
+	}
+	else if( bk_file_stat.st_size != 0 )
 	{
-		//Free Memory Buffer
-		rte_pktmbuf_free(m_pstWriteMbuf[0]);
-		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[idx].unFailCnt++;
-		return ret;
+		SetErrorMsg("Backup File (%s) Size %lu is Invalid, Restore or Remove it", szFileName, (uint64_t)bk_file_stat.st_size);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_INVAL;
 	}
 
-	//Backup Data
-	if(m_bBackup)
+	//새로운 Backup File 생성
+	if( bk_file_stat.st_size == 0 )
 	{
-		ret = BackupWriteData( pstRing, m_stWriteRingInfo[idx].nIdx ) ;
-		if(ret < 0)
+		if(ftruncate(pstRingBackup->fd, 0) < 0 || ftruncate(pstRingBackup->fd, unDefaultSize) < 0)
 		{
-			SetErrorMsg("Write Data Backup Failed");
+			SetErrorMsg("ftruncate Function Error errno : %d", errno);
 			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			close(pstRingBackup->fd);
+			return -E_Q_TRUN;
 		}
 	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
-	
-	SendRTS(pstRing);
-	
-	return ret;
-}
-
-/*!
- * \brief Write Data to Ring
- * \details Backup File 을 이용하여서 Queue 를 복구하는 기능을 위한 함수
- * \param a_pstRing is Ring Pointer
- * \param a_pszData is Data Pointer to Insert 
- * \param a_nSize is Size of Data
- * \return
- *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
- *   - -E_Q_NOMEM out of memory;
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
- */
-int CLQManager::WriteData( struct rte_ring *a_pstRing, char *a_pszData, int a_nSize )
-{
-	int ret = 0;
+	//Write 중에 Disk Block 을 할당하지 않도록 File 전체를 미리 할당 (이미 할당된 경우 변경 없음)
+	ret = posix_fallocate(pstRingBackup->fd, 0, unDefaultSize);
+	if(ret != 0)
+	{
+		SetErrorMsg("fallocate Function Error errno : %d", ret);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_TRUN;
+	}
 
-	ret = InsertData(a_pszData, a_nSize) ;
-	if(unlikely(ret < 0))
+	//mmap File 
+	pstRingBackup->backup = mmap(NULL, unDefaultSize, PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
+	if(pstRingBackup->backup == MAP_FAILED)
 	{
-		m_unCurWriteMbufIdx = 0;
-		return ret;
+		SetErrorMsg("mmap Failed errno : %d", errno);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_MMAP;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				a_pstRing
-				,m_unCurWriteMbufIdx
-				,0) ;
+	pstRingBackup->size = unDefaultSize;
+	pstRingBackup->mask = unMask;
+	pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
 
-	if(unlikely(ret < 0))
+	//Init Backup Info
+	if( bk_file_stat.st_size == 0 )
 	{
-		//Free Memory Buffer
-		rte_pktmbuf_free(m_pstWriteMbuf[0]);
-		m_unCurWriteMbufIdx = 0;
-		return ret;
+		memset(pstBackup, 0x00, sizeof(BACKUP_INFO));
+		pstBackup->unMagic = DEF_BK_MAGIC;
+		pstBackup->unMask = unMask;
+		pstBackup->unLogSize = DEF_BK_LOG_SIZE;
+		pstBackup->unLogTail = 0;
 	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
+	//Insert Process Info
+	pstBackup->unProdCnt = a_pstRing->prod.prod_count;
+	memset( &(pstBackup->stProdInfo[a_nIdx]), 0x00, sizeof(PROD_INFO));
+	sprintf(pstBackup->stProdInfo[a_nIdx].strName, "%s_%d", m_szProcName, m_nInstanceID);
 
-	return ret;
-}
+	//Sync mmap <-> File
+	msync(pstBackup, sizeof(BACKUP_INFO), MS_SYNC);
+
+	if(fcntl(pstRingBackup->fd, F_SETLK, &wr_info_un_lock) < 0)
+	{
+		SetErrorMsg("File unlock Failed");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_FLOCK;
+	}
 
+	return 0;
+}
+ 
 /*!
- * \brief Commit Data to Queue
- * \details m_pstWriteMbuf 에 저장된 데이터를 Queue 에 Insert
- *          Hash Function 을 이용한 Queue 의 선택 기능은 지원하지 않음
- * \param a_nIdx is Index of m_stWriteRingInfo Array 
+ * \brief Init Consumer Checkpoint File
+ * \details Consumer 의 Cursor(Tail) 를 기록할 Checkpoint File ([Queue Name].ckpt) 을 초기화
+ * Checkpoint File 이 없거나 형식(Magic, Size)이 다를 경우 새로 생성한다.
+ * \param a_pstRing is Ring 
+ * \param a_szFileName is Name of Queue
+ * \param a_nIdx is Index of the Consumer in the Queue
  * \return 
  *   - 0 on Success
- *   - -E_Q_INVAL Invalid Index; Invalid Ring Pointer;
- *   - -E_Q_NOSPC there is no space for alloc; there is no space for enqueue;
+ *   - -E_Q_NOENT File Open Error
  *   - -E_Q_MMAP MMap Function Error
  *   - -E_Q_TRUN File Truncate Error
  *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
  */
-int CLQManager::CommitData(int a_nIdx)
+int CLQManager::InitCheckpointFile( struct rte_ring *a_pstRing, char *a_szFileName, int a_nIdx )
 {
-	int ret = 0;
-	//Ring Pointer
-	struct rte_ring *pstRing = NULL;
-	
-	//Check Idx Error
-	if(unlikely(a_nIdx < 0))
-	{
-		return -E_Q_INVAL;
-	}
-	
-	if(unlikely(a_nIdx > m_unWriteRingCount))
-	{
-		return -E_Q_INVAL;
-	}
+	char szFileName[DEF_MEM_BUF_1024];
+	struct stat ckpt_file_stat;
+	struct flock wr_lock = { F_WRLCK, SEEK_SET, 0, sizeof(CKPT_INFO) };
+	struct flock wr_un_lock = { F_UNLCK, SEEK_SET, 0, sizeof(CKPT_INFO) };
 
-	//Select Ring by Index 
-	pstRing = m_stWriteRingInfo[a_nIdx].pstRing;
+	struct rte_ring_backup_info *pstRingBackup = &(a_pstRing->cons.cons_info[a_nIdx].backup_info);
+	CKPT_INFO *pstCkpt = NULL;
+	bool bInit = false;
 
-	if(unlikely(pstRing == NULL))
+	//이전 Process 의 Dirty Range 초기화 (Group Commit)
+	pstRingBackup->dirty_cnt = 0;
+
+	memset(szFileName, 0x00, sizeof(szFileName));
+
+	sprintf(szFileName, "%s/%s.ckpt", m_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_szFileName);
+	pstRingBackup->fd = open(szFileName, O_RDWR|O_CREAT, 0660);
+	if(unlikely(pstRingBackup->fd == -1))
 	{
-		SetErrorMsg("Queue Idx[%d] is NULL", a_nIdx);
-		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
-		return -E_Q_INVAL;
+		SetErrorMsg("Checkpoint File Open Error");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_NOENT;
 	}
 
-	//Fail 이 일정 Count 의 배수일 때
-	//현재 Ring 이 Full 이고 Consumer Process 가 Signal 을 유실하였다고 판단하여
-	//다시 한번 Signal 을 전송
-	if( unlikely((m_stWriteRingInfo[a_nIdx].unFailCnt % DEF_MAX_FAIL_CNT) == 0))
+	if( fcntl(pstRingBackup->fd, F_SETLKW, &wr_lock) < 0 )
 	{
-		SendRTS(pstRing);
+		SetErrorMsg("File Lock Failed errno : %d", errno);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_FLOCK;
 	}
 
-	//Enqueue Data in Ring
-	ret = EnqueueData(
-				pstRing
-				,m_unCurWriteMbufIdx
-				,m_stWriteRingInfo[a_nIdx].nIdx ) ;
-
-	if(ret < 0)
+	if( unlikely(fstat(pstRingBackup->fd, &ckpt_file_stat) < 0) )
 	{
-		//NO Space Error 시에는 재시도 하도록 변경. 따라서 m_unCurWriteMbufIdx 를 초기화 할 수 없음
-//		m_unCurWriteMbufIdx = 0;
-		m_stWriteRingInfo[a_nIdx].unFailCnt++;
-		return ret; 
+		SetErrorMsg("Stat Function Error");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_NOENT;
 	}
 
-	//Backup Data
-	if(m_bBackup)
+	if( (uint64_t)ckpt_file_stat.st_size != sizeof(CKPT_INFO) )
 	{
-		ret = BackupWriteData( pstRing, m_stWriteRingInfo[a_nIdx].nIdx );
-		if(ret < 0)
+		bInit = true;
+		if(ftruncate(pstRingBackup->fd, 0) < 0 || ftruncate(pstRingBackup->fd, sizeof(CKPT_INFO)) < 0)
 		{
-			SetErrorMsg("Write Data Backup Failed");
+			SetErrorMsg("ftruncate Function Error errno : %d", errno);
 			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			close(pstRingBackup->fd);
+			return -E_Q_TRUN;
 		}
 	}
 
-	//내부 데이터 저장 Buffer 의 시작 Index 를 초기화
-	m_unCurWriteMbufIdx = 0;
+	pstRingBackup->backup = mmap(NULL, sizeof(CKPT_INFO), PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
+	if(pstRingBackup->backup == MAP_FAILED)
+	{
+		SetErrorMsg("mmap Failed errno : %d", errno);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_MMAP;
+	}
 
-	SendRTS(pstRing);
+	pstRingBackup->size = sizeof(CKPT_INFO);
+	pstRingBackup->mask = 0;
+	pstCkpt = (CKPT_INFO*)pstRingBackup->backup;
 
-	return ret;
+	if( bInit || pstCkpt->unMagic != DEF_CKPT_MAGIC )
+	{
+		if(bInit == false)
+			RTE_LOG(INFO, EAL, "Checkpoint File (%s) Format is Changed, Reset\n", szFileName);
 
-}
+		memset(pstCkpt, 0x00, sizeof(CKPT_INFO));
+		pstCkpt->unMagic = DEF_CKPT_MAGIC;
+	}
 
-/*!
- * \brief Send RTS To Consumer Process
- * \details Ring 에서 현재 Sleep 상태인 Consumer Process 로 RTS 전송
- * \param a_pstRing is Ring Pointer
- * \return 0 on Success
- */
-int CLQManager::SendRTS(struct rte_ring *a_pstRing)
-{
-	//Signal Value
-	union sigval sv;
+	//Insert Process Info
+	pstCkpt->unConsCnt = a_pstRing->cons.cons_count;
+	memset( &(pstCkpt->stCursor[a_nIdx]), 0x00, sizeof(CKPT_CURSOR));
+	sprintf(pstCkpt->stCursor[a_nIdx].strName, "%s_%d", m_szProcName, m_nInstanceID);
+
+	msync(pstCkpt, sizeof(CKPT_INFO), MS_SYNC);
 
-	//Find Sleep Consumer Process
-	for(uint32_t i = 0; i < a_pstRing->cons.cons_count ; i++)
+	if(fcntl(pstRingBackup->fd, F_SETLK, &wr_un_lock) < 0)
 	{
-//		printf("name, %s, pid, %d, sleep, %d\n", a_pstRing->name, a_pstRing->cons.cons_info[i].pid, a_pstRing->cons.cons_info[i].sleep);
-		if(a_pstRing->cons.cons_info[i].sleep)
-		{
-			a_pstRing->cons.cons_info[i].sleep = 0;
-			sv.sival_ptr = a_pstRing;
-			sigqueue(a_pstRing->cons.cons_info[i].pid, SIGRTMIN + 1 + i, sv);
-			break;
-		}
+		SetErrorMsg("File unlock Failed");
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		close(pstRingBackup->fd);
+		return -E_Q_FLOCK;
 	}
 
 	return 0;
 }
 
 /*!
- * \breif Send RTS For Command Send
- * \details Ring 에 연결 된 Process 에게 RTS 전송
- * \param a_pstRing is Ring Pointer
- * \return 0 on Success
+ * \brief Backup Write Data
+ * \details Backup Enqueue Data in the File
+ * Backup 이 끝나면 Enqueue 시 Producer 가 보유한 Memory Buffer 의 Reference 를 반환한다. (EnqueueData, EnqueueBcast)
+ * Async Backup Mode 에서는 Reference 를 Backup Writer Thread 에 전달하고 바로 반환한다.
+ * \param a_pstRing is Pointer of Ring
+ * \param a_nIdx is Index Number of Producer Process of Ring
+ * \param a_unSeq is Ring Position of the First Memory Buffer (EnqueueData 에서 입력한 위치)
+ * \param a_pstMbuf is Memory Buffer Array which was Enqueued
+ * \param a_unCnt is Count of Enqueued Memory Buffer
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_BACKUP Backup Record Log Full (데이터는 이미 Ring 에 입력되었으므로 재시도하지 않는다)
+ *   - -E_Q_MSYNC msync function error
  */
-int CLQManager::SendRTSCommand(struct rte_ring *a_pstRing)
+int CLQManager::BackupWriteData( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt )
 {
-	//Signal Value
-	union sigval sv;
 	int ret = 0;
+	struct rte_ring_prod_info *pstProdInfo = &(a_pstRing->prod.prod_info[a_nIdx]);
 
-	sv.sival_ptr = a_pstRing;
-	ret = sigqueue(a_pstRing->cons.cons_info[0].pid, SIGRTMIN, sv);
-	if(ret < 0)
-		return -errno;
+	//Detach 되어 Backup File 이 해제된 Ring
+	if(unlikely(pstProdInfo->backup_info.backup == NULL))
+	{
+		for(uint32_t i = 0; i < a_unCnt; i++)
+			rte_pktmbuf_free(a_pstMbuf[i]);
 
-	return 0;
-}
+		return 0;
+	}
 
-/*!
- * \brief enqueue Data
- * \details Data 를 Ring 에 입력
- * \param a_pstRing is Ring
- * \param a_nCnt is Enqueue Count
- * \param a_nIdx is Index of the Producer
- * \return 
- *   - 0 on Success
- *   - -E_Q_NOSPC there is no memory buffer
- */
-int CLQManager::EnqueueData(struct rte_ring *a_pstRing, int a_nCnt, int a_nIdx)
-{
-	int ret = 0;
+	__sync_fetch_and_add(&(pstProdInfo->bk_staged), a_unCnt);
 
-	//Enqueue Data in Ring
-	ret = rte_ring_mp_enqueue_bulk_idx(
-			a_pstRing, (void**)&m_pstWriteMbuf, a_nCnt, RTE_RING_QUEUE_FIXED, a_nIdx);
+	if(m_bAsyncBackup)
+		return StageBackupData(a_pstRing, a_nIdx, a_unSeq, a_pstMbuf, a_unCnt);
 
+	ret = WriteBackupFile(a_pstRing, a_nIdx, a_unSeq, a_pstMbuf, a_unCnt);
+
+	for(uint32_t i = 0; i < a_unCnt; i++)
+		rte_pktmbuf_free(a_pstMbuf[i]);
+
+	//입력은 이미 성공하였으므로 Enqueue 실패(-E_Q_NOSPC, 재시도 가능)와 구분
+	if(unlikely(ret == -E_Q_NOSPC))
+		return -E_Q_BACKUP;
 
-#if 0
-	//Enqueue Failed
-	if( ret != 0)
-	{
-		for(int i = 0; i < a_nCnt ; i++)
-		{
-			//Data Buffer Free
-			rte_pktmbuf_free(m_pstWriteMbuf[i]);
-		}
-		return -E_Q_NOSPC;
-	}
-#endif
 	return ret;
 }
 
 /*!
- * \brief Init Backup Files
- * \details Queue 의 Backup 을 위하여서 Backup File 을 초기화
- * \param a_pstRing is Ring 
- * \param a_szFileName is Name of Backup File
- * \param a_nType is Ring Type (Read:0/ Write:1)
- * \param a_nIdx is Index of the Process in the Queue
+ * \brief Hand Enqueued Data to Backup Writer Thread
+ * \details Ring, Producer Index, Ring Position 을 Stage (BACKUP_STAGE) 에 기록하고 Staging Ring 에 입력한다.
+ * Memory Buffer 는 이미 Consumer 가 읽고 있으므로 Memory Buffer 의 Field 는 변경하지 않는다.
+ * 사용할 Stage 가 없는 경우 Backup Writer Thread 가 기록할 때까지 대기한다. (Backpressure)
+ * Backup Lock 없이 호출하며, Stage 의 입력 순서는 Ring 의 위치 순서와 다를 수 있다.
+ * \param a_pstRing is Pointer of Ring
+ * \param a_nIdx is Index Number of Producer Process of Ring
+ * \param a_unSeq is Ring Position of the First Memory Buffer
+ * \param a_pstMbuf is Memory Buffer Array which was Enqueued
+ * \param a_unCnt is Count of Enqueued Memory Buffer
  * \return 
  *   - 0 on Success
- *   - -E_Q_NOENT File Open Error
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
+ *   - -E_Q_BACKUP Backup Writer Thread 가 이전 데이터의 기록에 실패함 (이번 데이터는 전달됨)
  */
-int CLQManager::InitBackupFile( struct rte_ring *a_pstRing, char *a_szFileName, int a_nType, int a_nIdx )
+int CLQManager::StageBackupData( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt )
 {
-	char szFileName[DEF_MEM_BUF_1024];
-	uint64_t unDefaultSize = sizeof(BACKUP_INFO) + (DEF_DEFAULT_BK_MASK * sizeof(DATA_BUFFER));
-	struct stat bk_file_stat;
-	//struct flock => { l_type, l_whence, l_start, l_len};
-	//flock for Backup Info Update
-	struct flock wr_info_lock = { F_WRLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
-	//funlock for Backup Info
-	struct flock wr_info_un_lock = { F_UNLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
-
-	struct rte_ring_backup_info *pstRingBackup = NULL;
-	BACKUP_INFO *pstBackup = NULL;
+	BACKUP_STAGE *pstStage[DEF_MEM_BUF_1024];
 
-	//Init Backup File Info
-	if(a_nType == DEF_RING_TYPE_READ)
-		pstRingBackup = &(a_pstRing->cons.cons_info[a_nIdx].backup_info);
-	else
-		pstRingBackup = &(a_pstRing->prod.prod_info[a_nIdx].backup_info);
-
-	memset(szFileName, 0x00, sizeof(szFileName));
+	while(rte_ring_mc_dequeue_bulk(m_pstStageFree, (void**)pstStage, a_unCnt) != 0)
+		sched_yield();
 
-	sprintf(szFileName, "%s/%s.bak", m_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_szFileName);
-	printf("szFile Name %s\n", szFileName);
-	pstRingBackup->fd = open(szFileName, O_RDWR|O_CREAT, 0660);
-	if(unlikely(pstRingBackup->fd == -1))
+	for(uint32_t i = 0; i < a_unCnt; i++)
 	{
-		SetErrorMsg("Backup File Open Error");
-		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-		return -E_Q_NOENT;
+		pstStage[i]->pstRing = a_pstRing;
+		pstStage[i]->pstMbuf = a_pstMbuf[i];
+		pstStage[i]->unSeq = a_unSeq + i;
+		pstStage[i]->nIdx = a_nIdx;
 	}
 
-	if( unlikely(fstat(pstRingBackup->fd, &bk_file_stat) < 0) )
+	//Stage 수는 Staging Ring 의 크기보다 작으므로 항상 입력됨
+	rte_ring_mp_enqueue_bulk(m_pstStageRing, (void**)pstStage, a_unCnt);
+
+	//Backup Writer Thread 의 기록 실패를 한번 보고
+	if(unlikely(m_nAsyncBackupErr != 0) && __sync_lock_test_and_set(&m_nAsyncBackupErr, 0) != 0)
 	{
-		SetErrorMsg("Stat Function Error");
-		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-		close(pstRingBackup->fd);
-		return -E_Q_NOENT;
+		SetErrorMsg("Async Backup Write Failed");
+		return -E_Q_BACKUP;
 	}
-	
-	if( bk_file_stat.st_size == 0 )
+
+	return 0;
+}
+
+/*!
+ * \brief Backup Writer Thread
+ * \details Staging Ring 의 Stage 를 Burst 로 꺼내어 같은 Ring, Producer 의 연속된 위치끼리
+ * 한번에 Backup File 에 기록(WriteBackupFile)하고 Reference 를 반환한다.
+ * 기록에 실패하면 m_nAsyncBackupErr 에 기록하여 다음 Stage 시 Producer 에게 -E_Q_BACKUP 으로 보고한다.
+ * 종료 시 Staging Ring 에 남은 데이터를 모두 기록한다.
+ * \param a_pArg is CLQManager
+ * \return NULL
+ */
+void *CLQManager::AsyncBackupThread( void *a_pArg )
+{
+	CLQManager *pclsLQ = (CLQManager*)a_pArg;
+	BACKUP_STAGE *pstStage[DEF_MAX_BURST];
+	struct rte_mbuf *pstMbuf[DEF_MAX_BURST];
+	unsigned unCnt = 0;
+	unsigned i = 0;
+	unsigned j = 0;
+	int ret = 0;
+
+	rte_lcore_slot_attach();
+
+	for(;;)
 	{
-		if(ftruncate(pstRingBackup->fd, unDefaultSize) < 0)
+		unCnt = rte_ring_sc_dequeue_burst(pclsLQ->m_pstStageRing, (void**)pstStage, DEF_MAX_BURST);
+		if(unCnt == 0)
 		{
-			SetErrorMsg("ftruncate Function Error errno : %d", errno);
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-			close(pstRingBackup->fd);
-			return -E_Q_TRUN;
-		}
+			if(pclsLQ->m_bAsyncRun == false)
+				break;
 
-		//File Lock For Init
-		if( fcntl(pstRingBackup->fd, F_SETLK, &wr_info_lock) >= 0 )
-		{
-			//mmap File 
-			pstRingBackup->backup = mmap(NULL, unDefaultSize, PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
-			if(pstRingBackup->backup == MAP_FAILED)
-			{
-				SetErrorMsg("First mmap Failed errno : %d", errno);
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				close(pstRingBackup->fd);
-				return -E_Q_MMAP;
-			}
+			usleep(DEF_BK_IDLE_USEC);
+			continue;
+		}
 
-			pstRingBackup->size = unDefaultSize;
+		for(i = 0; i < unCnt; i++)
+			pstMbuf[i] = pstStage[i]->pstMbuf;
 
-			//Insert Process Info
-			pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
-			memset(pstBackup, 0x00, sizeof(BACKUP_INFO));
-			pstBackup->unMask = DEF_DEFAULT_BK_MASK;
-		
-			if(a_nType == DEF_RING_TYPE_READ)
-			{
-				pstBackup->unConsCnt = 1;
-				sprintf(pstBackup->stConsInfo[a_nIdx].strName, "%s", m_szProcName);
-			}
-			else
+		for(i = 0; i < unCnt; i = j)
+		{
+			for(j = i + 1; j < unCnt; j++)
 			{
-				pstBackup->unProdCnt = 1;
-				sprintf(pstBackup->stProdInfo[a_nIdx].strName, "%s", m_szProcName);
+				if( pstStage[j]->pstRing != pstStage[i]->pstRing ||
+					pstStage[j]->nIdx != pstStage[i]->nIdx ||
+					pstStage[j]->unSeq != pstStage[i]->unSeq + (j - i) )
+					break;
 			}
 
-			pstRingBackup->mask = DEF_DEFAULT_BK_MASK;
-				
-//			if(fcntl(fd, F_SETLK, &wr_all_un_lock) < 0)
-			if(fcntl(pstRingBackup->fd, F_SETLK, &wr_info_un_lock) < 0)
+			ret = pclsLQ->WriteBackupFile( pstStage[i]->pstRing, pstStage[i]->nIdx
+									, pstStage[i]->unSeq, &pstMbuf[i], j - i );
+			if(unlikely(ret < 0))
 			{
-				SetErrorMsg("File Unlock Failed");
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				close(pstRingBackup->fd);
-				return -E_Q_FLOCK;
+				RTE_LOG(ERR, EAL, "Async Backup Write Failed Seq %u, Cnt %u, ret %d\n", pstStage[i]->unSeq, j - i, ret);
+				pclsLQ->m_nAsyncBackupErr = ret;
 			}
-
-			//Sync mmap <-> File
-			msync(pstBackup, sizeof(BACKUP_INFO), MS_SYNC);
-			return 0;
 		}
 
+		for(i = 0; i < unCnt; i++)
+			rte_pktmbuf_free(pstMbuf[i]);
+
+		rte_ring_sp_enqueue_bulk(pclsLQ->m_pstStageFree, (void**)pstStage, unCnt);
 	}
 
-	//mmap File 
-	pstRingBackup->backup = mmap(NULL, unDefaultSize, PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
-	if(pstRingBackup->backup == MAP_FAILED)
+	rte_lcore_slot_detach();
+
+	return NULL;
+}
+
+/*!
+ * \brief Write Enqueued Data to Backup File
+ * \details Memory Buffer Chain 의 모든 Segment 를 하나의 가변 길이 Record 로 Record Log 에 기록하고,
+ * Record Offset Index 에 Ring Position 별 Log Offset 을 기록한다.
+ * Log 의 기록 위치는 Producer 간 Atomic 하게 할당하며, Record 는 Segment(DEF_BK_SEG_SIZE) 경계에서 나누어지지 않는다.
+ * Log Full 로 일부만 기록한 경우 Producer Tail 은 기록한 Record 까지만 이동하고, 나머지는 bk_failed 로 집계한다.
+ * \param a_pstRing is Pointer of Ring
+ * \param a_nIdx is Index Number of Producer Process of Ring
+ * \param a_unSeq is Ring Position of the First Memory Buffer
+ * \param a_pstMbuf is Memory Buffer Array which was Enqueued
+ * \param a_unCnt is Count of Enqueued Memory Buffer
+ * \return 
+ *   - 0 on Success
+ *   - -E_Q_NOSPC Record Log 에 Consumer 가 완료하지 않은 Record 를 덮어써야 함
+ *   - -E_Q_MSYNC msync function error
+ */
+int CLQManager::WriteBackupFile( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt )
+{
+	int ret = 0;
+
+	struct rte_ring_backup_info *pstRingBackup = &(a_pstRing->prod.prod_info[a_nIdx].backup_info);
+	BACKUP_INFO *pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
+	uint64_t *pIndex = BACKUP_INDEX(pstBackup);
+	char *pLog = BACKUP_LOG(pstBackup);
+	uint64_t unLogMask = pstBackup->unLogSize - 1;
+	BACKUP_RECORD *pstRecord = NULL;
+	struct rte_mbuf *pSeg = NULL;
+	char *p = NULL;
+
+	uint32_t unSeq = a_unSeq;
+	uint32_t unOldSeq = a_pstRing->cons.tail;
+	uint64_t unOldOff = 0;
+	bool bOldValid = false;
+	uint64_t unOff = 0;
+	uint64_t unSize = 0;
+
+	//Consumer 가 완료하지 않은 가장 오래된 Record 의 위치 (그 Record 가 있는 Segment 를 덮어쓰지 않기 위해 확인)
+	if((int32_t)(unSeq - unOldSeq) > 0)
 	{
-		SetErrorMsg("Sub mmap Failed errno : %d", errno);
-		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-		close(pstRingBackup->fd);
-		return -E_Q_MMAP;
+		unOldOff = pIndex[unOldSeq & pstBackup->unMask];
+		bOldValid = ((BACKUP_RECORD*)(pLog + (unOldOff & unLogMask)))->unSeq == unOldSeq;
 	}
 
-	pstRingBackup->size = unDefaultSize;
+	//완료하지 않은 Record 가 없으면 이번 Batch 의 시작 위치를 기준으로 Batch 가 자신을 덮어쓰지 않도록 확인
+	if(bOldValid == false)
+		unOldOff = pstBackup->unLogTail;
 
-	if( fcntl(pstRingBackup->fd, F_SETLKW, &wr_info_lock) >= 0 )
+	for(uint32_t i = 0; i < a_unCnt; i++, unSeq++)
 	{
-		pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
+		unSize = BACKUP_RECORD_SIZE(rte_pktmbuf_pkt_len(a_pstMbuf[i]));
 
-		if(a_nType == DEF_RING_TYPE_READ)
+		//Segment 끝을 넘어 다음 Segment 에 기록하는 경우까지 고려하여 확인
+		if(unlikely( unSize > DEF_BK_SEG_SIZE ||
+					(pstBackup->unLogTail + (unSize * 2) - 1) / DEF_BK_SEG_SIZE
+									>= unOldOff / DEF_BK_SEG_SIZE + pstBackup->unLogSize / DEF_BK_SEG_SIZE ))
 		{
-			pstBackup->unConsCnt = a_pstRing->cons.cons_count;
-			memset( &(pstBackup->stConsInfo[a_nIdx]), 0x00, sizeof(CONS_INFO));
-			sprintf(pstBackup->stConsInfo[a_nIdx].strName, "%s_%d", m_szProcName, m_nInstanceID);
+			SetErrorMsg("Backup Log Full Seq %u, Oldest Seq %u, Size %lu", unSeq, unOldSeq, unSize);
+			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+			ret = -E_Q_NOSPC;
+			break;
 		}
-		else
+
+		//Segment 의 끝을 넘는 경우 다음 Segment 에 다시 할당 (남은 영역은 사용하지 않음)
+		do
 		{
-			pstBackup->unProdCnt = a_pstRing->prod.prod_count;
-			memset( &(pstBackup->stProdInfo[a_nIdx]), 0x00, sizeof(PROD_INFO));
-			sprintf(pstBackup->stProdInfo[a_nIdx].strName, "%s_%d", m_szProcName, m_nInstanceID);
+			unOff = __sync_fetch_and_add(&(pstBackup->unLogTail), unSize);
+		} while( unlikely((unOff & (DEF_BK_SEG_SIZE - 1)) + unSize > DEF_BK_SEG_SIZE) );
 
-			//만약 백업 파일의 Mask 값이 변경 되었을 경우
-			//mmap 을 바뀐 사이즈 만큼 다시 수행한다.	
-			if(DEF_DEFAULT_BK_MASK != pstBackup->unMask)
-			{
-				unDefaultSize = sizeof(BACKUP_INFO) + (pstBackup->unMask * sizeof(DATA_BUFFER));
-				if(munmap(pstRingBackup->backup, pstRingBackup->size) < 0)
-				{
-					SetErrorMsg("munmap Failed");
-					RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-					return -E_Q_MMAP;
-				}
-				pstRingBackup->backup = mmap(NULL, unDefaultSize, PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
-				if(pstRingBackup->backup == MAP_FAILED)
-				{
-					SetErrorMsg("mremap Failed");
-					RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-					return -E_Q_MMAP;
-				}
+		pstRecord = (BACKUP_RECORD*)(pLog + (unOff & unLogMask));
+		p = (char*)(pstRecord + 1);
 
-				RTE_LOG(INFO, EAL, "remap Backup files (%p) oldsize(%u) -> newsize(%lu)\n"
-						, pstRingBackup->backup
-						, pstRingBackup->size, unDefaultSize);
-				pstRingBackup->size = unDefaultSize;
-			}
+		for(pSeg = a_pstMbuf[i]; pSeg != NULL; pSeg = pSeg->next)
+		{
+			memcpy(p, rte_pktmbuf_mtod(pSeg, char*), pSeg->data_len);
+			p += pSeg->data_len;
 		}
 
-		pstRingBackup->mask = pstBackup->unMask;
+		pstRecord->unLen = rte_pktmbuf_pkt_len(a_pstMbuf[i]);
+		pstRecord->unSeq = unSeq;
+		pstRecord->unSegCnt = a_pstMbuf[i]->nb_segs;
+		pstRecord->unReserved = 0;
 
-		if(fcntl(pstRingBackup->fd, F_SETLK, &wr_info_un_lock) < 0)
-		{
-			SetErrorMsg("File unlock Failed");
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-			close(pstRingBackup->fd);
-			return -E_Q_FLOCK;
-		}
+		//Record 를 모두 기록한 뒤에 Index 를 변경
+		rte_wmb();
+		pIndex[unSeq & pstBackup->unMask] = unOff;
+	}
 
-		//Sync mmap <-> File
-		msync(pstBackup, sizeof(BACKUP_INFO), MS_SYNC);
+	//기록한 Record 까지만 Tail 을 이동 (기록하지 못한 Record 를 Restore 범위에 포함하지 않음)
+	if((int32_t)(unSeq - pstBackup->stProdInfo[a_nIdx].unTail) > 0)
+		pstBackup->stProdInfo[a_nIdx].unTail = unSeq;
 
-		return 0;
+	__sync_fetch_and_add(&(a_pstRing->prod.prod_info[a_nIdx].bk_written), unSeq - a_unSeq);
+	if(unlikely(unSeq - a_unSeq != a_unCnt))
+		__sync_fetch_and_add(&(a_pstRing->prod.prod_info[a_nIdx].bk_failed), a_unCnt - (unSeq - a_unSeq));
+
+	//Group Commit Mode 에서는 Dirty Range 만 기록하고 Group Commit Thread 가 msync
+	if(m_bGroupCommit)
+	{
+		MarkBackupDirty(pstRingBackup, a_unSeq, unSeq);
+		return ret;
+	}
 		
+	//fflush 와 같은 효과
+	//Backup File 전체가 아닌 Header 와 이번에 기록한 Index, Record 의 Page 만 msync
+	//성능 저하가 발생할 수 있기 때문에 Sync Flag 가 설정 된 경우에만 MS_SYNC 로 실시
+	if(SyncBackupFile(pstRingBackup, a_unSeq, unSeq, m_bMsync ? MS_SYNC : MS_ASYNC) < 0)
+	{
+		SetErrorMsg("msync(%s) (%p) failed size : %u, errno : %d"
+					, m_bMsync ? "sync" : "async"
+					, pstRingBackup->backup
+					, pstRingBackup->size, errno);
+		RTE_LOG(ERR, EAL, "%s\n"
+					, GetErrorMsg());
+		return -E_Q_MSYNC;
 	}
+	
+	return ret;
+}
 
-	return 0;
+/*!
+ * \brief msync Header, Index and Record Range of Backup File
+ * \details Backup File 전체가 아닌 [a_unHead, a_unTail) 위치의 Index 와 Record 가 포함된 Page 만 msync 한다.
+ * 데이터를 먼저 Sync 한 뒤에 Tail 이 기록된 Header 를 Sync 한다.
+ * Index 가 가리키는 Record 가 이미 덮어써진 경우 Record Log 전체를 Sync 한다.
+ * \param a_pstInfo is Backup File Info
+ * \param a_unHead is Start Position of Data (Ring Position)
+ * \param a_unTail is End Position of Data (Ring Position, a_unHead == a_unTail : Header Only)
+ * \param a_nFlags is msync Flags (MS_SYNC / MS_ASYNC)
+ * \return 0 on Success, -1 on Error (errno)
+ */
+int CLQManager::SyncBackupFile( struct rte_ring_backup_info *a_pstInfo, uint32_t a_unHead, uint32_t a_unTail, int a_nFlags )
+{
+	int ret = 0;
+	BACKUP_INFO *pstBackup = (BACKUP_INFO*)a_pstInfo->backup;
+	char *pBase = (char*)pstBackup;
+	uint64_t *pIndex = BACKUP_INDEX(pstBackup);
+	char *pLog = BACKUP_LOG(pstBackup);
+	uint64_t unLogMask = pstBackup->unLogSize - 1;
+	BACKUP_RECORD *pstFirst = NULL;
+	BACKUP_RECORD *pstLast = NULL;
+	uint64_t unFrom = 0;
+	uint64_t unTo = 0;
+
+	if(a_unTail != a_unHead)
+	{
+		//Record Log
+		unFrom = pIndex[a_unHead & pstBackup->unMask];
+		unTo = pIndex[(a_unTail - 1) & pstBackup->unMask];
+		pstFirst = (BACKUP_RECORD*)(pLog + (unFrom & unLogMask));
+		pstLast = (BACKUP_RECORD*)(pLog + (unTo & unLogMask));
+
+		if(pstFirst->unSeq == a_unHead && pstLast->unSeq == a_unTail - 1)
+			unTo += BACKUP_RECORD_SIZE(pstLast->unLen);
+		else
+			unTo = unFrom + pstBackup->unLogSize;
+
+		ret = SyncCircular(pBase, pLog - pBase, pstBackup->unLogSize, unFrom, unTo, a_pstInfo->size, a_nFlags);
+		if(ret < 0)
+			return ret;
+
+		//Record Offset Index
+		unFrom = (uint64_t)(a_unHead & pstBackup->unMask) * sizeof(uint64_t);
+		unTo = unFrom + (uint64_t)(a_unTail - a_unHead) * sizeof(uint64_t);
+
+		ret = SyncCircular(pBase, (char*)pIndex - pBase, ((uint64_t)pstBackup->unMask + 1) * sizeof(uint64_t)
+						, unFrom, unTo, a_pstInfo->size, a_nFlags);
+		if(ret < 0)
+			return ret;
+	}
+
+	return SyncPages(pBase, 0, sizeof(BACKUP_INFO), a_pstInfo->size, a_nFlags);
 }
- 
+
 /*!
- * \brief Backup Write Data
- * \details Backup Enqueue Data in the File
- * \param a_pstRing is Pointer of Ring
- * \param a_nIdx is Index Number of Producer Process of Ring
- * \return 
- *   - 0 on Success
- *   - -E_Q_MMAP MMap Function Error
- *   - -E_Q_TRUN File Truncate Error
- *   - -E_Q_FLOCK File Locking Error
- *   - -E_Q_MSYNC msync function error
+ * \brief Add Range to Dirty Range of Backup File (Group Commit)
+ * \details Sync 되지 않은 데이터가 m_unSyncMsgCnt 이상 쌓이면 Group Commit Thread 를 깨운다.
+ * \param a_pstInfo is Backup File Info
+ * \param a_unHead is Start Position of Data (Ring Position)
+ * \param a_unTail is End Position of Data (Ring Position, a_unHead == a_unTail : Header Only)
+ * \return None
  */
-int CLQManager::BackupWriteData( struct rte_ring *a_pstRing, int a_nIdx )
+void CLQManager::MarkBackupDirty( struct rte_ring_backup_info *a_pstInfo, uint32_t a_unHead, uint32_t a_unTail )
 {
-	int ret = 0;
-	//pstData 의 Buffer 와 m_pstWriteMbuf 의 Buffer Index 를 맞추기 위하여 nIdx 설정 
-	int nIdx = 0;
+	pthread_mutex_lock(&m_stSyncLock);
 
-	struct rte_ring_backup_info *pstRingBackup = &(a_pstRing->prod.prod_info[a_nIdx].backup_info);
-	BACKUP_INFO *pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
-	DATA_BUFFER *pstData = (DATA_BUFFER*)(pstBackup + 1);
+	if(a_pstInfo->dirty_cnt == 0)
+		a_pstInfo->dirty_head = a_unHead;
 
-	uint32_t unEndIdx = 0;
-	uint32_t unStartIdx = 0;
-	uint32_t unEntry = 0;
-	float fUsage = 0;
-	uint64_t unNewSize = 0;
-	uint32_t unNewMask = 0;
+	a_pstInfo->dirty_tail = a_unTail;
+	a_pstInfo->dirty_cnt += (a_unTail != a_unHead) ? (a_unTail - a_unHead) : 1;
 
-	//flock for Backup Info Update
-	struct flock wr_info_lock = { F_WRLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
-	//funlock for Backup Info
-	struct flock wr_info_un_lock = { F_UNLCK, SEEK_SET, 0, sizeof(BACKUP_INFO) };
+	if(a_pstInfo->dirty_cnt >= m_unSyncMsgCnt)
+		pthread_cond_signal(&m_stSyncCond);
+
+	pthread_mutex_unlock(&m_stSyncLock);
+}
 
-	//calculate start, end Index Number	
-	unEndIdx = a_pstRing->prod.prod_info[a_nIdx].tail & pstBackup->unMask;
-	unStartIdx = (a_pstRing->prod.prod_info[a_nIdx].tail - m_unCurWriteMbufIdx) & pstBackup->unMask;
-	unEntry = rte_ring_count(a_pstRing);
+/*!
+ * \brief msync Dirty Range of All Backup Files (Group Commit)
+ * \details Dirty Range 를 가져온 뒤 초기화하고, Lock 을 풀고 msync 하므로 그 동안 Producer 는 대기하지 않는다.
+ * Read Ring 은 변경된 Consumer Checkpoint File 을 msync 한다.
+ * \return None
+ */
+void CLQManager::FlushBackup()
+{
+	struct rte_ring_backup_info *pstInfo = NULL;
+	uint32_t unHead = 0;
+	uint32_t unTail = 0;
+	uint32_t unCnt = 0;
+	int nFlags = m_bMsync ? MS_SYNC : MS_ASYNC;
 
-//	RTE_LOG(INFO, EAL, "unEntry %u, unMask %u, \n", unEntry, pstRingBackup->mask);
-	fUsage = (unEntry / (float)pstRingBackup->mask) * 100;
+	CLQEpochGuard clsGuard(m_nSyncEpochSlot < 0 ? NULL : &m_stEpochSlot[m_nSyncEpochSlot], &m_unTopoEpoch);
 
-//	RTE_LOG(INFO, EAL, "backup startidx %d, endidx %d mask %X, tail %u , m_unCurWriteMbufIdx %u, fUasge %.2f\n", unStartIdx, unEndIdx, pstBackup->unMask, a_pstRing->prod.prod_info[a_nIdx].tail, m_unCurWriteMbufIdx, fUsage);
-	//만약 Index 의 사용률이 80% 를 넘을 경우
-	//Max Index 를 변경 
-	//Max Index 는 반드시 2n -1 이 되어야 함
-	if( unlikely(fUsage > 80.0) )
+	for(int i = 0; i < m_unWriteRingCount + m_unReadRingCount; i++)
 	{
-		unNewMask = pstBackup->unMask << 1;
-		unNewMask = unNewMask | 1;	
-		unNewSize = sizeof(BACKUP_INFO) + (unNewMask * sizeof(DATA_BUFFER));
-//		RTE_LOG(INFO, EAL, "Usage Over File Size reset old : %u, new : %u\n", pstRingBackup->size, unNewSize);
+		//Detach 된 Ring 은 DetachRing 에서 msync 후 해제
+		if( (i < m_unWriteRingCount) ?
+				m_stWriteRingInfo[i].pstRing == NULL :
+				m_stReadRingInfo[i - m_unWriteRingCount].pstRing == NULL )
+			continue;
+
+		if(i < m_unWriteRingCount)
+			pstInfo = &(m_stWriteRingInfo[i].pstRing->prod.prod_info[m_stWriteRingInfo[i].nIdx].backup_info);
+		else
+			pstInfo = &(m_stReadRingInfo[i - m_unWriteRingCount].pstRing->cons.cons_info[m_stReadRingInfo[i - m_unWriteRingCount].nIdx].backup_info);
 
-		//File Lock
-		if( fcntl(pstRingBackup->fd, F_SETLKW, &wr_info_lock) >= 0 )
+		//Consumer Checkpoint File 은 마지막 msync 이후 변경된 경우에만 msync
+		if(i >= m_unWriteRingCount)
 		{
-			if(ftruncate(pstRingBackup->fd, unNewSize) < 0)
-			{
-				SetErrorMsg("ftruncate Function Error");
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				return -E_Q_TRUN;
-			}
+			if(pstInfo->backup != NULL)
+				SyncCheckpoint(pstInfo, m_stReadRingInfo[i - m_unWriteRingCount].nIdx, nFlags);
+			continue;
+		}
 
-			//Remap 
-			if(munmap(pstRingBackup->backup, pstRingBackup->size) < 0)
-			{
-				SetErrorMsg("munmap Failed errno: %d", errno);
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				return -E_Q_MMAP;
-			}
+		pthread_mutex_lock(&m_stSyncLock);
+		unHead = pstInfo->dirty_head;
+		unTail = pstInfo->dirty_tail;
+		unCnt = pstInfo->dirty_cnt;
+		pstInfo->dirty_cnt = 0;
+		pthread_mutex_unlock(&m_stSyncLock);
 
-			pstRingBackup->backup = mmap(NULL, unNewSize, PROT_READ|PROT_WRITE, MAP_SHARED, pstRingBackup->fd, 0);
-			if(pstRingBackup->backup == MAP_FAILED)
-			{
-				SetErrorMsg("mremap Failed %d", errno);
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				return -E_Q_MMAP;
-			}
+		if(unCnt == 0 || pstInfo->backup == NULL)
+			continue;
 
-			pstRingBackup->size = unNewSize;
+		if(SyncBackupFile(pstInfo, unHead, unTail, nFlags) < 0)
+		{
+			RTE_LOG(ERR, EAL, "Group Commit msync (%p) failed size : %u, errno : %d\n"
+						, pstInfo->backup, pstInfo->size, errno);
+		}
+	}
+}
 
-			//Reset Backup Info Pointer
-			pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
+/*!
+ * \brief Group Commit Thread
+ * \details m_unSyncUsec 마다 혹은 MarkBackupDirty 가 깨울 때 Dirty Range 를 msync 하며,
+ * 종료 시 남은 Dirty Range 를 msync 한다.
+ * \param a_pArg is CLQManager
+ * \return NULL
+ */
+void *CLQManager::SyncThread( void *a_pArg )
+{
+	CLQManager *pclsLQ = (CLQManager*)a_pArg;
+	struct timespec stTime;
 
-			if(pstRingBackup->mask == pstBackup->unMask)
-			{
-				pstBackup->unMask = unNewMask;
-				//Sync mmap <-> File
-				msync(pstBackup, sizeof(BACKUP_INFO), MS_SYNC);
-			}
+	pthread_mutex_lock(&pclsLQ->m_stSyncLock);
 
-			//Reset Data Pointer
-			pstData = (DATA_BUFFER*)(pstBackup + 1);
+	while(pclsLQ->m_bSyncRun)
+	{
+		clock_gettime(CLOCK_REALTIME, &stTime);
+		stTime.tv_nsec += (long)pclsLQ->m_unSyncUsec * 1000;
+		stTime.tv_sec += stTime.tv_nsec / 1000000000;
+		stTime.tv_nsec %= 1000000000;
 
-			//Reset unMask 
-			pstRingBackup->mask = unNewMask;
+		pthread_cond_timedwait(&pclsLQ->m_stSyncCond, &pclsLQ->m_stSyncLock, &stTime);
 
-			//File Unlock 
-			if(fcntl(pstRingBackup->fd, F_SETLK, &wr_info_un_lock) < 0)
-			{
-				SetErrorMsg("File unlock Failed");
-				RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-				close(pstRingBackup->fd);
-				return -E_Q_FLOCK;
-			}
-		}
+		pthread_mutex_unlock(&pclsLQ->m_stSyncLock);
+		pclsLQ->FlushBackup();
+		pthread_mutex_lock(&pclsLQ->m_stSyncLock);
 	}
 
+	pthread_mutex_unlock(&pclsLQ->m_stSyncLock);
 
-	for(uint32_t i = unStartIdx; i < unEndIdx; i++, nIdx++)
-	{
-		
-		pstData[i].unBuffLen =  m_pstWriteMbuf[nIdx]->data_len;
-		memcpy( pstData[i].szBuff, rte_pktmbuf_mtod(m_pstWriteMbuf[nIdx], char*), pstData[i].unBuffLen);
-//		RTE_LOG(INFO, EAL, "Buffer[%d] len %u, %s\n", i, pstData[i].unBuffLen, pstData[i].szBuff);
-	}
+	pclsLQ->FlushBackup();
 
-	pstBackup->stProdInfo[a_nIdx].unTail = a_pstRing->prod.prod_info[a_nIdx].tail;	
-		
-	//fflush 와 같은 효과
-	//성능 저하가 발생할 수 있기 때문에 Sync Flag 가 설정 된 경우에만 실시
-	if(m_bMsync)
-	{
-		ret = msync(pstRingBackup->backup, pstRingBackup->size, MS_SYNC);
-		if(ret < 0)
-		{
-			SetErrorMsg("msync(sync) (%p) failed size : %u, errno : %d"
-						, pstRingBackup->backup
-						, pstRingBackup->size, errno);
-			RTE_LOG(ERR, EAL, "%s\n"
-						, GetErrorMsg());
-			return -E_Q_MSYNC;
-		}
-	}
-	else
-	{
-		ret = msync(pstRingBackup->backup, pstRingBackup->size, MS_ASYNC);
-		if(ret < 0)
-		{
-			SetErrorMsg("msync(async) (%p) failed size : %u, errno : %d"
-						, pstRingBackup->backup
-						, pstRingBackup->size, errno);
-						
-			RTE_LOG(ERR, EAL, "%s\n"
-						, GetErrorMsg());
-			return -E_Q_MSYNC;
-		}
-	}
-	
-	return 0;
+	return NULL;
 }
 
 /*!
  * \brief Backup Read Data
- * \details Backup Dequeue Position in the File
+ * \details Backup Dequeue Position in the Checkpoint File
+ * Consumer Cursor 의 Cache Line 만 변경하고, Ack Interval(m_unCkptAckCnt) 마다 Checkpoint File 을 msync 한다.
+ * Group Commit Mode 에서는 Group Commit Thread 가 msync 한다.
  * \param a_pstRing is Pointer of Ring
  * \param a_nIdx is Index Number of Consumer Process of Ring
  * \return 
@@ -2546,46 +5177,56 @@ int CLQManager::BackupWriteData( struct rte_ring *a_pstRing, int a_nIdx )
  */
 int CLQManager::BackupReadData( struct rte_ring *a_pstRing, int a_nIdx )
 {
-	int ret = 0;
-	//pstData 의 Buffer 와 m_pstWriteMbuf 의 Buffer Index 를 맞추기 위하여 nIdx 설정 
-
 	struct rte_ring_backup_info *pstRingBackup = &(a_pstRing->cons.cons_info[a_nIdx].backup_info);
-	BACKUP_INFO *pstBackup = (BACKUP_INFO*)pstRingBackup->backup;
+	CKPT_CURSOR *pstCursor = &(((CKPT_INFO*)pstRingBackup->backup)->stCursor[a_nIdx]);
+	uint64_t unAckCnt = 0;
 
-	pstBackup->stConsInfo[a_nIdx].unTail = a_pstRing->cons.cons_info[a_nIdx].tail;	
+	//Detach 되어 Checkpoint File 이 해제된 Ring
+	if(unlikely(pstRingBackup->backup == NULL))
+		return 0;
 
-	//fflush 와 같은 효과
-	//성능 저하가 발생할 수 있기 때문에 Sync Flag 가 설정 된 경우에만 실시
-	if(m_bMsync)
-	{
-		ret = msync(pstRingBackup->backup, pstRingBackup->size, MS_SYNC);
-		if(ret < 0)
-		{
-			SetErrorMsg("msync(sync) (%p) failed size : %u, errno : %d"
-						, pstRingBackup->backup
-						, pstRingBackup->size, errno
-			);
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+	pstCursor->unTail = a_pstRing->cons.cons_info[a_nIdx].tail;
+	unAckCnt = __sync_add_and_fetch(&(pstCursor->unAckCnt), 1);
 
-			return -E_Q_MSYNC;
-		}
-	}
-	else
+	if(m_bGroupCommit || unAckCnt - pstCursor->unSyncCnt < m_unCkptAckCnt)
+		return 0;
+
+	//fflush 와 같은 효과
+	//성능 저하가 발생할 수 있기 때문에 Sync Flag 가 설정 된 경우에만 MS_SYNC 로 실시
+	if(SyncCheckpoint(pstRingBackup, a_nIdx, m_bMsync ? MS_SYNC : MS_ASYNC) < 0)
 	{
-		ret = msync(pstRingBackup->backup, pstRingBackup->size, MS_ASYNC);
-		if(ret < 0)
-		{
-			SetErrorMsg("msync(sync) (%p) failed size : %u, errno : %d"
-						, pstRingBackup->backup
-						, pstRingBackup->size, errno
-			);
-			RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
-			return -E_Q_MSYNC;
-		}
+		SetErrorMsg("msync(%s) (%p) failed size : %u, errno : %d"
+					, m_bMsync ? "sync" : "async"
+					, pstRingBackup->backup
+					, pstRingBackup->size, errno
+		);
+		RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+		return -E_Q_MSYNC;
 	}
 	return 0;
 }
 
+/*!
+ * \brief msync Consumer Checkpoint File
+ * \details 마지막 msync 이후 Consumer Cursor 가 변경된 경우에만 msync 한다.
+ * \param a_pstInfo is Checkpoint File Info
+ * \param a_nIdx is Index Number of Consumer Process of Ring
+ * \param a_nFlags is msync Flags (MS_SYNC / MS_ASYNC)
+ * \return 0 on Success, -1 on Error (errno)
+ */
+int CLQManager::SyncCheckpoint( struct rte_ring_backup_info *a_pstInfo, int a_nIdx, int a_nFlags )
+{
+	CKPT_CURSOR *pstCursor = &(((CKPT_INFO*)a_pstInfo->backup)->stCursor[a_nIdx]);
+	uint64_t unAckCnt = pstCursor->unAckCnt;
+
+	if(unAckCnt == pstCursor->unSyncCnt)
+		return 0;
+
+	pstCursor->unSyncCnt = unAckCnt;
+
+	return msync(a_pstInfo->backup, a_pstInfo->size, a_nFlags);
+}
+
 /*!
  * \brief Get Write Queue Index
  * \details 
@@ -2598,11 +5239,19 @@ int CLQManager::BackupReadData( struct rte_ring *a_pstRing, int a_nIdx )
  */
  int CLQManager::GetWriteQueueIndex(char *a_szProc)
  {
+	vector<string> *pvecRelProc = NULL;
+
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
 	for(int i = 0; i < m_unWriteRingCount ; i++)
 	{
-		for(uint32_t j = 0 ; j < m_stWriteRingInfo[i].vecRelProc.size(); j++)
+		pvecRelProc = m_stWriteRingInfo[i].pvecRelProc;
+		if(m_stWriteRingInfo[i].pstRing == NULL || pvecRelProc == NULL)
+			continue;
+
+		for(uint32_t j = 0 ; j < pvecRelProc->size(); j++)
 		{
-			if( strncmp(m_stWriteRingInfo[i].vecRelProc[j].c_str(), a_szProc, strlen(a_szProc)) == 0 )
+			if( strncmp((*pvecRelProc)[j].c_str(), a_szProc, strlen(a_szProc)) == 0 )
 			{
 				return i;
 			}
@@ -2625,11 +5274,19 @@ int CLQManager::BackupReadData( struct rte_ring *a_pstRing, int a_nIdx )
  */
  int CLQManager::GetReadQueueIndex(char *a_szProc)
  {
+	vector<string> *pvecRelProc = NULL;
+
+	CLQEpochGuard clsGuard(&m_stEpochSlot[0], &m_unTopoEpoch);
+
 	for(int i = 0; i < m_unReadRingCount ; i++)
 	{
-		for(uint32_t j = 0 ; j < m_stReadRingInfo[i].vecRelProc.size(); j++)
+		pvecRelProc = m_stReadRingInfo[i].pvecRelProc;
+		if(m_stReadRingInfo[i].pstRing == NULL || pvecRelProc == NULL)
+			continue;
+
+		for(uint32_t j = 0 ; j < pvecRelProc->size(); j++)
 		{
-			if( strncmp(m_stReadRingInfo[i].vecRelProc[j].c_str(), a_szProc, strlen(a_szProc)) == 0 )
+			if( strncmp((*pvecRelProc)[j].c_str(), a_szProc, strlen(a_szProc)) == 0 )
 			{
 				return i;
 			}
@@ -2705,6 +5362,7 @@ int CLQManager::InitCommandRing(char *a_szProcName, int a_nInstanceID, int a_nTy
 		}
 
 		m_pstCmdRcvRing = pstSnd;
+		m_unCmdRcvIdx = ret;
 		return 0;
 	}
 
@@ -2729,6 +5387,7 @@ int CLQManager::InitCommandRing(char *a_szProcName, int a_nInstanceID, int a_nTy
 	}
 
 	m_pstCmdRcvRing = pstRcv;
+	m_unCmdRcvIdx = ret;
 	m_pstCmdSndRing = pstSnd;	
 
 	return 0;
@@ -2796,6 +5455,8 @@ int CLQManager::SendCommand(char *a_szProcName, int a_nInstanceID, char *a_pszDa
 /*!
  * \brief Receive Command 
  * \details 누군가로 부터 전송된 Command 를 수신 
+ * Topology Command (SendTopology) 는 Ring 을 Attach/Detach 한 뒤 Application 에 전달하지 않고 다음 Command 를 수신한다.
+ * 다른 Process 의 Topology Command 처리 실패 (TOPOLOGY_RESULT) 는 다른 Command 와 같이 Application 에 전달한다.
  * \param  a_pszBuff is Buffer Pointer to Store Data
  * \return 
  *   - 0 on Success
@@ -2818,14 +5479,31 @@ int CLQManager::ReceiveCommand(char **a_pszBuff)
 		return -E_Q_INVAL;
 	}
 
-	ret = rte_ring_dequeue_bulk(m_pstCmdRcvRing, (void**)&m_pstCurMbuf, 1);
-
-	if(ret != 0)
+	//Topology Command 는 Application 에 전달하지 않고 직접 처리한 뒤 다음 Command 를 읽음
+	for(;;)
 	{
-		return ret;
-	}
+		ret = rte_ring_dequeue_bulk(m_pstCmdRcvRing, (void**)&m_pstCurMbuf, 1);
+
+		if(ret != 0)
+		{
+			return ret;
+		}
 
-	pMbuf = m_pstCurMbuf;
+		pMbuf = m_pstCurMbuf;
+
+		if( pMbuf->nb_segs != 1 ||
+			rte_pktmbuf_data_len(pMbuf) != sizeof(TOPOLOGY_CMD) ||
+			rte_pktmbuf_mtod(pMbuf, TOPOLOGY_CMD *)->unMagic != DEF_TOPO_MAGIC )
+		{
+			break;
+		}
+
+		//실패한 경우 ApplyTopology 가 Sender 에게 TOPOLOGY_RESULT 를 전송
+		ApplyTopology(rte_pktmbuf_mtod(pMbuf, TOPOLOGY_CMD *));
+
+		rte_pktmbuf_free(pMbuf);
+		m_pstCurMbuf = NULL;
+	}
 
 	//데이터의 크기가 Memory Buffer 한개의 사이즈를 초과한 경우에
 	//여러개의 Memory Buffer 가 Linked list 형태로 연결 되어 있기 때문에
@@ -2922,6 +5600,331 @@ int CLQManager::SendCommandResult(char *a_pszData, int a_nSize)
 }
 
 
+/*!
+ * \brief Send Topology Command to Process
+ * \details 대상 Process 의 Command Ring 으로 TOPOLOGY_CMD 를 전송한다.
+ * 대상 Process 는 ReceiveCommand 에서 Ring 을 Attach/Detach 하며, Process 를 재시작하지 않는다.
+ * \param a_szProcName 명령을 전달하고 싶은 Process 의 이름
+ * \param a_nInstanceID is Instance ID of Process
+ * \param a_nOp is DEF_TOPO_ATTACH / DEF_TOPO_DETACH
+ * \param a_nType is Ring Type of the Process (Read:0/ Write:1)
+ * \param a_szWrite is Name of Write Process
+ * \param a_szRead is Name of Read Process
+ * \param a_cMultiType is Multi Queue Type (Read:'R', Write :'W', Broadcast : 'B', else : NULL)
+ * \param a_nElemCnt is Count of Ring Elements (Attach)
+ * \param a_unHighWm is High Watermark of Ring (Attach, 0 : 사용 안함)
+ * \param a_unLowWm is Low Watermark of Ring (Attach)
+ * \return SendCommand() 참조
+ */
+int CLQManager::SendTopology(char *a_szProcName, int a_nInstanceID, int a_nOp, int a_nType, char *a_szWrite, char *a_szRead, char a_cMultiType, int a_nElemCnt, uint32_t a_unHighWm, uint32_t a_unLowWm)
+{
+	TOPOLOGY_CMD stCmd;
+
+	if(a_nOp != DEF_TOPO_ATTACH && a_nOp != DEF_TOPO_DETACH)
+	{
+		SetErrorMsg("Invalid Topology Command %d", a_nOp);
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	//Receiver 는 한개의 Memory Buffer 에 들어있는 Topology Command 만 처리한다
+	if(rte_pktmbuf_data_room_size(m_pstCmdMemPool) < RTE_PKTMBUF_HEADROOM + sizeof(TOPOLOGY_CMD))
+	{
+		SetErrorMsg("Command Memory Buffer is Smaller than Topology Command %lu", sizeof(TOPOLOGY_CMD));
+		RTE_LOG(ERR, RING, "%s\n", GetErrorMsg());
+		return -E_Q_INVAL;
+	}
+
+	memset(&stCmd, 0x00, sizeof(stCmd));
+	stCmd.unMagic = DEF_TOPO_MAGIC;
+	stCmd.nOp = a_nOp;
+	stCmd.nType = a_nType;
+	stCmd.nElemCnt = a_nElemCnt;
+	stCmd.cMultiType = a_cMultiType;
+	stCmd.unHighWm = a_unHighWm;
+	stCmd.unLowWm = a_unLowWm;
+	stCmd.nSenderInstance = m_nInstanceID;
+	snprintf(stCmd.szSenderProc, sizeof(stCmd.szSenderProc), "%s", m_szProcName);
+	snprintf(stCmd.szWriteProc, sizeof(stCmd.szWriteProc), "%s", a_szWrite);
+	snprintf(stCmd.szReadProc, sizeof(stCmd.szReadProc), "%s", a_szRead);
+
+	return SendCommand(a_szProcName, a_nInstanceID, (char*)&stCmd, sizeof(stCmd));
+}
+
+/*!
+ * \brief Apply Topology Command
+ * \details Attach 는 Slot 을 모두 기록한 뒤에 공개하고, Detach 는 Grace Period 이후에 자원을 해제한다. (DetachRing)
+ * 따라서 Ring Table 을 읽는 Write/Read Path 는 Lock 을 잡지 않는다.
+ * 실패하면 Command 를 보낸 Process 의 Command Ring 으로 TOPOLOGY_RESULT 를 전송한다.
+ * \param a_pstCmd is Topology Command
+ * \return
+ *   - 0 on Success
+ *   - AttachRing(), DetachRing() 참조
+ */
+int CLQManager::ApplyTopology(TOPOLOGY_CMD *a_pstCmd)
+{
+	int ret = 0;
+	struct rte_ring_cons_info *pstConsInfo = NULL;
+	TOPOLOGY_RESULT stResult;
+
+	a_pstCmd->szWriteProc[sizeof(a_pstCmd->szWriteProc) - 1] = 0x00;
+	a_pstCmd->szReadProc[sizeof(a_pstCmd->szReadProc) - 1] = 0x00;
+	a_pstCmd->szSenderProc[sizeof(a_pstCmd->szSenderProc) - 1] = 0x00;
+
+	if(a_pstCmd->nOp == DEF_TOPO_ATTACH)
+	{
+		//Queue Definition 으로 Attach 하는 경우와 같이 Watermark 를 적용 (SetRingWatermark)
+		ret = AttachRing(a_pstCmd->szWriteProc, a_pstCmd->szReadProc, a_pstCmd->nElemCnt, a_pstCmd->nType, a_pstCmd->cMultiType
+							, a_pstCmd->unHighWm, a_pstCmd->unLowWm);
+
+		//Futex Mode : 새 Read Ring 의 Producer 도 Process 의 Futex Word 를 깨우도록 설정
+		if(ret == 0 && a_pstCmd->nType == DEF_RING_TYPE_READ && m_pstFutex != NULL)
+		{
+			for(int i = 0; i < m_unReadRingCount; i++)
+			{
+				if(m_stReadRingInfo[i].pstRing == NULL)
+					continue;
+
+				pstConsInfo = &(m_stReadRingInfo[i].pstRing->cons.cons_info[m_stReadRingInfo[i].nIdx]);
+				if(pstConsInfo->futex_ptr == m_pstFutex)
+					continue;
+
+				pstConsInfo->futex_ptr = m_pstFutex;
+				rte_wmb();
+				pstConsInfo->wait_mode = (m_nWaitMode == DEF_WAIT_MODE_HYBRID) ? DEF_WAIT_MODE_FUTEX : m_nWaitMode;
+			}
+		}
+	}
+	else if(a_pstCmd->nOp == DEF_TOPO_DETACH)
+	{
+		ret = DetachRing(a_pstCmd->szWriteProc, a_pstCmd->szReadProc, a_pstCmd->nType, a_pstCmd->cMultiType);
+	}
+	else
+	{
+		SetErrorMsg("Invalid Topology Command %d", a_pstCmd->nOp);
+		ret = -E_Q_INVAL;
+	}
+
+	if(ret < 0)
+	{
+		RTE_LOG(ERR, RING, "Topology Command %d (%s -> %s) Failed %d\n"
+					, a_pstCmd->nOp, a_pstCmd->szWriteProc, a_pstCmd->szReadProc, ret);
+
+		//Command 를 보낸 Process 에게 실패를 전달
+		if(a_pstCmd->szSenderProc[0] != 0x00)
+		{
+			memset(&stResult, 0x00, sizeof(stResult));
+			stResult.unMagic = DEF_TOPO_RESULT_MAGIC;
+			stResult.nOp = a_pstCmd->nOp;
+			stResult.nType = a_pstCmd->nType;
+			stResult.nResult = ret;
+			stResult.nInstanceID = m_nInstanceID;
+			snprintf(stResult.szProcName, sizeof(stResult.szProcName), "%s", m_szProcName);
+			snprintf(stResult.szWriteProc, sizeof(stResult.szWriteProc), "%s", a_pstCmd->szWriteProc);
+			snprintf(stResult.szReadProc, sizeof(stResult.szReadProc), "%s", a_pstCmd->szReadProc);
+
+			if(SendCommand(a_pstCmd->szSenderProc, a_pstCmd->nSenderInstance, (char*)&stResult, sizeof(stResult)) < 0)
+			{
+				RTE_LOG(ERR, RING, "Cannot Send Topology Result to %s_%d\n"
+							, a_pstCmd->szSenderProc, a_pstCmd->nSenderInstance);
+			}
+		}
+
+		return ret;
+	}
+
+	RTE_LOG(INFO, RING, "Topology Command %d (%s -> %s) Applied\n"
+					, a_pstCmd->nOp, a_pstCmd->szWriteProc, a_pstCmd->szReadProc);
+
+	return 0;
+}
+
+/*!
+ * \brief Register Epoch Slot of Thread
+ * \details Ring Table 을 읽는 Thread 는 Slot 을 하나씩 할당 받아 CLQEpochGuard 로 사용한다.
+ * \return
+ *   - Index of Epoch Slot on Success
+ *   - -E_Q_NOSPC There is no free Slot
+ */
+int CLQManager::RegisterEpoch()
+{
+	//Slot 0 은 CLQManager 를 사용하는 Thread
+	for(int i = 1; i < DEF_MAX_EPOCH_SLOT; i++)
+	{
+		if(m_stEpochSlot[i].unUsed == 0 && rte_atomic32_cmpset(&(m_stEpochSlot[i].unUsed), 0, 1))
+		{
+			m_stEpochSlot[i].unNest = 0;
+			m_stEpochSlot[i].unEpoch = 0;
+			return i;
+		}
+	}
+
+	SetErrorMsg("Epoch Slot is Full (%d)", DEF_MAX_EPOCH_SLOT);
+	RTE_LOG(ERR, EAL, "%s\n", GetErrorMsg());
+	return -E_Q_NOSPC;
+}
+
+/*!
+ * \brief Unregister Epoch Slot of Thread
+ * \param a_nSlot is Index of Epoch Slot
+ * \return None
+ */
+void CLQManager::UnregisterEpoch(int a_nSlot)
+{
+	if(a_nSlot <= 0 || a_nSlot >= DEF_MAX_EPOCH_SLOT)
+		return;
+
+	m_stEpochSlot[a_nSlot].unEpoch = 0;
+	rte_wmb();
+	m_stEpochSlot[a_nSlot].unUsed = 0;
+}
+
+/*!
+ * \brief Wait Grace Period of Ring Table
+ * \details Topology Epoch 을 증가시킨 뒤, 이전 Epoch 에 진입한 Thread 가 모두 Quiescent 가 될 때까지 대기한다.
+ * 이 함수가 Return 된 이후에는 Ring Table 에서 제거된 Ring 을 참조하는 Thread 가 없다.
+ * \return None
+ */
+void CLQManager::SyncEpoch()
+{
+	uint64_t unTarget = 0;
+	uint64_t unEpoch = 0;
+
+	//Ring Table 의 Store 이후에 Epoch 을 증가
+	rte_mb();
+	unTarget = __sync_add_and_fetch(&m_unTopoEpoch, 1);
+	rte_mb();
+
+	for(int i = 0; i < DEF_MAX_EPOCH_SLOT; i++)
+	{
+		if(m_stEpochSlot[i].unUsed == 0)
+			continue;
+
+		for(;;)
+		{
+			unEpoch = m_stEpochSlot[i].unEpoch;
+			if(unEpoch == 0 || unEpoch >= unTarget)
+				break;
+
+			usleep(DEF_EPOCH_WAIT_USEC);
+		}
+	}
+}
+
+/*!
+ * \brief Replace Relation Process List of Ring
+ * \details GetWriteQueueIndex, GetReadQueueIndex 는 Lock 없이 List 를 읽으므로 새 List 를 공개한 뒤
+ * 이전 Epoch 에 진입한 Thread 가 모두 벗어난 후에(SyncEpoch) 이전 List 를 삭제한다.
+ * \param a_pstInfo is Ring Info
+ * \param a_pvecRelProc is New List (NULL : Empty)
+ * \return None
+ */
+void CLQManager::SetRelProc(RING_INFO *a_pstInfo, vector<string> *a_pvecRelProc)
+{
+	vector<string> *pvecOld = a_pstInfo->pvecRelProc;
+
+	//List 를 모두 기록한 뒤에 공개
+	rte_wmb();
+	a_pstInfo->pvecRelProc = a_pvecRelProc;
+
+	if(pvecOld == NULL)
+		return;
+
+	SyncEpoch();
+	delete pvecOld;
+}
+
+/*!
+ * \brief Add Relation Process to Ring
+ * \details 이미 등록된 Process 이면 List 를 변경하지 않는다.
+ * \param a_pstInfo is Ring Info
+ * \param a_szProc is Name of Relation Process
+ * \return None
+ */
+void CLQManager::AddRelProc(RING_INFO *a_pstInfo, const char *a_szProc)
+{
+	vector<string> *pvecNew = NULL;
+
+	if(a_pstInfo->pvecRelProc != NULL)
+	{
+		for(uint32_t j = 0; j < a_pstInfo->pvecRelProc->size(); j++)
+		{
+			if( strcmp(a_szProc, (*a_pstInfo->pvecRelProc)[j].c_str()) == 0 )
+				return;
+		}
+
+		pvecNew = new vector<string>(*a_pstInfo->pvecRelProc);
+	}
+	else
+	{
+		pvecNew = new vector<string>();
+	}
+
+	pvecNew->push_back(a_szProc);
+
+	SetRelProc(a_pstInfo, pvecNew);
+}
+
+/*!
+ * \brief Remove Relation Process from Ring
+ * \param a_pstInfo is Ring Info
+ * \param a_szProc is Name of Relation Process
+ * \return Count of Remaining Relation Process
+ */
+int CLQManager::DelRelProc(RING_INFO *a_pstInfo, const char *a_szProc)
+{
+	vector<string> *pvecNew = NULL;
+
+	if(a_pstInfo->pvecRelProc == NULL)
+		return 0;
+
+	pvecNew = new vector<string>();
+
+	for(uint32_t j = 0; j < a_pstInfo->pvecRelProc->size(); j++)
+	{
+		if( strcmp(a_szProc, (*a_pstInfo->pvecRelProc)[j].c_str()) != 0 )
+			pvecNew->push_back((*a_pstInfo->pvecRelProc)[j]);
+	}
+
+	if(pvecNew->size() == a_pstInfo->pvecRelProc->size())
+	{
+		delete pvecNew;
+		return (int)a_pstInfo->pvecRelProc->size();
+	}
+
+	SetRelProc(a_pstInfo, pvecNew);
+
+	return (int)pvecNew->size();
+}
+
+/*!
+ * \brief Release Backup File of Detached Ring
+ * \details Backup File (혹은 Checkpoint File) 을 msync 한 후 munmap, close 한다.
+ * \param a_pstInfo is Backup File Info
+ * \return None
+ */
+void CLQManager::ReleaseBackup(struct rte_ring_backup_info *a_pstInfo)
+{
+	void *pBackup = a_pstInfo->backup;
+
+	if(pBackup == NULL || pBackup == MAP_FAILED)
+		return;
+
+	a_pstInfo->backup = NULL;
+	a_pstInfo->dirty_cnt = 0;
+	rte_wmb();
+
+	if(msync(pBackup, a_pstInfo->size, MS_SYNC) < 0)
+		RTE_LOG(ERR, EAL, "Release Backup msync (%p) failed size : %u, errno : %d\n", pBackup, a_pstInfo->size, errno);
+
+	munmap(pBackup, a_pstInfo->size);
+
+	if(a_pstInfo->fd > 0)
+		close(a_pstInfo->fd);
+
+	a_pstInfo->fd = -1;
+}
+
 /*!
  * \brief Delete Queue
  * \param a_pszQueue Name of Queue
@@ -12,12 +12,14 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <signal.h>
+#include <pthread.h>
 #include <vector>
 #include <string>
 
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 
@@ -36,6 +38,7 @@
 #include <rte_ring.h>
 #include <rte_mbuf.h>
 #include <rte_errno.h>
+#include <rte_cycles.h>
 
 #include "CQuery.hpp"
 #include "MariaDB.hpp"
@@ -44,6 +47,45 @@
 #include "CConfig.hpp"
 
 #include "CLQGlobal.h"
+#include "CLQCatalog.h"
+
+/*!
+ * \class CLQEpochGuard
+ * \brief Read Side Guard of Ring Table (Epoch)
+ * \details 생성 시 Thread 의 Epoch Slot 에 현재 Topology Epoch 을 기록하고, 소멸 시 Quiescent(0) 로 되돌린다.
+ * Detach 된 Ring 은 모든 Slot 이 Quiescent 이거나 새 Epoch 에 진입한 이후에 해제되므로 Write Path 는 Lock 을 잡지 않는다.
+ * 중첩된 경우 가장 바깥의 Guard 만 Slot 을 변경한다.
+ */
+class CLQEpochGuard
+{
+	public:
+		//! Constructor (Enter Ring Table)
+		CLQEpochGuard(EPOCH_SLOT *a_pstSlot, volatile uint64_t *a_punEpoch)
+		{
+			m_pstSlot = a_pstSlot;
+
+			if(m_pstSlot != NULL && m_pstSlot->unNest++ == 0)
+			{
+				m_pstSlot->unEpoch = *a_punEpoch;
+				//Epoch 의 Store 이후에 Ring Table 을 Load 하도록 보장
+				rte_mb();
+			}
+		}
+
+		//! Destructor (Leave Ring Table)
+		~CLQEpochGuard()
+		{
+			if(m_pstSlot != NULL && --m_pstSlot->unNest == 0)
+			{
+				rte_compiler_barrier();
+				m_pstSlot->unEpoch = 0;
+			}
+		}
+
+	private:
+		//! Epoch Slot of this Thread
+		EPOCH_SLOT *m_pstSlot;
+};
 
 /*!
  * \class CLQManager
@@ -51,15 +93,30 @@
  */
 class CLQManager
 {
+	//! Per-Thread Handle 은 Process 의 Attach 정보(Ring, Memory Pool, Backup)를 공유
+	friend class CLQHandle;
+
 	public:
 		//! Constructor
 		CLQManager(char *a_szPkgName, char *a_szNodeType, char *a_szProcName, int a_nInstanceID, bool a_bBackup, bool a_bMSync, char *a_szLogPath=NULL);
 		//! Destructor
 		~CLQManager();
 		//! Initialize
-		int Initialize(int a_nCmdType, p_function_hash *a_pFunc = NULL);
+		int Initialize(int a_nCmdType, p_function_hash *a_pFunc = NULL, int a_nWaitMode = DEF_WAIT_MODE_SIGNAL);
 		//! Wait Data
 		int ReadWait ();	
+		//! Set Max Spin Budget of Hybrid Wait Mode
+		void SetSpinBudget(uint32_t a_unMaxUsec);
+		//! Set Watermark Event Function and Throttling of Write Rings
+		void SetWatermarkFunc(p_function_watermark *a_pFunc, void *a_pArgs = NULL, uint32_t a_unThrottleUsec = 0);
+		//! Poll Low Watermark of All Write Rings
+		int PollWatermark();
+		//! Start Group Commit of Backup Files (Background msync Thread)
+		int SetGroupCommit(uint32_t a_unMsgCnt = DEF_SYNC_MSG_CNT, uint32_t a_unUsec = DEF_SYNC_USEC);
+		//! Start Async Backup (Background Backup Writer Thread)
+		int SetAsyncBackup(uint32_t a_unStageCnt = DEF_BK_STAGE_CNT);
+		//! Set Ack Interval to msync Consumer Checkpoint File
+		int SetCheckpointInterval(uint32_t a_unAckCnt = DEF_CKPT_ACK_CNT);
 		//! Get Error Msg
 		char *GetErrorMsg();
 		//! Get Write Queue Index
@@ -74,10 +131,14 @@ class CLQManager
 		void GetRingList(struct rte_ring **a_arrRing);
 		//! Write Data (For Util)
 		int WriteData( struct rte_ring *a_pstRing, char *a_pszData, int a_nSize );
+		//! Write Bulk Data (For Util, Thread Safe)
+		int WriteBulkData( struct rte_ring *a_pstRing, struct iovec *a_pstIov, int a_nCnt );
 		
 		//################ One Data Function ################//
 		//! Read a Data From Ring
 		int ReadData( char **a_pszBuff );
+		//! Read a Data From Ring (Zero Copy, Segment List)
+		int ReadData( struct iovec *a_pstIov, int *a_pnIovCnt );
 		//! Write Data (Hash Function)
 		int WriteDataHash( void *a_pArgs = NULL );
 		//! Write Data (Index)
@@ -86,6 +147,16 @@ class CLQManager
 		int WriteData( char *a_pszData, int a_nSize, int a_nIdx = 0);
 		//! Write Data (Index)
 		int WriteDataHash( char *a_pszData, int a_nSize, void *a_pArgs = NULL);
+		//! Write Data (Index, Wait until Consumer frees Space or Timeout)
+		int WriteDataWait( char *a_pszData, int a_nSize, int a_nIdx = 0, int a_nTimeout = -1 );
+		//! Reserve Memory Buffer to Write Data in Place (Zero Copy)
+		int Reserve( char **a_pszBuff, int a_nSize );
+		//! Reserve Memory Buffer Chain to Write Data in Place (Zero Copy, Segment List)
+		int Reserve( struct iovec *a_pstIov, int *a_pnIovCnt, int a_nSize );
+		//! Commit Reserved Memory Buffer to Queue
+		int Commit( int a_nIdx = 0 );
+		//! Abort Reserved Memory Buffer
+		void Abort();
 		//! Read Complete
 		int ReadComplete();
 		//! Free Read Data
@@ -96,14 +167,20 @@ class CLQManager
 		//################ Bulk Mode Function ################//
 		//! Read several Data From Ring
 		int ReadBulkData( int a_nCount );
+		//! Read up to N Data From Ring
+		int ReadBurstData( int a_nCount );
 		//! Read Next Memory Buffer (Bulk Mode 에서만 사용)
 		int GetNext( char **a_pszBuff );
+		//! Read Next Memory Buffer as Segment List (Bulk Mode 에서만 사용, Zero Copy)
+		int GetNext( struct iovec *a_pstIov, int *a_pnIovCnt );
 		//! Insert Data (Bulk Mode 에서만 사용)
 		int InsertData( char *a_pszData, int a_nSize);
 		//! Insert Data (Bulk Mode 에서만 사용)
 		int InsertData();
 		//! Commit Data to Queue
 		int CommitData(int a_nIdx=0);
+		//! Commit Data to Queue (Wait until Consumer frees Space or Timeout)
+		int CommitDataWait(int a_nIdx=0, int a_nTimeout=-1);
 		//! Free Read Bulk Data
 		void FreeReadBulkData();
 		//####################################################//
@@ -118,6 +195,8 @@ class CLQManager
 		int ReceiveCommand(char **a_pszBuff);
 		//! Send Result of Command
 		int SendCommandResult(char *a_pstData, int a_nSize);
+		//! Send Topology Command (Attach / Detach Ring) to Process
+		int SendTopology(char *a_szProcName, int a_nInstanceID, int a_nOp, int a_nType, char *a_szWrite, char *a_szRead, char a_cMultiType = 0, int a_nElemCnt = DEF_DEFAULT_RING_COUNT, uint32_t a_unHighWm = 0, uint32_t a_unLowWm = 0);
 		//##################################################//
 
 		
@@ -150,6 +229,20 @@ class CLQManager
 		RING_INFO m_stWriteRingInfo[DEF_MAX_RING];
 		//! Mempool For Data
 		struct rte_mempool *m_pstDataMemPool;
+		//! Size Class Table (Grow Chunk 가 추가될 때마다 다음 Table 을 사용)
+		MBUF_CLASS_TABLE m_stMbufClassTbl[DEF_MAX_GROW_CHUNK + 1];
+		//! Current Size Class Table
+		MBUF_CLASS_TABLE * volatile m_pstMbufClass;
+		//! Index of Current Size Class Table
+		int m_nMbufClassVer;
+		//! Count of Grow Chunk which this Process Knows
+		int m_nGrowChunk;
+		//! Max Count of Grow Chunk (0 : Disable)
+		int m_nMaxGrowChunk;
+		//! Count of Memory Buffer per Grow Chunk
+		uint32_t m_unGrowCount;
+		//! Lock For Grow Data Mempool
+		pthread_mutex_t m_stGrowLock;
 		//! Mempool For Command
 		struct rte_mempool *m_pstCmdMemPool;
 		//! Command 를 수신하기 위한 Ring
@@ -164,6 +257,8 @@ class CLQManager
 		struct rte_mbuf *m_pstReadMbuf[DEF_MEM_BUF_1024];
 		//! Bulk Mode 에서 데이터를 쓰기 위한 Memory Buffer 
 		struct rte_mbuf *m_pstWriteMbuf[DEF_MEM_BUF_1024];
+		//! Reserve 후 Commit 되지 않은 Memory Buffer
+		struct rte_mbuf *m_pstReserveMbuf;
 
 		//###############################################//
 
@@ -171,11 +266,11 @@ class CLQManager
 		//! Signal 을 수신하였을 때 인자값으로 넘어오는 Ring(Queue) 에서 현재 프로세스의 Consumer Index 정보
 		uint8_t m_unReadIdx;
 		//! Bulk Mode 에서 사용되는  m_pstReadMBuf 배열에서 현재 Index 위치
-		uint8_t m_unCurReadMbufIdx;
+		uint16_t m_unCurReadMbufIdx;
 		//! Bulk Mode 에서 사용되는  m_pstReadMBuf 배열의 Total Size
-		uint8_t m_unTotReadMbufIdx;
+		uint16_t m_unTotReadMbufIdx;
 		//! Bulk Mode 에서 사용되는  m_pstWriteMBuf 배열에서 현재 Index 위치
-		uint8_t m_unCurWriteMbufIdx;
+		uint16_t m_unCurWriteMbufIdx;
 		//! Read Ring Current Count
 		uint8_t	m_unReadRingCount;
 		//! Write Ring Curret Count
@@ -188,6 +283,61 @@ class CLQManager
 		bool m_bReadComplete;
 		//! mmap Sync Flag
 		bool m_bMsync;
+		//! Backup File 접근을 직렬화 하기 위한 Lock (CLQHandle 사용 시)
+		pthread_mutex_t m_stBackupLock;
+		//! Group Commit Flag (true : Background Thread 가 msync)
+		bool m_bGroupCommit;
+		//! Group Commit Thread 실행 Flag
+		volatile bool m_bSyncRun;
+		//! Group Commit 시 바로 msync 할 Sync 되지 않은 데이터 Count
+		uint32_t m_unSyncMsgCnt;
+		//! Group Commit Interval (usec)
+		uint32_t m_unSyncUsec;
+		//! Group Commit Thread
+		pthread_t m_stSyncThread;
+		//! Backup File 의 Dirty Range 를 보호하기 위한 Lock (Group Commit)
+		pthread_mutex_t m_stSyncLock;
+		//! Group Commit Thread 를 깨우기 위한 Condition
+		pthread_cond_t m_stSyncCond;
+		//! Consumer Checkpoint File 을 msync 할 ReadComplete Count
+		uint32_t m_unCkptAckCnt;
+		//! Async Backup Flag (true : Backup Writer Thread 가 Backup File 에 기록)
+		bool m_bAsyncBackup;
+		//! Backup Writer Thread 실행 Flag
+		volatile bool m_bAsyncRun;
+		//! Backup Writer Thread 에 Stage (BACKUP_STAGE) 를 전달하는 Process 내부 Ring
+		struct rte_ring *m_pstStageRing;
+		//! 사용하지 않는 Stage (BACKUP_STAGE) 의 Ring
+		struct rte_ring *m_pstStageFree;
+		//! Stage Array (Staging Ring 의 크기 - 1)
+		BACKUP_STAGE *m_pstStage;
+		//! Backup Writer Thread 의 마지막 기록 실패 (다음 Stage 시 -E_Q_BACKUP 으로 보고)
+		volatile int m_nAsyncBackupErr;
+		//! Backup Writer Thread
+		pthread_t m_stAsyncThread;
+		//! Wakeup Mode (DEF_WAIT_MODE_SIGNAL / DEF_WAIT_MODE_FUTEX)
+		int m_nWaitMode;
+		//! Command Receive Ring 에서 현재 프로세스의 Consumer Index 정보
+		uint32_t m_unCmdRcvIdx;
+		//! Futex Mode 에서 Data 가 있는 Ring 을 찾기 시작할 m_stReadRingInfo 의 Index (Round Robin)
+		uint8_t m_unWaitRingIdx;
+		//! Hybrid Mode 의 Max Spin Budget (usec)
+		uint32_t m_unSpinMaxUsec;
+		//! Hybrid Mode 의 Max Spin Budget (TSC Cycles)
+		uint64_t m_unSpinMaxCycles;
+		//! Topology Epoch (Ring Table 에서 Ring 이 Detach 될 때마다 증가)
+		volatile uint64_t m_unTopoEpoch;
+		//! Group Commit Thread 의 Epoch Slot Index
+		int m_nSyncEpochSlot;
+		//! Mempool Cache 의 lcore Slot 을 할당 받은 Thread (Initialize 를 호출한 Thread, m_bSlotAttached 가 true 일 때 유효)
+		pthread_t m_stSlotThread;
+		//! lcore Slot 할당 여부
+		bool m_bSlotAttached;
+		//###############################################//
+
+		//#################### Epoch ####################//
+		//! Ring Table 을 읽는 Thread 별 Epoch Slot (0 : CLQManager 를 사용하는 Thread, CLQManager 는 한 Thread 에서만 사용하므로 unNest 는 Atomic 이 아님)
+		EPOCH_SLOT m_stEpochSlot[DEF_MAX_EPOCH_SLOT];
 		//###############################################//
 
 		//#################### Signal ###################//
@@ -196,6 +346,11 @@ class CLQManager
 		siginfo_t	m_stSigInfo;
 		//###############################################//
 
+		//#################### Futex ####################//
+		//! Futex Mode 에서 현재 프로세스가 대기하는 Futex Word (Shared Memory)
+		rte_atomic32_t *m_pstFutex;
+		//###############################################//
+
 		//! Db Connector
 		DB *m_pclsDbConn;
 		//! Global Config Class
@@ -203,6 +358,17 @@ class CLQManager
 		//! Function For Hash
 		p_function_hash *m_pfuncHash;
 
+		//################## Watermark ##################//
+		//! Function For Watermark Event (NULL : Event 미사용)
+		p_function_watermark *m_pfuncWatermark;
+		//! Arguments of Watermark Event Function
+		void *m_pWmArgs;
+		//! High Watermark 를 넘은 Write Ring 에 입력하기 전에 대기할 시간 (usec, 0 : Throttling 미사용)
+		uint32_t m_unWmThrottleUsec;
+		//! High Watermark 를 넘은 상태의 Write Ring 수 (0 이면 Write Path 에서 Watermark 를 확인하지 않음)
+		volatile uint32_t m_unWmOverCnt;
+		//###############################################//
+
 		//! Set Error Msg
 		void SetErrorMsg(const char *a_szFmt, ...);
 		//! Generate Query
@@ -210,27 +376,119 @@ class CLQManager
 		//! Generate Q Name
 		char *GetQName(const char *a_szWrite, const char *a_szRead, char a_cMultiType);
 		//! Attach Ring
-		int AttachRing(const char *a_szWrite, const char *a_szRead, int a_nElemCnt, int a_nType, char a_cMultiType);	
+		int AttachRing(const char *a_szWrite, const char *a_szRead, int a_nElemCnt, int a_nType, char a_cMultiType, uint32_t a_unHighWm = 0, uint32_t a_unLowWm = 0);	
+		//! Set High / Low Watermark of Ring (Queue Definition)
+		int SetRingWatermark(struct rte_ring *a_pstRing, uint32_t a_unHighWm, uint32_t a_unLowWm);
+		//! Find Index of Write Ring
+		int FindWriteRing(struct rte_ring *a_pstRing);
+		//! Check Low Watermark and Throttle before Enqueue (Producer)
+		void CheckWatermark(struct rte_ring *a_pstRing);
+		//! Raise Low Watermark Event if Consumer drained Write Ring (Producer)
+		bool LeaveWatermark(int a_nIdx, struct rte_ring *a_pstRing);
+		//! Raise High Watermark Event (Producer, Enqueue Return -EDQUOT)
+		void RaiseWatermark(struct rte_ring *a_pstRing);
 		//! Insert Consumers Info 
 		uint32_t InsertConsInfo(char *a_szName, int a_nInstanceID, pid_t a_stPID, struct rte_ring *a_pstRing);
 		//! Insert Producer Info 
 		uint32_t InsertProdInfo(char *a_szName, int a_nInstanceID, pid_t a_stPID, struct rte_ring *a_pstRing);
 		//! Send RTS to Consumer Process
-		int SendRTS(struct rte_ring *a_pstRing);
+		int SendRTS(struct rte_ring *a_pstRing, int a_nIdx);
 		//! Send RTS for Command
 		int SendRTSCommand(struct rte_ring *a_pstRing);
 		//! Set Sleep Status in the Ring
 		int SetSleepFlag(struct rte_ring *a_pstRing);
+		//! Alloc Memory Buffer Chain for Data Size
+		static int AllocMbuf(struct rte_mempool *a_pstMemPool, int a_nSize, struct rte_mbuf **a_ppstMbuf);
+		//! Load Size Class Memory Pools Created by LQ_INIT
+		int LoadMbufClass();
+		//! Add Size Class Memory Pool (rte_mempool_walk Callback)
+		static void AddMbufClass(const struct rte_mempool *a_pstMemPool, void *a_pArg);
+		//! Sort Size Class Table by Segment Size
+		static void SortMbufClass(MBUF_CLASS_TABLE *a_pstTbl);
+		//! Select Smallest Size Class which Data Fits in One Memory Buffer
+		static int SelectMbufClass(MBUF_CLASS_TABLE *a_pstTbl, uint32_t a_unSize);
+		//! Init Grow Chunk Config of Data Mempool
+		void InitGrowPool();
+		//! Grow Data Mempool by Adding a Chunk
+		int GrowDataPool(MBUF_CLASS_TABLE *a_pstTbl);
+		//! Alloc Memory Buffer Chain From Size Class Memory Pool
+		int AllocDataMbuf(int a_nSize, struct rte_mbuf **a_ppstMbuf);
+		//! Fill Segment List From Memory Buffer Chain
+		static int GetMbufIov(struct rte_mbuf *a_pstMbuf, struct iovec *a_pstIov, int *a_pnIovCnt);
+		//! Set or Clear Sleep Status and Sleep Mask of a Consumer
+		void SetConsSleep(struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSleep);
+		//! Init Futex Word of Consumer Info (Futex Mode)
+		int InitWaitMode();
+		//! Wait Data on Futex Word (Futex Mode)
+		int ReadWaitFutex();
+		//! Find Ring which has Data (Futex Mode)
+		int FindReadyRing();
+		//! Set or Clear Sleep Status in All Read Rings (Futex Mode)
+		void SetAllSleepFlag(uint32_t a_unSleep);
+		//! Wake Consumer Process Parked on Futex Word
+		void WakeFutex(struct rte_ring_cons_info *a_pstConsInfo);
+		//! Park Producer on Futex Word of Write Ring until Consumer frees Space
+		int WaitWriteSpace(EPOCH_SLOT *a_pstSlot, int a_nIdx, int a_nErr, uint64_t a_unDeadline);
+		//! Wake Producers Parked on Ring (Consumer 가 공간을 확보한 뒤 호출)
+		static void WakeProducer(struct rte_ring *a_pstRing);
+		//! Spin and Wait Data on Futex Word (Hybrid Mode)
+		int ReadWaitHybrid();
+		//! Get Spin Budget From Arrival Gap of Read Rings (Hybrid Mode)
+		uint64_t GetSpinBudget();
+		//! Update Arrival Gap of Read Ring (Hybrid Mode)
+		void UpdateArrivalGap(int a_nIdx, uint64_t a_unGap);
+		//! Detach Ring
+		int DetachRing(const char *a_szWrite, const char *a_szRead, int a_nType, char a_cMultiType);
+		//! Apply Topology Command (Attach / Detach Ring)
+		int ApplyTopology(TOPOLOGY_CMD *a_pstCmd);
+		//! Register Epoch Slot of Thread
+		int RegisterEpoch();
+		//! Unregister Epoch Slot of Thread
+		void UnregisterEpoch(int a_nSlot);
+		//! Wait until All Threads Leave Ring Table of Previous Epoch
+		void SyncEpoch();
+		//! Replace Relation Process List of Ring (Copy On Write)
+		void SetRelProc(RING_INFO *a_pstInfo, vector<string> *a_pvecRelProc);
+		//! Add Relation Process to Ring
+		void AddRelProc(RING_INFO *a_pstInfo, const char *a_szProc);
+		//! Remove Relation Process from Ring
+		int DelRelProc(RING_INFO *a_pstInfo, const char *a_szProc);
+		//! msync, munmap and close Backup File of Detached Ring
+		static void ReleaseBackup(struct rte_ring_backup_info *a_pstInfo);
+		//! Attach Queues in Catalog
+		int AttachCatalog( QUEUE_CATALOG *a_pstCatalog );
+		//! Attach Queues in TAT_QUEUE_DEF
+		int AttachQueueDB();
 		//! Init Backup Files
 		int InitBackupFile( struct rte_ring *a_pstRing, char *a_szFileName, int a_nType, int a_nIdx );
+		//! Init Consumer Checkpoint File
+		int InitCheckpointFile( struct rte_ring *a_pstRing, char *a_szFileName, int a_nIdx );
 		//! Backup Write Data
-		int BackupWriteData( struct rte_ring *a_pstRing, int a_nIdx );
+		int BackupWriteData( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt );
+		//! Write Enqueued Data to Backup File
+		int WriteBackupFile( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt );
+		//! Hand Enqueued Data to Backup Writer Thread (Async Backup)
+		int StageBackupData( struct rte_ring *a_pstRing, int a_nIdx, uint32_t a_unSeq, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt );
+		//! Backup Writer Thread (Async Backup)
+		static void *AsyncBackupThread( void *a_pArg );
+		//! msync Header, Index and Record Range of Backup File
+		static int SyncBackupFile( struct rte_ring_backup_info *a_pstInfo, uint32_t a_unHead, uint32_t a_unTail, int a_nFlags );
+		//! msync Consumer Checkpoint File
+		static int SyncCheckpoint( struct rte_ring_backup_info *a_pstInfo, int a_nIdx, int a_nFlags );
+		//! Add Range to Dirty Range of Backup File (Group Commit)
+		void MarkBackupDirty( struct rte_ring_backup_info *a_pstInfo, uint32_t a_unHead, uint32_t a_unTail );
+		//! msync Dirty Range of All Backup Files (Group Commit)
+		void FlushBackup();
+		//! Group Commit Thread
+		static void *SyncThread( void *a_pArg );
 		//! Backup Read Data
 		int BackupReadData( struct rte_ring *a_pstRing, int a_nIdx );
 		//! Insert Data (Bulk Mode 에서만 사용)
 		int InsertCommandData( char *a_pszData, int a_nSize);
 		//! Enqueue Data to Ring
-		int EnqueueData(struct rte_ring *a_pstRing, int a_nCnt, int a_nIdx);
+		int EnqueueData(struct rte_ring *a_pstRing, int a_nCnt, int a_nIdx, uint32_t *a_punSeq);
+		//! Enqueue Data to Broadcast Ring (Reference Count of Memory Buffer = Count of Subscribers)
+		static int EnqueueBcast(struct rte_ring *a_pstRing, struct rte_mbuf **a_pstMbuf, uint32_t a_unCnt, int a_nIdx, bool a_bHold, uint32_t *a_punSeq);
 };
 
 #endif
@@ -0,0 +1,45 @@
+/*!
+ * \file CLQMempool.h
+ * \brief Memory Pool Name Definition
+ * \details
+ * LQ_INIT 이 생성하고 각 Process 가 이름으로 찾아서 사용하는 Memory Pool 의 이름과 Size Class 의 수
+ * LQ_INIT 과 LQ API 가 함께 사용한다.
+ */
+
+#ifndef _LQ_MEMPOOL_H_
+#define _LQ_MEMPOOL_H_
+
+//! Define Memory Pool Name
+/*!
+ * Memory Pool Name For to Use in Application
+ */
+#define DEF_BASE_MEMORY_POOL_NAME    "BASE_MEMORY_POOL"
+
+//! Define Command Memory Pool Name
+/*!
+ * Memory Pool Name For to Use in Application
+ */
+#define DEF_CMD_MEMORY_POOL_NAME    "COMMAND_MEMORY_POOL"
+
+//! Define Size Class Memory Pool Name
+/*!
+ * LQ_INIT 이 QUEUE 의 MBUF_CLASS ("Data Size:Count(16진수),...") 설정으로 생성하는 Size Class 별 Memory Pool
+ * BASE_MEMORY_POOL (RTE_MBUF_DATA_SIZE) 도 하나의 Size Class 로 사용한다
+ */
+#define DEF_MBUF_CLASS_POOL_NAME	"DATA_POOL_%u"
+
+//! Define Prefix of Size Class Memory Pool Name
+#define DEF_MBUF_CLASS_POOL_PREFIX	"DATA_POOL_"
+
+//! Define Max Count of Size Class (BASE_MEMORY_POOL 포함)
+#define DEF_MAX_MBUF_CLASS	8
+
+//! Define Grow Chunk Memory Pool Name
+/*!
+ * BASE_MEMORY_POOL 이 부족할 때 Process 가 생성하는 추가 Memory Pool (Chunk)
+ * QUEUE 의 MBUF_GROW_COUNT (Chunk 당 Memory Buffer 수, 16진수) 와 MBUF_MAX_COUNT (BASE_MEMORY_POOL 을 포함한 최대 수, 16진수) 로 설정
+ * 이름이 DEF_MBUF_CLASS_POOL_PREFIX 로 시작하므로 이후에 Attach 하는 Process 는 Size Class 로 함께 읽는다
+ */
+#define DEF_MBUF_GROW_POOL_NAME	"DATA_POOL_GROW_%d"
+
+#endif
@@ -3,15 +3,38 @@
 
 #undef DEF_QUERY_INIT_READ_Q
 #define DEF_QUERY_INIT_READ_Q \
-	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE FROM TAT_QUEUE_DEF " \
+	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, HIGH_WM, LOW_WM FROM TAT_QUEUE_DEF " \
 	"WHERE " \
 	"PKG_NAME = '%s' AND NODE_TYPE = '%s' AND READ_PROC = '%s'" 
 
 #undef DEF_QUERY_INIT_WRITE_Q
 #define DEF_QUERY_INIT_WRITE_Q \
-	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE FROM TAT_QUEUE_DEF " \
+	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, HIGH_WM, LOW_WM FROM TAT_QUEUE_DEF " \
 	"WHERE " \
 	"PKG_NAME = '%s' AND NODE_TYPE = '%s' AND WRITE_PROC = '%s'" 
 
-#endif
+#undef DEF_QUERY_INIT_CATALOG
+#define DEF_QUERY_INIT_CATALOG \
+	"SELECT PKG_NAME, NODE_TYPE, WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, HIGH_WM, LOW_WM FROM TAT_QUEUE_DEF" 
 
+/*
+ * HIGH_WM, LOW_WM Column 이 없는 TAT_QUEUE_DEF 에 사용 (Watermark 미사용 : 0)
+ * 위의 Query 가 실패하면 다음의 Query 로 다시 조회한다
+ */
+#undef DEF_QUERY_INIT_READ_Q_NO_WM
+#define DEF_QUERY_INIT_READ_Q_NO_WM \
+	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, 0, 0 FROM TAT_QUEUE_DEF " \
+	"WHERE " \
+	"PKG_NAME = '%s' AND NODE_TYPE = '%s' AND READ_PROC = '%s'" 
+
+#undef DEF_QUERY_INIT_WRITE_Q_NO_WM
+#define DEF_QUERY_INIT_WRITE_Q_NO_WM \
+	"SELECT WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, 0, 0 FROM TAT_QUEUE_DEF " \
+	"WHERE " \
+	"PKG_NAME = '%s' AND NODE_TYPE = '%s' AND WRITE_PROC = '%s'" 
+
+#undef DEF_QUERY_INIT_CATALOG_NO_WM
+#define DEF_QUERY_INIT_CATALOG_NO_WM \
+	"SELECT PKG_NAME, NODE_TYPE, WRITE_PROC, READ_PROC, ELEM_CNT, BI_DIR_YN, MULTI_TYPE, 0, 0 FROM TAT_QUEUE_DEF" 
+
+#endif
@@ -11,6 +11,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <string.h>
+#include <new>
 
 // Include Definition For DPDK Envirionment Variables and Functions
 #include <rte_config.h>
@@ -28,6 +29,11 @@
 #include <rte_mbuf.h>
 #include <rte_errno.h>
 
+// Include Definition For TAT_QUEUE_DEF
+#include "MariaDB.hpp"
+#include "FetchMaria.hpp"
+#include "CQuery.hpp"
+
 /*! 
  * \class CLQInit
  * \brief CMRT Main Class
@@ -39,10 +45,12 @@
  * \brief Constructor For CLQInit Class
  * \details Init Variables 
  * \param a_strLogPath is Log file path if NULL, default stdout
+ * \param a_strCatalogFile is Queue Catalog File path if NULL, Load From TAT_QUEUE_DEF
  */
-CLQInit::CLQInit(char *a_strLogPath)
+CLQInit::CLQInit(char *a_strLogPath, char *a_strCatalogFile)
 {
 	m_pLogPath = NULL;
+	m_pCatalogFile = a_strCatalogFile;
 
 	//Copy Log path
 	memset(m_strLogPath, 0x00, sizeof(m_strLogPath));
@@ -85,6 +93,9 @@ int CLQInit::Initialize()
 	int ret = 0;
 	struct rte_ipc_config stIpcConfig;
 	uint32_t unMbufCount = 0;
+	uint32_t unCmdCount = 0;
+	uint32_t unCmdSize = 0;
+	char *pValue = NULL;
 	uint64_t unSize = 0;
 
 	CConfig *pclsConfig = new CConfig();
@@ -154,8 +165,20 @@ int CLQInit::Initialize()
 		return -1;
 	}
 
-	m_pstCmdMemPool = rte_mempool_create(DEF_CMD_MEMORY_POOL_NAME, DEF_MBUF_COUNT,
-										RTE_MBUF_SIZE, RTE_MBUF_CACHE_SIZE,
+	//Command Memory Pool 은 Data Memory Pool 과 별도로 설정하며, 설정이 없으면 작은 기본값을 사용
+	//Command 는 자주 발생하지 않으므로 lcore Cache 에 Memory Buffer 가 묶이지 않도록 Cache 를 사용하지 않는다
+	pValue = pclsConfig->GetConfigValue("QUEUE", "CMD_MBUF_COUNT");
+	unCmdCount = (pValue == NULL) ? 0 : strtoul(pValue, NULL, 16);
+	if(unCmdCount == 0)
+		unCmdCount = DEF_CMD_MBUF_COUNT;
+
+	pValue = pclsConfig->GetConfigValue("QUEUE", "CMD_MBUF_SIZE");
+	unCmdSize = (pValue == NULL) ? 0 : strtoul(pValue, NULL, 10);
+	if(unCmdSize == 0 || unCmdSize + RTE_PKTMBUF_HEADROOM > UINT16_MAX)
+		unCmdSize = DEF_CMD_MBUF_DATA_SIZE;
+
+	m_pstCmdMemPool = rte_mempool_create(DEF_CMD_MEMORY_POOL_NAME, unCmdCount,
+										unCmdSize + RTE_MBUF_OVERHEAD, 0,
 										sizeof(struct rte_pktmbuf_pool_private), rte_pktmbuf_pool_init,
 										NULL, rte_pktmbuf_init, NULL, SOCKET_ID_ANY, 0); 
 	if(m_pstCmdMemPool == NULL)
@@ -164,6 +187,8 @@ int CLQInit::Initialize()
 		return -1;
 	}
 
+	RTE_LOG( INFO, EAL, "Command Memory Pool Count %u, Data Size %u\n", unCmdCount, unCmdSize);
+
 	struct rte_mbuf *tmp = (struct rte_mbuf*)rte_pktmbuf_alloc(m_pstDataMemPool);
 	RTE_LOG( INFO, EAL, "base mbuf data_len %u, buf_len %u, buf_addr %p\n", tmp->data_len, tmp->buf_len, tmp->buf_addr);
 	RTE_LOG( INFO, EAL, "mbuf data Buffer %p\n", rte_pktmbuf_mtod(tmp, void*));
@@ -172,6 +197,319 @@ int CLQInit::Initialize()
 	RTE_LOG( INFO, EAL, "DEF_MBUF_CACHE_SIZE %d\n", RTE_MBUF_CACHE_SIZE);
 	RTE_LOG( INFO, EAL, "DEF_PRIVATE_ %lu\n", sizeof(struct rte_pktmbuf_pool_private));
 
+	//Size Class Memory Pool, 설정이 없으면 BASE_MEMORY_POOL 만 사용
+	if(InitMbufClass(pclsConfig) < 0)
+	{
+		RTE_LOG (ERR, MEMPOOL, "Cannot Create Size Class Memory Pool\n");
+		return -1;
+	}
+
+	//Catalog 가 없으면 각 Process 가 DB 를 조회하므로 실패하여도 계속 진행
+	if(InitCatalog(pclsConfig) < 0)
+	{
+		RTE_LOG (ERR, EAL, "Cannot Init Queue Catalog, Processes will Query DB\n");
+	}
+
+	return 0;
+}
+
+//! Init Size Class Memory Pool
+/*!
+ * \brief Create Size Class Memory Pools
+ * \details QUEUE 의 MBUF_CLASS 설정 ("Data Size:Count(16진수),..." 예 : "256:0x100000,16384:0x4000") 을 읽어서
+ * Data Size 별 Memory Pool 을 생성한다. 각 Process 는 데이터가 한개의 Memory Buffer 에 들어가는 가장 작은 Size Class 를 사용한다.
+ * RTE_MBUF_DATA_SIZE 는 BASE_MEMORY_POOL 이 사용하므로 생성하지 않는다.
+ * \param a_pclsConfig is Config Class
+ * \return Succ 0, Fail -1
+ */
+int CLQInit::InitMbufClass(CConfig *a_pclsConfig)
+{
+	int nClassCnt = 1;
+	char szClass[DEF_MEM_BUF_256];
+	char szName[RTE_MEMPOOL_NAMESIZE];
+	char *pSave = NULL;
+	char *pToken = NULL;
+	char *pCount = NULL;
+	char *pValue = NULL;
+	uint32_t unDataSize = 0;
+	uint32_t unCount = 0;
+	struct rte_mempool *pstMemPool = NULL;
+
+	pValue = a_pclsConfig->GetConfigValue("QUEUE", "MBUF_CLASS");
+	if(pValue == NULL || strlen(pValue) == 0)
+		return 0;
+
+	snprintf(szClass, sizeof(szClass), "%s", pValue);
+	for(pToken = strtok_r(szClass, ",", &pSave); pToken != NULL; pToken = strtok_r(NULL, ",", &pSave))
+	{
+		pCount = strchr(pToken, ':');
+		if(pCount == NULL)
+		{
+			RTE_LOG (ERR, MEMPOOL, "Invalid MBUF_CLASS [%s]\n", pToken);
+			return -1;
+		}
+
+		unDataSize = strtoul(pToken, NULL, 10);
+		unCount = strtoul(pCount + 1, NULL, 16);
+
+		//Memory Buffer 의 buf_len 은 uint16_t
+		if(unDataSize == 0 || unCount == 0 || unDataSize + RTE_PKTMBUF_HEADROOM > UINT16_MAX)
+		{
+			RTE_LOG (ERR, MEMPOOL, "Invalid MBUF_CLASS [%s]\n", pToken);
+			return -1;
+		}
+
+		if(unDataSize == RTE_MBUF_DATA_SIZE)
+			continue;
+
+		if(nClassCnt >= DEF_MAX_MBUF_CLASS)
+		{
+			RTE_LOG (ERR, MEMPOOL, "Too Many MBUF_CLASS, Max %d\n", DEF_MAX_MBUF_CLASS);
+			return -1;
+		}
+
+		snprintf(szName, sizeof(szName), DEF_MBUF_CLASS_POOL_NAME, unDataSize);
+		pstMemPool = rte_mempool_create(szName, unCount,
+										unDataSize + RTE_MBUF_OVERHEAD, RTE_MIN((uint32_t)RTE_MBUF_CACHE_SIZE, unCount / 2),
+										sizeof(struct rte_pktmbuf_pool_private), rte_pktmbuf_pool_init,
+										NULL, rte_pktmbuf_init, NULL, SOCKET_ID_ANY, 0); 
+		if(pstMemPool == NULL)
+		{
+			RTE_LOG (ERR, MEMPOOL, "Cannot Create Memory Pool %s, errno : %d\n", szName, rte_errno);
+			return -1;
+		}
+
+		RTE_LOG( INFO, EAL, "Size Class %s, Data Size %u, Count %u\n", szName, unDataSize, unCount);
+		nClassCnt++;
+	}
+
+	return 0;
+}
+
+/*!
+ * \brief Compare Queue Definition (PKG_NAME, NODE_TYPE, Row Order)
+ * \param a_pA is Queue Definition
+ * \param a_pB is Queue Definition
+ * \return strcmp Result
+ */
+static int CompareQueueDef(const void *a_pA, const void *a_pB)
+{
+	const QUEUE_DEF *pstA = (const QUEUE_DEF*)a_pA;
+	const QUEUE_DEF *pstB = (const QUEUE_DEF*)a_pB;
+	int ret = 0;
+
+	ret = strcmp(pstA->szPkgName, pstB->szPkgName);
+	if(ret != 0)
+		return ret;
+
+	ret = strcmp(pstA->szNodeType, pstB->szNodeType);
+	if(ret != 0)
+		return ret;
+
+	//qsort 는 Stable 하지 않으므로 같은 PKG_NAME, NODE_TYPE 은 읽은 순서를 유지
+	return (pstA->unRowIdx < pstB->unRowIdx) ? -1 : (pstA->unRowIdx > pstB->unRowIdx);
+}
+
+//! Init Queue Topology Catalog
+/*!
+ * \brief Init Queue Topology Catalog Memory Zone
+ * \details TAT_QUEUE_DEF (혹은 Catalog File) 을 읽어서 Memory Zone 에 PKG_NAME, NODE_TYPE 순으로 기록한다.
+ * 모두 기록한 뒤에 Magic 을 설정하며, 각 Process 는 Magic 이 설정된 경우에만 Catalog 를 사용한다.
+ * \param a_pclsConfig is Config Class
+ * \return Succ 0, Fail -1
+ */
+int CLQInit::InitCatalog(CConfig *a_pclsConfig)
+{
+	int ret = 0;
+	const struct rte_memzone *pstMz = NULL;
+	QUEUE_CATALOG *pstCatalog = NULL;
+
+	pstMz = rte_memzone_reserve(DEF_STR_QUEUE_CATALOG, sizeof(QUEUE_CATALOG), SOCKET_ID_ANY, 0);
+	if(pstMz == NULL)
+	{
+		RTE_LOG (ERR, EAL, "Cannot Reserve Catalog Memory Zone errno : %d\n", rte_errno);
+		return -1;
+	}
+
+	pstCatalog = (QUEUE_CATALOG*)pstMz->addr;
+	pstCatalog->unMagic = 0;
+	pstCatalog->unCount = 0;
+
+	if(m_pCatalogFile != NULL)
+		ret = LoadCatalogFile(pstCatalog);
+	else
+		ret = LoadCatalogDB(pstCatalog, a_pclsConfig);
+
+	if(ret < 0)
+		return -1;
+
+	qsort(pstCatalog->stDef, pstCatalog->unCount, sizeof(QUEUE_DEF), CompareQueueDef);
+
+	rte_wmb();
+	pstCatalog->unMagic = DEF_CATALOG_MAGIC;
+
+	RTE_LOG( INFO, EAL, "Queue Catalog Count %u\n", pstCatalog->unCount);
+
+	return 0;
+}
+
+//! Load Queue Definition From Catalog File
+/*!
+ * \brief Load Queue Definition From Catalog File
+ * \details 한 줄에 하나의 Queue 를 다음의 순서로 기록한다. ('#' 으로 시작하는 줄은 무시)
+ * PKG_NAME NODE_TYPE WRITE_PROC READ_PROC ELEM_CNT BI_DIR_YN [MULTI_TYPE [HIGH_WM LOW_WM]]
+ * Watermark 만 지정할 경우 MULTI_TYPE 에 '-' 를 기록한다. (HIGH_WM, LOW_WM : Ring Size 대비 %)
+ * \param a_pstCatalog is Catalog
+ * \return Succ 0, Fail -1
+ */
+int CLQInit::LoadCatalogFile(QUEUE_CATALOG *a_pstCatalog)
+{
+	FILE *fp = NULL;
+	char szLine[DEF_MEM_BUF_256 * 2];
+	QUEUE_DEF *pstDef = NULL;
+	int nField = 0;
+
+	fp = fopen(m_pCatalogFile, "r");
+	if(fp == NULL)
+	{
+		RTE_LOG (ERR, EAL, "Catalog File (%s) Open Error %d\n", m_pCatalogFile, errno);
+		return -1;
+	}
+
+	while(fgets(szLine, sizeof(szLine), fp) != NULL)
+	{
+		if(szLine[0] == '#' || szLine[0] == '\n' || szLine[0] == '\0')
+			continue;
+
+		if(a_pstCatalog->unCount >= DEF_MAX_QUEUE_DEF)
+		{
+			RTE_LOG (ERR, EAL, "Too many Queue Definition (Max %d)\n", DEF_MAX_QUEUE_DEF);
+			fclose(fp);
+			return -1;
+		}
+
+		pstDef = &(a_pstCatalog->stDef[a_pstCatalog->unCount]);
+		memset(pstDef, 0x00, sizeof(QUEUE_DEF));
+
+		nField = sscanf(szLine, "%63s %63s %63s %63s %u %c %c %u %u"
+						, pstDef->szPkgName, pstDef->szNodeType, pstDef->szWriteProc, pstDef->szReadProc
+						, &pstDef->unElemCnt, &pstDef->cBiDir, &pstDef->cMultiType
+						, &pstDef->unHighWm, &pstDef->unLowWm);
+		if(nField < 6)
+		{
+			RTE_LOG (ERR, EAL, "Invalid Catalog Line [%s]\n", szLine);
+			fclose(fp);
+			return -1;
+		}
+
+		if(pstDef->cMultiType == '-')
+			pstDef->cMultiType = 0;
+
+		pstDef->unRowIdx = a_pstCatalog->unCount;
+		a_pstCatalog->unCount++;
+	}
+
+	fclose(fp);
+
+	return 0;
+}
+
+//! Load Queue Definition From TAT_QUEUE_DEF
+/*!
+ * \brief Load All Queue Definition From TAT_QUEUE_DEF
+ * \param a_pstCatalog is Catalog
+ * \param a_pclsConfig is Config Class
+ * \return Succ 0, Fail -1
+ */
+int CLQInit::LoadCatalogDB(QUEUE_CATALOG *a_pstCatalog, CConfig *a_pclsConfig)
+{
+	int ret = 0;
+	DB *pclsDbConn = NULL;
+	QUEUE_DEF *pstDef = NULL;
+	FetchMaria fdata;
+
+	char szPkgName	[DEF_CATALOG_NAME_LEN];
+	char szNodeType	[DEF_CATALOG_NAME_LEN];
+	char szWriteProc[DEF_CATALOG_NAME_LEN];
+	char szReadProc	[DEF_CATALOG_NAME_LEN];
+	char szElemCnt	[DEF_CATALOG_NAME_LEN];
+	char szBiDir	[DEF_CATALOG_NAME_LEN];
+	char szMultiType[DEF_CATALOG_NAME_LEN];
+	char szHighWm	[DEF_CATALOG_NAME_LEN];
+	char szLowWm	[DEF_CATALOG_NAME_LEN];
+
+	pclsDbConn = new (std::nothrow) MariaDB();
+	if(pclsDbConn == NULL)
+	{
+		RTE_LOG (ERR, EAL, "new operator Fail [%d:%s]\n", errno, strerror(errno));
+		return -1;
+	}
+
+	ret = pclsDbConn->Connect(
+								a_pclsConfig->GetGlobalConfigValue("DB_HOST"), 
+								atoi(a_pclsConfig->GetGlobalConfigValue("DB_PORT")), 
+								a_pclsConfig->GetGlobalConfigValue("DB_USER"), 
+								a_pclsConfig->GetGlobalConfigValue("DB_PASS"), 
+								a_pclsConfig->GetGlobalConfigValue("DB_DATABASE")
+							);
+	if(ret != true)
+	{
+		RTE_LOG (ERR, EAL, "Cannot Init Mysql DB [%d:%s]\n", pclsDbConn->GetError(), pclsDbConn->GetErrorMsg());
+		delete pclsDbConn;
+		return -1;
+	}
+
+	ret = pclsDbConn->Query(DEF_QUERY_INIT_CATALOG, strlen(DEF_QUERY_INIT_CATALOG));
+	if(ret < 0)
+	{
+		//HIGH_WM, LOW_WM Column 이 없는 Table 이면 Watermark 없이 조회
+		RTE_LOG (INFO, EAL, "Query Fail [%s] [%d:%s], Retry without Watermark\n", DEF_QUERY_INIT_CATALOG, pclsDbConn->GetError(), pclsDbConn->GetErrorMsg());
+		ret = pclsDbConn->Query(DEF_QUERY_INIT_CATALOG_NO_WM, strlen(DEF_QUERY_INIT_CATALOG_NO_WM));
+	}
+
+	if(ret < 0)
+	{
+		RTE_LOG (ERR, EAL, "Query Fail [%s] [%d:%s]\n", DEF_QUERY_INIT_CATALOG_NO_WM, pclsDbConn->GetError(), pclsDbConn->GetErrorMsg());
+		delete pclsDbConn;
+		return -1;
+	}
+
+	fdata.Clear();
+	fdata.Set(szPkgName		, sizeof(szPkgName));	
+	fdata.Set(szNodeType	, sizeof(szNodeType));	
+	fdata.Set(szWriteProc	, sizeof(szWriteProc));	
+	fdata.Set(szReadProc	, sizeof(szReadProc));	
+	fdata.Set(szElemCnt		, sizeof(szElemCnt));	
+	fdata.Set(szBiDir		, sizeof(szBiDir));	
+	fdata.Set(szMultiType	, sizeof(szMultiType));	
+	fdata.Set(szHighWm		, sizeof(szHighWm));	
+	fdata.Set(szLowWm		, sizeof(szLowWm));	
+
+	while(fdata.Fetch(pclsDbConn) == true)
+	{
+		if(a_pstCatalog->unCount >= DEF_MAX_QUEUE_DEF)
+		{
+			RTE_LOG (ERR, EAL, "Too many Queue Definition (Max %d)\n", DEF_MAX_QUEUE_DEF);
+			delete pclsDbConn;
+			return -1;
+		}
+
+		pstDef = &(a_pstCatalog->stDef[a_pstCatalog->unCount]);
+		memset(pstDef, 0x00, sizeof(QUEUE_DEF));
+		pstDef->unRowIdx = a_pstCatalog->unCount++;
+		snprintf(pstDef->szPkgName, sizeof(pstDef->szPkgName), "%s", szPkgName);
+		snprintf(pstDef->szNodeType, sizeof(pstDef->szNodeType), "%s", szNodeType);
+		snprintf(pstDef->szWriteProc, sizeof(pstDef->szWriteProc), "%s", szWriteProc);
+		snprintf(pstDef->szReadProc, sizeof(pstDef->szReadProc), "%s", szReadProc);
+		pstDef->unElemCnt = atoi(szElemCnt);
+		pstDef->cBiDir = szBiDir[0];
+		pstDef->cMultiType = szMultiType[0];
+		pstDef->unHighWm = atoi(szHighWm);
+		pstDef->unLowWm = atoi(szLowWm);
+	}
+
+	delete pclsDbConn;
+
 	return 0;
 }
 
@@ -180,6 +518,8 @@ void print_help_msg()
 	printf("\n\n\n");
 	printf("[help] ================================================================\n");
 	printf("   -f [Log Path   ] : Log File Path (default:stdout)\n");
+	printf("   -c [Catalog    ] : Queue Catalog File Path (default:TAT_QUEUE_DEF)\n");
+	printf("                      PKG_NAME NODE_TYPE WRITE_PROC READ_PROC ELEM_CNT BI_DIR_YN [MULTI_TYPE [HIGH_WM LOW_WM]]\n");
 	printf("  ex)  ./LQ_INIT -f ./test.log\n");
 	printf("=======================================================================\n");
 	printf("\n\n\n");
@@ -199,8 +539,9 @@ int main(int argc, char *args[])
 
 	int param_opt = 0;
 	char *pszLog = NULL;
+	char *pszCatalog = NULL;
 
-	while( -1 != (param_opt = getopt(argc, args, "hf:")))
+	while( -1 != (param_opt = getopt(argc, args, "hf:c:")))
 	{
 		switch(param_opt)
 		{
@@ -211,12 +552,16 @@ int main(int argc, char *args[])
 				pszLog = optarg;
 				printf("Log File Path : %s\n", pszLog);
 				break;
+			case 'c' :
+				pszCatalog = optarg;
+				printf("Catalog File Path : %s\n", pszCatalog);
+				break;
 			default :
 				break;
 		}
 	}
 
-	m_pclsCMRT = new CLQInit(pszLog);
+	m_pclsCMRT = new CLQInit(pszLog, pszCatalog);
 
 	//Failed
 	if(m_pclsCMRT == NULL)
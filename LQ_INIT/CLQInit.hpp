@@ -10,6 +10,8 @@
 #include <stdint.h>
 
 #include "CConfig.hpp"
+#include "CLQCatalog.h"
+#include "CLQMempool.h"
 
 //! Define Memory Buffer 128 byte
 #define DEF_MEM_BUF_128		128
@@ -22,24 +24,19 @@
  */
 #define DEF_RING_SIZE	0x40000  
 
-//! Define Memory Pool Name
+//! Define Default Command Memory Buffer Elements Count
 /*!
- * Memory Pool Name For to Use in Application
- */
-#define DEF_BASE_MEMORY_POOL_NAME	"BASE_MEMORY_POOL"  
-
-//! Define Command Memory Pool Name
-/*!
- * Memory Pool Name For to Use in Application
+ * Command 는 초당 몇 건이므로 작게 생성한다 (QUEUE 의 CMD_MBUF_COUNT, 16진수)
+ * Power of 2 - 1
  */
-#define DEF_CMD_MEMORY_POOL_NAME	"COMMAND_MEMORY_POOL"  
+#define DEF_CMD_MBUF_COUNT	( 1 << 10 ) - 1
 
-//! Define Memory Buffer Elements Count
+//! Define Default Data Size of Command Memory Buffer
 /*!
- * To Use in Memory Pool Create Function
- * Power of 2 - 1
+ * QUEUE 의 CMD_MBUF_SIZE 로 변경, Topology Command(TOPOLOGY_CMD) 가 한개의 Memory Buffer 에 들어가야 한다
+ * 더 큰 Command 는 여러개의 Memory Buffer 로 나누어 전송한다
  */
-#define DEF_MBUF_COUNT	( 1 << 18 ) - 1  
+#define DEF_CMD_MBUF_DATA_SIZE	512
 
 /*!
  * \class CLQInit
@@ -49,7 +46,7 @@ class CLQInit
 {
 	public:
 		//! Constructor.
-		CLQInit(char *a_strLogPath = NULL);
+		CLQInit(char *a_strLogPath = NULL, char *a_strCatalogFile = NULL);
 		//! Destructor.
 		~CLQInit();
 
@@ -65,6 +62,17 @@ class CLQInit
 		struct rte_mempool *m_pstDataMemPool;
 		//! Memory Pool For Command
 		struct rte_mempool *m_pstCmdMemPool;
+		//! Catalog File Path (NULL : TAT_QUEUE_DEF 를 조회)
+		char *m_pCatalogFile;
+
+		//! Create Size Class Memory Pools
+		int InitMbufClass(CConfig *a_pclsConfig);
+		//! Init Queue Topology Catalog Memory Zone
+		int InitCatalog(CConfig *a_pclsConfig);
+		//! Load Queue Definition From Catalog File
+		int LoadCatalogFile(QUEUE_CATALOG *a_pstCatalog);
+		//! Load Queue Definition From TAT_QUEUE_DEF
+		int LoadCatalogDB(QUEUE_CATALOG *a_pstCatalog, CConfig *a_pclsConfig);
 
 		
 };
@@ -0,0 +1,312 @@
+/*!
+ * \file main.cpp
+ * \brief Test Application For CLQHandle (Multi-Thread Reader / Writer)
+ * \details
+ * 한 Process 에서 여러 Thread 가 각자의 CLQHandle 로 같은 Write Ring 에 입력하거나 같은 Read Ring 을 읽는다.
+ * Handle 은 사용하는 Thread 안에서 생성하고 삭제한다.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "CLQManager.hpp"
+#include "CLQHandle.hpp"
+
+//! Max Count of Test Thread
+#define DEF_MAX_TEST_THREAD 32
+
+//! Test Thread Arguments
+typedef struct _thread_arg
+{
+	CLQManager	*pclsLQ;		//!< Initialized CLQManager of this Process
+	int			nThreadIdx;		//!< Index of Thread
+	int			nWriteIdx;		//!< Index of Write Queue
+	uint32_t	unSendCount;	//!< Send Count of each Thread (0 : Loop)
+	uint32_t	unDataSize;		//!< Size of each Data
+	int			nBurstCount;	//!< Burst Count of Read
+	bool		bIov;			//!< Read as Segment List (GetNext iovec)
+}THREAD_ARG;
+
+volatile uint32_t g_unWriteCnt = 0;
+volatile uint32_t g_unReadCnt = 0;
+volatile uint32_t g_unFailCnt = 0;
+volatile uint32_t g_unIovRetryCnt = 0;
+volatile bool g_bStop = false;
+
+void print_help_msg()
+{
+	printf("\n\n\n");
+	printf("[help] ================================================================\n");
+	printf("   -p [ProcessName] : Input Process Name\n");
+	printf("   -t [count      ] : Count of Thread (Max %d, default 4)\n", DEF_MAX_TEST_THREAD);
+	printf("   -c [count      ] : Send Count of each Writer Thread ( set to 0 is Loop )\n");
+	printf("   -s [size(byte) ] : Input Size of each data (default 128)\n");
+	printf("   -r [count      ] : Reader Mode, Burst Count of ReadBurstData\n");
+	printf("   -v               : Reader reads Segment List, starting with 1 Segment (Retry Test)\n");
+	printf("   -w [Index      ] : Number of Index of Write Queue \n");
+	printf("   -i [Instance Id] : Instance ID of Process \n");
+	printf("   -f [Log Path   ] : Log File Path\n");
+	printf("  ex)  ./TEST_APP_HANDLE -p FLC01 -t 8 -c 100000 -s 512 -i 1\n");
+	printf("       ./TEST_APP_HANDLE -p FLC02 -t 4 -r 32 -i 1\n");
+	printf("       ./TEST_APP_HANDLE -p FLC02 -t 4 -r 32 -v -i 1   (Writer -s 8192)\n");
+	printf("=======================================================================\n");
+	printf("\n\n\n");
+}
+
+static void *
+stat_thread(void *arg)
+{
+	uint32_t unOldWrite = 0;
+	uint32_t unOldRead = 0;
+
+	while(g_bStop == false)
+	{
+		sleep(1);
+		printf("Write Count, %u, Read Count, %u, Fail Count, %u\n"
+				, g_unWriteCnt - unOldWrite, g_unReadCnt - unOldRead, g_unFailCnt);
+		unOldWrite = g_unWriteCnt;
+		unOldRead = g_unReadCnt;
+	}
+
+	return arg;
+}
+
+//Writer Thread
+//Function Call Flow : CLQHandle::WriteDataWait()
+static void *
+write_thread(void *arg)
+{
+	int ret = 0;
+	uint32_t unSeq = 0;
+	THREAD_ARG *pstArg = (THREAD_ARG*)arg;
+	char *pszBuff = (char*)malloc(pstArg->unDataSize);
+
+	if(pszBuff == NULL)
+		return NULL;
+
+	memset(pszBuff, '0' + (pstArg->nThreadIdx % 10), pstArg->unDataSize);
+
+	//Handle 은 사용하는 Thread 에서 생성
+	CLQHandle *pclsHandle = new CLQHandle(pstArg->pclsLQ);
+
+	while(pstArg->unSendCount == 0 || unSeq < pstArg->unSendCount)
+	{
+		snprintf(pszBuff, pstArg->unDataSize, "T%02d_%u", pstArg->nThreadIdx, unSeq);
+
+		//Ring Full, Memory Pool 부족이면 Consumer 가 비울 때까지 대기 (1 sec)
+		ret = pclsHandle->WriteDataWait(pszBuff, pstArg->unDataSize, pstArg->nWriteIdx, 1000);
+		if(unlikely(ret < 0))
+		{
+			__sync_fetch_and_add(&g_unFailCnt, 1);
+			if(ret == -E_Q_TIMEDOUT)
+				continue;
+
+			printf("Thread %d Write Failed %d [%s]\n", pstArg->nThreadIdx, ret, pclsHandle->GetErrorMsg());
+			break;
+		}
+
+		unSeq++;
+		__sync_fetch_and_add(&g_unWriteCnt, 1);
+	}
+
+	delete pclsHandle;
+	free(pszBuff);
+
+	return NULL;
+}
+
+//Reader Thread
+//Function Call Flow : CLQHandle::ReadBurstData() -> GetNext() -> ReadComplete() -> FreeReadBulkData()
+//Segment List Mode : 1개의 Segment List 로 GetNext 를 호출하고, -E_Q_NOMEM 이면 필요한 크기로 같은 데이터를 다시 읽는다
+static void *
+read_thread(void *arg)
+{
+	int ret = 0;
+	int nIovCnt = 0;
+	char *pszData = NULL;
+	struct iovec stIov[DEF_MAX_IOV];
+	THREAD_ARG *pstArg = (THREAD_ARG*)arg;
+
+	CLQHandle *pclsHandle = new CLQHandle(pstArg->pclsLQ);
+
+	while(g_bStop == false)
+	{
+		ret = pclsHandle->ReadBurstData(pstArg->nBurstCount);
+		if(ret < 0)
+		{
+			printf("Thread %d Read Failed %d [%s]\n", pstArg->nThreadIdx, ret, pclsHandle->GetErrorMsg());
+			break;
+		}
+
+		if(ret == 0)
+		{
+			usleep(10);
+			continue;
+		}
+
+		if(pstArg->bIov == false)
+		{
+			while(pclsHandle->GetNext(&pszData) > 0)
+				__sync_fetch_and_add(&g_unReadCnt, 1);
+		}
+		else
+		{
+			for(;;)
+			{
+				nIovCnt = 1;
+				ret = pclsHandle->GetNext(stIov, &nIovCnt);
+				if(ret == -E_Q_NOMEM)
+				{
+					//같은 데이터를 필요한 크기의 Segment List 로 다시 읽음
+					if(nIovCnt <= 1 || nIovCnt > DEF_MAX_IOV)
+					{
+						printf("Thread %d Invalid Segment Count %d\n", pstArg->nThreadIdx, nIovCnt);
+						g_bStop = true;
+						break;
+					}
+
+					__sync_fetch_and_add(&g_unIovRetryCnt, 1);
+					ret = pclsHandle->GetNext(stIov, &nIovCnt);
+				}
+
+				if(ret <= 0)
+					break;
+
+				__sync_fetch_and_add(&g_unReadCnt, 1);
+			}
+		}
+
+		pclsHandle->ReadComplete();
+		pclsHandle->FreeReadBulkData();
+	}
+
+	delete pclsHandle;
+
+	return NULL;
+}
+
+int main(int argc, char *args[])
+{
+	int ret = 0;
+	int param_opt = 0;
+	int nThreadCnt = 4;
+	int nWriteIdx = 0;
+	int nInstanceId = 0;
+	int nBurstCount = 0;
+	bool bIov = false;
+	uint32_t unSendCount = 0;
+	uint32_t unDataSize = 128;
+	char *pszProcName = NULL;
+	char *pszLogPath = NULL;
+
+	pthread_t stStatId;
+	pthread_t stThreadId[DEF_MAX_TEST_THREAD];
+	THREAD_ARG stArg[DEF_MAX_TEST_THREAD];
+
+	if(argc < 2)
+	{
+		print_help_msg();
+		return 0;
+	}
+
+	while( -1 != (param_opt = getopt(argc, args, "hp:t:c:s:r:vw:i:f:")))
+	{
+		switch(param_opt)
+		{
+			case 'h' :
+				print_help_msg();
+				return 0;
+			case 'p' :
+				pszProcName = optarg;
+				break;
+			case 't' :
+				nThreadCnt = atoi(optarg);
+				break;
+			case 'c' :
+				unSendCount = atoi(optarg);
+				break;
+			case 's' :
+				unDataSize = atoi(optarg);
+				break;
+			case 'r' :
+				nBurstCount = atoi(optarg);
+				break;
+			case 'v' :
+				bIov = true;
+				break;
+			case 'w' :
+				nWriteIdx = atoi(optarg);
+				break;
+			case 'i' :
+				nInstanceId = atoi(optarg);
+				break;
+			case 'f' :
+				pszLogPath = optarg;
+				break;
+			default :
+				break;
+		}
+	}
+
+	if(pszProcName == NULL || nThreadCnt <= 0 || nThreadCnt > DEF_MAX_TEST_THREAD || unDataSize < 16 || nBurstCount > DEF_MAX_BURST)
+	{
+		print_help_msg();
+		return -1;
+	}
+
+	printf("Process %s, Thread %d, %s Mode\n", pszProcName, nThreadCnt, (nBurstCount > 0) ? "Read" : "Write");
+
+	//Init CLQManager
+	//Arguments : NODE ID, Process Name, Process Instance ID, Backup Flag, MSync Flag, Log Path(생략 가능)
+	CLQManager *pclsLQ = new CLQManager((char*)"OFCS", (char*)"AP", pszProcName, nInstanceId, false, false, pszLogPath);
+	if(pclsLQ->Initialize(DEF_CMD_TYPE_RECV) < 0)
+	{
+		printf("CLQManager Init Failed ErrMsg : %s\n", pclsLQ->GetErrorMsg());
+		return -1;
+	}
+
+	ret = pthread_create(&stStatId, NULL, &stat_thread, NULL);
+	if(ret != 0)
+	{
+		printf("Thread create failed\n");
+		return -1;
+	}
+
+	for(int i = 0; i < nThreadCnt; i++)
+	{
+		stArg[i].pclsLQ = pclsLQ;
+		stArg[i].nThreadIdx = i;
+		stArg[i].nWriteIdx = nWriteIdx;
+		stArg[i].unSendCount = unSendCount;
+		stArg[i].unDataSize = unDataSize;
+		stArg[i].nBurstCount = nBurstCount;
+		stArg[i].bIov = bIov;
+
+		ret = pthread_create(&stThreadId[i], NULL, (nBurstCount > 0) ? &read_thread : &write_thread, &stArg[i]);
+		if(ret != 0)
+		{
+			printf("Thread create failed\n");
+			return -1;
+		}
+	}
+
+	for(int i = 0; i < nThreadCnt; i++)
+		pthread_join(stThreadId[i], NULL);
+
+	g_bStop = true;
+	pthread_join(stStatId, NULL);
+
+	printf("Total Write Count %u, Read Count %u, Fail Count %u, Segment List Retry Count %u\n"
+			, g_unWriteCnt, g_unReadCnt, g_unFailCnt, g_unIovRetryCnt);
+
+	//모든 Handle 이 삭제된 뒤에 CLQManager 삭제
+	delete pclsLQ;
+
+	return 0;
+}
@@ -80,10 +80,11 @@ void print_help_msg()
 	printf("   -p [ProcessName] : Input Process Name\n");
 //	printf("   -c [count      ] : Input Send Count\n");
 //	printf("   -s [size(byte) ] : Input Size of each data\n");
-	printf("   -b [count      ] : Input Bulk Count (bulk mode on)\n");
+	printf("   -b [count      ] : Input Max Bulk Count (bulk mode on)\n");
 	printf("   -k [sync/async ] : Select Sync mode(sync/async) (backup mode on)\n");
 	printf("   -f [Log Path   ] : Log File Path\n");
 	printf("   -i [Instance Id] : Instance ID of Process \n");
+	printf("   -w [signal/futex/hybrid] : Select Wait mode (default : signal)\n");
 	printf("  ex)  ./TEST_APP -p FLC01 -c 1000 -s 512 -b 5 -k sync\n");
 	printf("=======================================================================\n");
 	printf("\n\n\n");
@@ -117,15 +118,17 @@ thread_start(void *arg)
 int process_bulk_data (CLQManager *a_pclsCLQ, int a_nBulkCount)
 {
 	int ret = 0;
+	int nReadCnt = 0;
 	TEST *test;
 	while(1)
 	{
-		//Read Bulk Data
-		ret = a_pclsCLQ->ReadBulkData(a_nBulkCount);
-		if(ret < 0)
+		//Read Bulk Data (최대 a_nBulkCount 개)
+		ret = a_pclsCLQ->ReadBurstData(a_nBulkCount);
+		if(ret <= 0)
 		{
-			return -1;
+			return ret;
 		}
+		nReadCnt = ret;
 
 		while( (ret = a_pclsCLQ->GetNext((char**)&test)) > 0)
 		{
@@ -139,7 +142,7 @@ int process_bulk_data (CLQManager *a_pclsCLQ, int a_nBulkCount)
 		//데이터를 수신하는 마지막 Process 에서 필히 Free 함수를 호출
 		//Free Bulk Msg in Read Buffer
 		a_pclsCLQ->FreeReadBulkData();
-		free_cnt += a_nBulkCount;
+		free_cnt += nReadCnt;
 
 	}
 
@@ -230,6 +233,7 @@ int main(int argc, char *args[])
 	int nBulkCount = 0;
 	bool bBackup = false;
 	bool bSync = false;
+	int nWaitMode = DEF_WAIT_MODE_SIGNAL;
 
 	if(argc < 2)
 	{
@@ -237,7 +241,7 @@ int main(int argc, char *args[])
 		return 0;
 	}
 											
-	while( -1 != (param_opt = getopt(argc, args, "hp:b:k:i:f:")))
+	while( -1 != (param_opt = getopt(argc, args, "hp:b:k:i:f:w:")))
 	{
 		switch(param_opt)
 		{
@@ -280,6 +284,18 @@ int main(int argc, char *args[])
 				nInstanceId = atoi(optarg);
 				printf("Instance ID %d\n", nInstanceId);
 				break;
+			case 'w' :
+				if(strncmp (optarg, "futex", strlen("futex")) == 0)
+				{
+					nWaitMode = DEF_WAIT_MODE_FUTEX;
+				}
+				else if(strncmp (optarg, "hybrid", strlen("hybrid")) == 0)
+				{
+					nWaitMode = DEF_WAIT_MODE_HYBRID;
+				}
+
+				printf("Wait Mode[%s] On\n", optarg);
+				break;
 															
 			default :
 				break;
@@ -290,7 +306,7 @@ int main(int argc, char *args[])
 	//Init CLQManager
 	//Arguments : NODE ID, Process Name, Process Instance ID, Backup Flag, MSync Flag, Log Path(생략 가능)
 	CLQManager	*m_pclsCLQ = new CLQManager("OFCS", "AP", pszProcName, nInstanceId, bBackup,  bSync , pszLogPath);
-	if(m_pclsCLQ->Initialize(DEF_CMD_TYPE_RECV) < 0)
+	if(m_pclsCLQ->Initialize(DEF_CMD_TYPE_RECV, NULL, nWaitMode) < 0)
 	{
 		printf("CLQManager Init Failed ErrMsg[%s]\n", m_pclsCLQ->GetErrorMsg());
 		return -1;
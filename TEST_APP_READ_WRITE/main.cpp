@@ -144,6 +144,13 @@ int process_bulk_data (CLQManager *a_pclsCLQ, int a_nBulkCount)
 
 		//Commit Data
 		ret = a_pclsCLQ->CommitData();
+		//Queue 에는 입력되었고 Backup 만 실패 (재시도하지 않음)
+		if(ret == -E_Q_BACKUP)
+		{
+			printf("Backup Failed ErrMsg[%s]\n", a_pclsCLQ->GetErrorMsg());
+			ret = 0;
+		}
+
 		if(ret < 0)
 		{
 			if(ret == -E_Q_NOSPC)
@@ -192,7 +199,10 @@ int process_data (CLQManager *a_pclsCLQ)
 		//Write one Data (bypass)
 		//WriteData(char *data, int size) <-- Write new Data
 		ret = a_pclsCLQ->WriteData();
-		if(ret < 0)
+		//Queue 에는 입력되었고 Backup 만 실패 (재시도하지 않음)
+		if(ret == -E_Q_BACKUP)
+			printf("Backup Failed ErrMsg[%s]\n", a_pclsCLQ->GetErrorMsg());
+		else if(ret < 0)
 		{
 			if(ret == -E_Q_NOSPC)
 				continue;
@@ -196,12 +196,19 @@ int process_bulk_data(CLQManager *a_pclsCLQ, int a_nBulkCount, int a_nWriteIdx,
 		}
 
 		//Commit Data in Insert Buffer
-		if(a_pclsCLQ->CommitData(a_nWriteIdx) < 0)
+		ret = a_pclsCLQ->CommitData(a_nWriteIdx);
+		if(ret < 0)
 		{
-			if(ret == -E_Q_NOSPC)
+			//Queue 에는 입력되었고 Backup 만 실패 (재시도하지 않음)
+			if(ret == -E_Q_BACKUP)
+				printf("Backup Failed [%s]\n", a_pclsCLQ->GetErrorMsg());
+			else if(ret == -E_Q_NOSPC)
 				continue;
-			printf("Commit Data Failed\n");
-			return -1;
+			else
+			{
+				printf("Commit Data Failed\n");
+				return -1;
+			}
 		}
 
 		if( (a_unSendCount != 0)  && (cnt == a_unSendCount) )
@@ -236,11 +243,16 @@ int process_data (CLQManager *a_pclsCLQ, int a_nIdx, uint32_t a_unSendCount, uin
 		ret = a_pclsCLQ->WriteData( (char*)g_szBuffer, nLen, a_nIdx);
 		if(unlikely(ret != 0))
 		{
-			if(ret == -E_Q_NOSPC)
+			//Queue 에는 입력되었고 Backup 만 실패 (재시도하지 않음)
+			if(ret == -E_Q_BACKUP)
+				printf("Backup Failed [%s]\n", a_pclsCLQ->GetErrorMsg());
+			else if(ret == -E_Q_NOSPC)
 				continue;
-
-			printf("fail\n");
-			return -1;
+			else
+			{
+				printf("fail\n");
+				return -1;
+			}
 		}
 
 		cnt++;
@@ -58,6 +58,8 @@
 
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sys/time.h>
 
 #include "CLQManager.hpp"
 #include "CConfig.hpp"
@@ -85,6 +87,7 @@ void print_help_msg()
 	printf("   -d [Queue Name ] : Delete Queue mode\n");
 	printf("   -n [Queue Name ] : Name of Delete or Init Queue \n");
 	printf("   -v [Queue Name ] : Queue Dump \n");
+	printf("   -r [Queue Name ] : Restore Queue from Backup File (Queue1,Queue2,... : Parallel)\n");
 	printf("   -p [File Name  ] : Backup File Dump \n");
 	printf("   -x [Start Index] : Start Index of Backup File Dump \n");
 	printf("   -y [End Index  ] : End Index of Backup File Dump \n");
@@ -102,6 +105,84 @@ char *time2str(time_t *ptime)
     return g_szTimeStr;
 }
 
+BACKUP_RECORD *get_record(BACKUP_INFO *a_pstBackup, uint32_t a_unSeq)
+{
+	uint64_t unOff = BACKUP_INDEX(a_pstBackup)[a_unSeq & a_pstBackup->unMask];
+	BACKUP_RECORD *pstRecord = (BACKUP_RECORD*)(BACKUP_LOG(a_pstBackup) + (unOff & (a_pstBackup->unLogSize - 1)));
+
+	//Index 가 가리키는 Record 가 다른 데이터로 덮어써진 경우
+	if(pstRecord->unSeq != a_unSeq)
+		return NULL;
+
+	return pstRecord;
+}
+
+int check_backup_file(BACKUP_INFO *a_pstBackup, off_t a_nSize)
+{
+	if(a_pstBackup->unMagic != DEF_BK_MAGIC)
+	{
+		printf("Invalid Backup File Magic %x\n", a_pstBackup->unMagic);
+		return -1;
+	}
+
+	if((uint64_t)a_nSize != BACKUP_FILE_SIZE(a_pstBackup->unMask, a_pstBackup->unLogSize))
+	{
+		printf("Invalid Backup File Size %lu\n", (uint64_t)a_nSize);
+		return -1;
+	}
+
+	return 0;
+}
+
+int load_checkpoint(char *a_pszQName, uint32_t *a_punConsMax)
+{
+	char szFileName[1024];
+	int fd = 0;
+	CKPT_INFO *pstCkpt = NULL;
+
+	memset(szFileName, 0x00, sizeof(szFileName));
+	sprintf(szFileName, "%s/%s.ckpt", g_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_pszQName);
+
+	fd = open(szFileName, O_RDONLY);
+	if(fd == -1)
+	{
+		printf("Checkpoint File (%s) Open Error %d\n", szFileName, errno);
+		return -1;
+	}
+
+	pstCkpt = (CKPT_INFO*)mmap(NULL, sizeof(CKPT_INFO), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(pstCkpt == MAP_FAILED)
+	{
+		printf("MMap function failed %d\n", errno);
+		return -1;
+	}
+
+	if(pstCkpt->unMagic != DEF_CKPT_MAGIC)
+	{
+		printf("Invalid Checkpoint File Magic %x\n", pstCkpt->unMagic);
+		munmap(pstCkpt, sizeof(CKPT_INFO));
+		return -1;
+	}
+
+	printf("cons Count %u\n", pstCkpt->unConsCnt);
+
+	*a_punConsMax = 0;
+	for(int i = 0; i < pstCkpt->unConsCnt; i++)
+	{
+		if(*a_punConsMax < pstCkpt->stCursor[i].unTail)
+			*a_punConsMax = pstCkpt->stCursor[i].unTail;
+
+		printf("Cons Name %s, Tail %u, Ack %lu, Synced Ack %lu\n"
+					, pstCkpt->stCursor[i].strName, pstCkpt->stCursor[i].unTail
+					, pstCkpt->stCursor[i].unAckCnt, pstCkpt->stCursor[i].unSyncCnt);
+	}
+
+	munmap(pstCkpt, sizeof(CKPT_INFO));
+
+	return 0;
+}
+
 int dump_file(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, uint32_t a_unEndIdx)
 {
 	char szFileName[1024];
@@ -114,11 +195,10 @@ int dump_file(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, ui
 
 	void *pMMap = NULL;
 	BACKUP_INFO *pstBackup = NULL;
-	DATA_BUFFER *pstData = NULL;
+	BACKUP_RECORD *pstRecord = NULL;
 
 	uint32_t	unConsMax = 0;
 	uint32_t	unProdMax = 0;
-	uint32_t	unFileIdx = 0;
 
 	uint32_t	unStartIdx = a_unStartIdx;
 	uint32_t	unEndIdx = a_unEndIdx;
@@ -151,17 +231,16 @@ int dump_file(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, ui
 
 	pstBackup = (BACKUP_INFO*)pMMap;
 
-	printf("cons Count %u\n", pstBackup->unConsCnt);
+	if(check_backup_file(pstBackup, bk_file_stat.st_size) < 0)
+		return -1;
+
 	printf("prod Count %u\n", pstBackup->unProdCnt);
 	printf("mask       %x\n", pstBackup->unMask);
+	printf("log size   %lu\n", pstBackup->unLogSize);
+	printf("log tail   %lu\n", pstBackup->unLogTail);
 
-	for(int i = 0; i < pstBackup->unConsCnt; i++)
-	{
-		if(unConsMax < pstBackup->stConsInfo[i].unTail)
-			unConsMax = pstBackup->stConsInfo[i].unTail;
-
-		printf("Cons Name %s, Tail %u\n", pstBackup->stConsInfo[i].strName, pstBackup->stConsInfo[i].unTail);
-	}
+	if(load_checkpoint(a_pszQName, &unConsMax) < 0)
+		return -1;
 
 	for(int i = 0; i < pstBackup->unProdCnt; i++)
 	{
@@ -174,7 +253,6 @@ int dump_file(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, ui
 
 	printf("cons max %u\n", unConsMax);
 	printf("prod max %u\n", unProdMax);
-	pstData = (DATA_BUFFER*)(pstBackup + 1);	
 
 	if(a_unStartIdx == 0)
 		unStartIdx = unConsMax;
@@ -195,9 +273,16 @@ int dump_file(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, ui
 
 	for(uint32_t i = unStartIdx ; i < unEndIdx ; i++)
 	{
-		unFileIdx = i & pstBackup->unMask;	
-		printf("idx : [%5u], data_len : [%5u], Data : %s\n"
-					, unFileIdx, pstData[unFileIdx].unBuffLen, pstData[unFileIdx].szBuff);
+		pstRecord = get_record(pstBackup, i);
+		if(pstRecord == NULL)
+		{
+			printf("seq : [%8u], Record is Overwritten\n", i);
+			continue;
+		}
+
+		printf("seq : [%8u], data_len : [%5u], seg_cnt : [%2u], Data : %.*s\n"
+					, pstRecord->unSeq, pstRecord->unLen, pstRecord->unSegCnt
+					, (int)pstRecord->unLen, (char*)(pstRecord + 1));
 	}
 
 
@@ -275,6 +360,10 @@ void dump_ring(CLQManager *a_pclsCLQ, char *a_pszQName, uint32_t a_unStartIdx, u
 void queue_monitoring(CLQManager *a_pclsCLQ)
 {
 	float fUsage = 0;
+	uint64_t unRtsSent = 0;
+	uint64_t unRtsSuppressed = 0;
+	uint64_t unBackupLag = 0;
+	uint64_t unBackupFail = 0;
 	struct rte_ring *arrRing[RTE_MAX_MEMZONE];
 	memset(arrRing, 0x00 , sizeof(arrRing));
 	
@@ -295,7 +384,22 @@ void queue_monitoring(CLQManager *a_pclsCLQ)
 		else
 		{
 			fUsage = rte_ring_count(arrRing[i]) / (float)arrRing[i]->prod.size * 100;
-			printf("Queue       : %25s  /  Usage %3.2f\n", arrRing[i]->name, fUsage);
+
+			unRtsSent = 0;
+			unRtsSuppressed = 0;
+			unBackupLag = 0;
+			unBackupFail = 0;
+			for(uint32_t j = 0; j < arrRing[i]->prod.prod_count; j++)
+			{
+				unRtsSent += arrRing[i]->prod.prod_info[j].rts_sent;
+				unRtsSuppressed += arrRing[i]->prod.prod_info[j].rts_suppressed;
+				unBackupLag += arrRing[i]->prod.prod_info[j].bk_staged - arrRing[i]->prod.prod_info[j].bk_written
+								- arrRing[i]->prod.prod_info[j].bk_failed;
+				unBackupFail += arrRing[i]->prod.prod_info[j].bk_failed;
+			}
+
+			printf("Queue       : %25s  /  Usage %3.2f  /  RTS Sent %lu  /  RTS Suppressed %lu  /  Backup Lag %lu  /  Backup Fail %lu\n"
+							, arrRing[i]->name, fUsage, unRtsSent, unRtsSuppressed, unBackupLag, unBackupFail);
 		}
 
 	}
@@ -332,67 +436,72 @@ int init_queue(CLQManager *a_pclsCLQ, char *a_pszQName, struct rte_ring **a_pstR
 	return 0;
 }
 
-int restore_backup(CLQManager *a_pclsCLQ, char *a_pszQName)
+//! Restore Job (Queue 하나를 복구하는 Thread 의 정보)
+typedef struct _restore_job
+{
+	char				szQName[DEF_MEM_BUF_64];
+	struct rte_ring		*pstRing;
+	CLQManager			*pclsCLQ;
+	void				*pMMap;
+	off_t				nSize;
+	uint32_t			unStart;
+	uint32_t			unEnd;
+	volatile uint64_t	unDone;
+	volatile uint64_t	unBytes;
+	volatile uint64_t	unSkip;
+	volatile bool		bFinish;
+	int					nRet;
+	pthread_t			stThread;
+}RESTORE_JOB;
+
+int prepare_restore(CLQManager *a_pclsCLQ, RESTORE_JOB *a_pstJob)
 {
-	int ret = 0;
-
-	struct rte_ring *pstRing = NULL;
-
 	char szFileName[1024];
-	memset(szFileName, 0x00, sizeof(szFileName));
-	sprintf(szFileName, "%s/%s.bak", g_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_pszQName);
-
 	int fd = 0;
-	
 	struct stat bk_file_stat;
-
-	void *pMMap = NULL;
 	BACKUP_INFO *pstBackup = NULL;
-	DATA_BUFFER *pstData = NULL;
-
 	uint32_t	unConsMax = 0;
 	uint32_t	unProdMax = 0;
-	uint32_t	unFileIdx = 0;
 
-	fd = open(szFileName, O_RDWR, 0660);
+	memset(szFileName, 0x00, sizeof(szFileName));
+	sprintf(szFileName, "%s/%s.bak", g_pclsConfig->GetConfigValue("QUEUE", "BACKUP_PATH"), a_pstJob->szQName);
+
+	fd = open(szFileName, O_RDONLY);
 	if(fd == -1)
 	{
 		printf("Backup File (%s) Open Error %d\n", szFileName, errno);
 		return -1;
 	}
 
-	if(fstat(fd, &bk_file_stat) < 0)
+	if(fstat(fd, &bk_file_stat) < 0 || bk_file_stat.st_size == 0)
 	{
-		printf("fstat function failed\n");
+		printf("Backup File (%s) Size Error\n", szFileName);
+		close(fd);
 		return -1;
 	}
 
-	if(bk_file_stat.st_size == 0)
-	{
-		printf("File Size Error\n");
-		return -1;
-	}
-
-	pMMap = mmap(NULL, bk_file_stat.st_size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
-	if(pMMap == MAP_FAILED)
+	//Journal 전체를 순서대로 읽으므로 미리 읽어들이도록 설정
+	a_pstJob->pMMap = mmap(NULL, bk_file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(a_pstJob->pMMap == MAP_FAILED)
 	{
 		printf("MMap function failed %d\n", errno);
+		a_pstJob->pMMap = NULL;
 		return -1;
 	}
+	a_pstJob->nSize = bk_file_stat.st_size;
+	madvise(a_pstJob->pMMap, a_pstJob->nSize, MADV_SEQUENTIAL | MADV_WILLNEED);
 
-	pstBackup = (BACKUP_INFO*)pMMap;
+	pstBackup = (BACKUP_INFO*)a_pstJob->pMMap;
 
-	printf("cons Count %u\n", pstBackup->unConsCnt);
-	printf("prod Count %u\n", pstBackup->unProdCnt);
-	printf("mask       %x\n", pstBackup->unMask);
+	if(check_backup_file(pstBackup, bk_file_stat.st_size) < 0)
+		return -1;
 
-	for(int i = 0; i < pstBackup->unConsCnt; i++)
-	{
-		if(unConsMax < pstBackup->stConsInfo[i].unTail)
-			unConsMax = pstBackup->stConsInfo[i].unTail;
+	printf("[%s] prod Count %u, mask %x, log size %lu, log tail %lu\n"
+				, a_pstJob->szQName, pstBackup->unProdCnt, pstBackup->unMask, pstBackup->unLogSize, pstBackup->unLogTail);
 
-		printf("Cons Name %s, Tail %u\n", pstBackup->stConsInfo[i].strName, pstBackup->stConsInfo[i].unTail);
-	}
+	if(load_checkpoint(a_pstJob->szQName, &unConsMax) < 0)
+		return -1;
 
 	for(int i = 0; i < pstBackup->unProdCnt; i++)
 	{
@@ -402,44 +511,209 @@ int restore_backup(CLQManager *a_pclsCLQ, char *a_pszQName)
 		printf("Prod Name %s, Tail %u\n", pstBackup->stProdInfo[i].strName, pstBackup->stProdInfo[i].unTail);
 	}
 
-	if(init_queue(a_pclsCLQ, a_pszQName, &pstRing) < 0)
+	if(init_queue(a_pclsCLQ, a_pstJob->szQName, &a_pstJob->pstRing) < 0)
 	{
 		printf("Queue Init Failed [%s]\n", a_pclsCLQ->GetErrorMsg());
 		return -1;
 	}
 
-	if(pstRing == NULL)
+	if(a_pstJob->pstRing == NULL)
 	{
 		printf("Queue is NULL\n");
 		return -1;
 	}
 
-	printf("cons max %u\n", unConsMax);
-	printf("prod max %u\n", unProdMax);
-	pstData = (DATA_BUFFER*)(pstBackup + 1);	
-	for(uint32_t i = unConsMax ; i < unProdMax ; i++)
+	a_pstJob->pclsCLQ = a_pclsCLQ;
+	a_pstJob->unStart = unConsMax;
+	a_pstJob->unEnd = unProdMax;
+
+	//Consumer 가 모두 처리한 경우
+	if((int32_t)(unProdMax - unConsMax) < 0)
+		a_pstJob->unStart = unProdMax;
+
+	printf("[%s] cons max %u, prod max %u\n", a_pstJob->szQName, unConsMax, unProdMax);
+
+	return 0;
+}
+
+void *restore_thread(void *a_pArg)
+{
+	RESTORE_JOB *pstJob = (RESTORE_JOB*)a_pArg;
+	BACKUP_INFO *pstBackup = (BACKUP_INFO*)pstJob->pMMap;
+	BACKUP_RECORD *pstRecord = NULL;
+	struct iovec stIov[DEF_MAX_BURST];
+	uint64_t unBytes = 0;
+	uint32_t unSeq = pstJob->unStart;
+	uint32_t unSegCnt = 0;
+	uint32_t unRecSeg = 0;
+	int nCnt = 0;
+	int nOff = 0;
+	int nSub = 0;
+	int ret = 0;
+
+	pstJob->nRet = 0;
+
+	//Restore Thread 별 Mempool Cache
+	rte_lcore_slot_attach();
+
+	while(unSeq != pstJob->unEnd && pstJob->nRet == 0)
 	{
-		unFileIdx = i & pstBackup->unMask;	
-	#if 1
-		ret = a_pclsCLQ->WriteData(pstRing, pstData[unFileIdx].szBuff, pstData[unFileIdx].unBuffLen);
-		if(ret < 0)
+		//Record 를 Burst 단위로 모아서 한번에 입력 (WriteBulkData 의 Segment 수 제한 DEF_MEM_BUF_1024 이내)
+		nCnt = 0;
+		unSegCnt = 0;
+		for( ; unSeq != pstJob->unEnd && nCnt < DEF_MAX_BURST ; unSeq++)
 		{
-			printf("1 errno : %d, errmsg : %s\n", ret, a_pclsCLQ->GetErrorMsg());
-			return -1;
+			pstRecord = get_record(pstBackup, unSeq);
+			if(pstRecord == NULL)
+			{
+				printf("[%s] Data [%u] is Overwritten, Skip\n", pstJob->szQName, unSeq);
+				pstJob->unSkip++;
+				continue;
+			}
+
+			unRecSeg = (pstRecord->unLen == 0) ? 1 : (pstRecord->unLen + RTE_MBUF_DATA_SIZE - 1) / RTE_MBUF_DATA_SIZE;
+			if(nCnt > 0 && unSegCnt + unRecSeg > DEF_MEM_BUF_1024)
+				break;
+
+			stIov[nCnt].iov_base = (char*)(pstRecord + 1);
+			stIov[nCnt].iov_len = pstRecord->unLen;
+			unSegCnt += unRecSeg;
+			nCnt++;
 		}
 
-	#endif
-		printf("Data [%u], %s\n", unFileIdx, pstData[unFileIdx].szBuff);
+		//Size Class 의 Segment Size 가 작아서 Segment 수를 넘으면(-E_Q_NOMEM) 나누어 입력
+		for(nOff = 0, nSub = nCnt; nOff < nCnt; )
+		{
+			if(nOff + nSub > nCnt)
+				nSub = nCnt - nOff;
+
+			ret = pstJob->pclsCLQ->WriteBulkData(pstJob->pstRing, &stIov[nOff], nSub);
+			if(ret == -ENOBUFS)
+			{
+				//Ring Full : Consumer 가 비울 때까지 대기
+				usleep(1000);
+				continue;
+			}
+
+			if(ret == -E_Q_NOMEM && nSub > 1)
+			{
+				nSub /= 2;
+				continue;
+			}
+
+			if(ret < 0)
+			{
+				printf("[%s] Restore Failed, errno : %d\n", pstJob->szQName, ret);
+				pstJob->nRet = -1;
+				break;
+			}
+
+			unBytes = 0;
+			for(int i = nOff; i < nOff + nSub; i++)
+				unBytes += stIov[i].iov_len;
+
+			pstJob->unDone += nSub;
+			pstJob->unBytes += unBytes;
+			nOff += nSub;
+		}
 	}
 
+	rte_lcore_slot_detach();
 
-	if(munmap(pMMap, bk_file_stat.st_size) < 0)
+	pstJob->bFinish = true;
+
+	return NULL;
+}
+
+int restore_backup(CLQManager *a_pclsCLQ, char *a_pszQName)
+{
+	int ret = 0;
+	int nJobCnt = 0;
+	int nRunCnt = 0;
+	char szQList[DEF_MEM_BUF_1024];
+	char *pSave = NULL;
+	char *pToken = NULL;
+	RESTORE_JOB *pstJob = NULL;
+	RESTORE_JOB arrJob[DEF_MAX_RING];
+	struct timeval stStart, stNow;
+	double dElapsed = 0;
+	uint64_t unTotDone = 0;
+	uint64_t unTotBytes = 0;
+
+	memset(arrJob, 0x00, sizeof(arrJob));
+
+	//Queue Name 을 ',' 로 구분하여 여러 Queue 를 동시에 복구
+	snprintf(szQList, sizeof(szQList), "%s", a_pszQName);
+	for(pToken = strtok_r(szQList, ",", &pSave); pToken != NULL && nJobCnt < DEF_MAX_RING; pToken = strtok_r(NULL, ",", &pSave))
+	{
+		pstJob = &arrJob[nJobCnt];
+		snprintf(pstJob->szQName, sizeof(pstJob->szQName), "%s", pToken);
+
+		if(prepare_restore(a_pclsCLQ, pstJob) < 0)
+		{
+			ret = -1;
+			break;
+		}
+
+		nJobCnt++;
+	}
+
+	gettimeofday(&stStart, NULL);
+
+	for(int i = 0; ret == 0 && i < nJobCnt; i++)
 	{
-		printf("munmap failed %d\n", errno);
-		return -1;
+		if(pthread_create(&arrJob[i].stThread, NULL, restore_thread, &arrJob[i]) != 0)
+		{
+			printf("[%s] Restore Thread Create Failed\n", arrJob[i].szQName);
+			arrJob[i].stThread = 0;
+			arrJob[i].bFinish = true;
+			arrJob[i].nRet = -1;
+			continue;
+		}
+		nRunCnt++;
 	}
 
-	return 0;	
+	//진행 상황 출력
+	for(bool bRun = (nRunCnt > 0); bRun ; )
+	{
+		usleep(1000000);
+
+		bRun = false;
+		for(int i = 0; i < nJobCnt; i++)
+		{
+			if(arrJob[i].bFinish == false)
+				bRun = true;
+
+			printf("[%s] Restore %lu / %u, Skip %lu\n"
+						, arrJob[i].szQName, arrJob[i].unDone, arrJob[i].unEnd - arrJob[i].unStart, arrJob[i].unSkip);
+		}
+	}
+
+	for(int i = 0; i < nJobCnt; i++)
+	{
+		if(arrJob[i].stThread)
+			pthread_join(arrJob[i].stThread, NULL);
+
+		if(arrJob[i].nRet < 0)
+			ret = -1;
+
+		unTotDone += arrJob[i].unDone;
+		unTotBytes += arrJob[i].unBytes;
+
+		if(arrJob[i].pMMap != NULL)
+			munmap(arrJob[i].pMMap, arrJob[i].nSize);
+	}
+
+	gettimeofday(&stNow, NULL);
+	dElapsed = (stNow.tv_sec - stStart.tv_sec) + (stNow.tv_usec - stStart.tv_usec) / 1000000.0;
+	if(dElapsed <= 0)
+		dElapsed = 0.000001;
+
+	printf("Restore Queue %d, Data %lu, Bytes %lu, Elapsed %.3f sec, %.0f msg/s, %.2f MB/s\n"
+				, nJobCnt, unTotDone, unTotBytes, dElapsed
+				, unTotDone / dElapsed, unTotBytes / dElapsed / DEF_MEM_BUF_1M);
+
+	return ret;
 }
 
 
@@ -496,6 +770,7 @@ int main(int argc, char *args[])
 				bRestore = true;
 				pszQName = optarg;
 				printf("File %s Restore Start\n", pszQName);
+				break;
 			case 'p' :
 				bDumpFile = true;
 				pszQName = optarg;